@@ -16,6 +16,8 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <QCryptographicHash>
+
 #include "global.h"
 #include "addsynth.h"
 
@@ -398,3 +400,32 @@ int Addsynth::load(const char* sdir)
     f.close();
     return 0;
 }
+
+//---------------------------------------------------------
+//   digest
+//    identifies the synthesis parameters, used to key
+//    the cached rank waves
+//---------------------------------------------------------
+
+QByteArray Addsynth::digest() const
+{
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(_filename, int(strnlen(_filename, sizeof(_filename))));
+    const int32_t n[4] = { _n0, _n1, _fn, _fd };
+    h.addData(reinterpret_cast<const char*>(n), sizeof(n));
+    for (const N_func* f : { &_n_vol, &_n_off, &_n_ran, &_n_ins, &_n_att, &_n_atd, &_n_dct, &_n_dcd }) {
+        for (int i = 0; i < N_NOTE; i++) {
+            float v = f->vs(i);
+            h.addData(reinterpret_cast<const char*>(&v), sizeof(v));
+        }
+    }
+    for (const HN_func* f : { &_h_lev, &_h_ran, &_h_att, &_h_atp }) {
+        for (int j = 0; j < N_HARM; j++) {
+            for (int i = 0; i < N_NOTE; i++) {
+                float v = f->vs(j, i);
+                h.addData(reinterpret_cast<const char*>(&v), sizeof(v));
+            }
+        }
+    }
+    return h.result();
+}
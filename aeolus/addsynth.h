@@ -91,6 +91,7 @@ public:
     void reset();
     int save(const char* sdir);
     int load(const char* sdir);
+    QByteArray digest() const;
 
     char _filename[64];
     char _stopname[32];
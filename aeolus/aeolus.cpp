@@ -108,7 +108,7 @@ void Aeolus::init(float samplerate)
     strcpy(stopsPath, qPrintable(stops));
 
     QDir dir;
-    QString waves = dataPath + QString("/aeolus/waves%1").arg(int(samplerate));
+    QString waves = dataPath + QString("/aeolus/cache/v%1").arg(RANKWAVE_CACHE_VERSION);
     dir.mkpath(waves);
     n = strlen(qPrintable(waves));
     char* wavesPath = new char[n + 1];
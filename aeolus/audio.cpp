@@ -18,6 +18,7 @@
 
 #include "messages.h"
 #include "aeolus.h"
+#include "model.h"
 
 //---------------------------------------------------------
 //   start
@@ -147,6 +148,8 @@ void Aeolus::process(unsigned nframes, float* out, float*, float*)
 {
     float gain = 1.0;
 
+    model->proc_pending();
+
     for (int n = 0; n < NNOTES; n++) {
         int m = _keymap[n];
         if (m & 128) {
@@ -44,7 +44,7 @@ Keybd::Keybd()
 }
 
 Ifelm::Ifelm()
-    : _state(0)
+    : _state(0), _pending(false)
 {
     _label[0] = 0;
     _mnemo[0] = 0;
@@ -77,7 +77,8 @@ Model::Model (Aeolus* a,
     _bank(0),
     _pres(0),
     _sc_cmode(0),
-    _sc_group(0)
+    _sc_group(0),
+    _npending(0)
 {
     sprintf(_instr, "%s/%s", stops, instr);
     _waves = waves;
@@ -109,7 +110,6 @@ void Model::init()
 
     init_iface();
     init_ranks(MT_LOAD_RANK);
-    init_ranks(MT_SAVE_RANK);
 }
 
 //---------------------------------------------------------
@@ -159,6 +159,19 @@ void Model::init_iface()
     set_mconf(0, _chconf[0]._bits);
 }
 
+//---------------------------------------------------------
+//   ~Model
+//---------------------------------------------------------
+
+Model::~Model()
+{
+    for (int d = 0; d < _ndivis; d++) {
+        for (int r = 0; r < _divis [d]._nrank; r++) {
+            _divis [d]._ranks [r]._future.waitForFinished();
+        }
+    }
+}
+
 void Model::init_ranks(int comm)
 {
     _count++;
@@ -174,6 +187,30 @@ void Model::init_ranks(int comm)
     _ready = true;
 }
 
+//---------------------------------------------------------
+//   make_rank
+//    Runs in the thread pool: take the waves from the
+//    cache, or generate and cache them.
+//---------------------------------------------------------
+
+static void make_rank(Rankwave* W, const char* path, Addsynth* D, float fsamp, float fbase, float* scale)
+{
+    if (W->load(path, D, fsamp, fbase, scale)) {
+        W->gen_waves(D, fsamp, fbase, scale);
+        W->save(path, D, fsamp, fbase, scale);
+    }
+}
+
+//---------------------------------------------------------
+//   proc_rank
+//    A rank seen for the first time is installed at once
+//    and filled in the background: nothing plays it
+//    before its stop is set, and set_ifelm() holds the
+//    stop back until _loaded is set. Waves replacing a
+//    rank which may be sounding are swapped in only when
+//    complete.
+//---------------------------------------------------------
+
 void Model::proc_rank(int g, int i, int comm)
 {
     Ifelm* I = _group [g]._ifelms + i;
@@ -182,37 +219,50 @@ void Model::proc_rank(int g, int i, int comm)
         int r = (I->_action0 >> 8) & 255;
         Rank* R = _divis [d]._ranks + r;
         if (comm == MT_SAVE_RANK) {
+            R->_future.waitForFinished();
             if (R->_wave->modif()) {
                 R->_wave->save(_waves, R->_sdef, _aeolus->_fsamp,
                                _fbase, scales[_itemp]._data);
             }
         } else if (R->_count != _count) {
             R->_count = _count;
-            M_def_rank M(comm);
-            M._divis = d;
-            M._rank  = r;
-            M._group = g;
-            M._ifelm = i;
-            M._fsamp = _aeolus->_fsamp;
-            M._fbase = _fbase;
-            M._scale = scales [_itemp]._data;
-            M._sdef  = R->_sdef;
-            M._wave  = R->_wave;
-            M._path  = _waves;
-
-//WS                  send_event(TO_IFACE, new M_ifc_ifelm (MT_IFC_ELATT, M._group, M._ifelm));
-
-            M._wave = new Rankwave(M._sdef->_n0, M._sdef->_n1);
-            if (M._wave->load(M._path, M._sdef, M._fsamp, M._fbase, M._scale)) {
-                M._wave->gen_waves(M._sdef, M._fsamp, M._fbase, M._scale);
-            }
 
-            _aeolus->_divisp [M._divis]->set_rank(M._rank, M._wave,  M._sdef->_pan, M._sdef->_del);
-            _divis [M._divis]._ranks [M._rank]._wave = M._wave;
+//WS                  send_event(TO_IFACE, new M_ifc_ifelm (MT_IFC_ELATT, g, i));
+
+            Rankwave* W     = new Rankwave(R->_sdef->_n0, R->_sdef->_n1);
+            const char* path = _waves;
+            Addsynth* D     = R->_sdef;
+            float fsamp     = _aeolus->_fsamp;
+            float fbase     = _fbase;
+            float* scale    = scales [_itemp]._data;
+
+            R->_future.waitForFinished();
+            if (R->_wave) {
+                make_rank(W, path, D, fsamp, fbase, scale);
+            } else {
+                R->_future = QtConcurrent::run([=]() {
+                    make_rank(W, path, D, fsamp, fbase, scale);
+                    R->_loaded.store(true, std::memory_order_release);
+                });
+            }
+            _aeolus->_divisp [d]->set_rank(r, W, D->_pan, D->_del);
+            R->_wave = W;
         }
     }
 }
 
+//---------------------------------------------------------
+//   rank_loaded
+//    false while the waves of a rank stop are still being
+//    made; stops which are not ranks are always ready
+//---------------------------------------------------------
+
+bool Model::rank_loaded(int g, int i)
+{
+    Rank* R = find_rank(g, i);
+    return !R || R->_loaded.load(std::memory_order_acquire);
+}
+
 //---------------------------------------------------------
 //   set_ifelm
 //    Set, reset or toggle a stop.
@@ -233,7 +283,18 @@ void Model::set_ifelm(int g, int i, int m)
     int s = (m == 2) ? I->_state ^ 1 : m;
     if (I->_state != s) {
         I->_state = s;
-        _aeolus->proc_queue(s ? I->_action1 : I->_action0);
+        if (I->_pending) {
+            I->_pending = false;
+            --_npending;
+        }
+        if (s && !rank_loaded(g, i)) {
+            // runs in the audio thread: do not wait for the
+            // waves, proc_pending() sets the stop once loaded
+            I->_pending = true;
+            ++_npending;
+        } else {
+            _aeolus->proc_queue(s ? I->_action1 : I->_action0);
+        }
         M_ifc_ifelm* e = new M_ifc_ifelm(MT_IFC_ELCLR + s, g, i);
         if (m == 0) {
             _aeolus->_ifelms [e->_group] &= ~(1 << e->_ifelm);
@@ -255,6 +316,10 @@ void Model::clr_group(int g)
 
     for (int i = 0; i < G->_nifelm; i++) {
         Ifelm* I = G->_ifelms + i;
+        if (I->_pending) {
+            I->_pending = false;
+            --_npending;
+        }
         if (I->_state) {
             I->_state = 0;
             _aeolus->proc_queue(I->_action0);
@@ -263,6 +328,30 @@ void Model::clr_group(int g)
     _aeolus->_ifelms[g] = 0;
 }
 
+//---------------------------------------------------------
+//   proc_pending
+//    Called from Aeolus::process(): set the stops whose
+//    rank waves have been loaded since set_ifelm().
+//---------------------------------------------------------
+
+void Model::proc_pending()
+{
+    if (_npending == 0) {
+        return;
+    }
+    for (int g = 0; g < _ngroup; g++) {
+        Group* G = _group + g;
+        for (int i = 0; i < G->_nifelm; i++) {
+            Ifelm* I = G->_ifelms + i;
+            if (I->_pending && rank_loaded(g, i)) {
+                I->_pending = false;
+                --_npending;
+                _aeolus->proc_queue(I->_action1);
+            }
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   get_state
 //---------------------------------------------------------
@@ -19,6 +19,10 @@
 #ifndef __MODEL_H
 #define __MODEL_H
 
+#include <atomic>
+
+#include <QFuture>
+
 #include "messages.h"
 #include "addsynth.h"
 #include "rankwave.h"
@@ -42,6 +46,8 @@ public:
     int _count;
     Addsynth* _sdef;
     Rankwave* _wave;
+    QFuture<void> _future;                  // loading or generating _wave, only used by the model thread
+    std::atomic<bool> _loaded { false };    // _wave is complete, read by the audio thread
 };
 
 class Divis
@@ -96,6 +102,7 @@ public:
     int _type;
     int _keybd;
     int _state;
+    bool _pending;          // set, waiting for the rank waves
     uint32_t _action0;
     uint32_t _action1;
 };
@@ -168,6 +175,7 @@ class Model
     int _portid;
     int _sc_cmode;               // stop control command mode
     int _sc_group;               // stop control group number
+    int _npending;               // stops set but not yet sounding, see proc_pending()
     Chconf _chconf[8];
     Preset* _preset[NBANK][NPRES];
 
@@ -175,6 +183,7 @@ class Model
     void init_iface();
     void init_ranks(int comm);
     void proc_rank(int g, int i, int comm);
+    bool rank_loaded(int g, int i);
     void set_mconf(int i, uint16_t* d);
     void get_state(uint32_t* bits);
     void set_state(int bank, int pres);
@@ -195,10 +204,11 @@ class Model
 public:
     Model (Aeolus* aeolus, uint16_t* midimap, const char* stops,const char* instr, const char* waves);
 
-    virtual ~Model() {}
+    virtual ~Model();
 
     void set_ifelm(int g, int i, int m);
     void clr_group(int g);
+    void proc_pending();
     void init();
 };
 
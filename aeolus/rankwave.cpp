@@ -16,6 +16,10 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <vector>
+
+#include <QCryptographicHash>
+
 #include "rankwave.h"
 
 #define DEBUG
@@ -23,19 +27,6 @@
 extern float exp2ap(float);
 
 Rngen Pipewave::_rgen;
-float* Pipewave::_arg = 0;
-float* Pipewave::_att = 0;
-
-void Pipewave::initstatic(float fsamp)
-{
-    if (_arg) {
-        return;
-    }
-    int k = (int)(fsamp);
-    _arg  = new float [k];
-    k     = (int)(0.5f * fsamp);
-    _att  = new float [k];
-}
 
 //---------------------------------------------------------
 //   play
@@ -173,7 +164,14 @@ void Pipewave::play()
     _p_r = r;
 }
 
-void Pipewave::genwave(Addsynth* D, int n, float fsamp, float fpipe)
+//---------------------------------------------------------
+//   genwave
+//    arg and att are scratch buffers of fsamp and
+//    fsamp / 2 samples, so that several pipes can be
+//    generated at the same time
+//---------------------------------------------------------
+
+void Pipewave::genwave(Addsynth* D, int n, float fsamp, float fpipe, Rngen& rgen, float* arg, float* att)
 {
     int h, i, k, nc;
     float f0, f1, f, m, t, v, v0;
@@ -188,7 +186,7 @@ void Pipewave::genwave(Addsynth* D, int n, float fsamp, float fpipe)
     _l0 = (int)(fsamp * m + 0.5);
     _l0 = (_l0 + PERIOD - 1) & ~(PERIOD - 1);
 
-    f1 = (fpipe + D->_n_off.vi(n) + D->_n_ran.vi(n) * (2 * _rgen.urand() - 1)) / fsamp;
+    f1 = (fpipe + D->_n_off.vi(n) + D->_n_ran.vi(n) * (2 * rgen.urand() - 1)) / fsamp;
     f0 = f1 * exp2ap(D->_n_atd.vi(n) / 1200.0f);
 
     for (h = N_HARM - 1; h >= 0; h--) {
@@ -228,13 +226,13 @@ void Pipewave::genwave(Addsynth* D, int n, float fsamp, float fpipe)
     t = 0.0f;
     k = (int)(fsamp * D->_n_att.vi(n) + 0.5);
     for (i = 0; i <= _l0; i++) {
-        _arg [i] = t - floorf(t + 0.5);
+        arg [i] = t - floorf(t + 0.5);
         t += (i < k) ? (((k - i) * f0 + i * f1) / k) : f1;
     }
 
     for (i = 1; i < _l1; i++) {
-        t = _arg [_l0] + (float)i * nc / _l1;
-        _arg [i + _l0] = t - floorf(t + 0.5);
+        t = arg [_l0] + (float)i * nc / _l1;
+        arg [i + _l0] = t - floorf(t + 0.5);
     }
 
     v0 = exp2ap(0.1661 * D->_n_vol.vi(n));
@@ -247,16 +245,16 @@ void Pipewave::genwave(Addsynth* D, int n, float fsamp, float fpipe)
             continue;
         }
 
-        v = v0 * exp2ap(0.1661 * (v + D->_h_ran.vi(h, n) * (2 * _rgen.urand() - 1)));
+        v = v0 * exp2ap(0.1661 * (v + D->_h_ran.vi(h, n) * (2 * rgen.urand() - 1)));
         k = (int)(fsamp * D->_h_att.vi(h, n) + 0.5);
-        attgain(k, D->_h_atp.vi(h, n));
+        attgain(k, D->_h_atp.vi(h, n), att);
 
         for (i = 0; i < _l0 + _l1; i++) {
-            t = _arg [i] * (h + 1);
+            t = arg [i] * (h + 1);
             t -= floorf(t);
             m = v * sinf(2 * M_PI * t);
             if (i < k) {
-                m *= _att [i];
+                m *= att [i];
             }
             _p0 [i] += m;
         }
@@ -305,7 +303,7 @@ void Pipewave::looplen(float f, float fsamp, int lmax, int* aa, int* bb)
     *bb = b;
 }
 
-void Pipewave::attgain(int n, float p)
+void Pipewave::attgain(int n, float p, float* att)
 {
     int i, j, k;
     float d, m, w, x, y, z;
@@ -326,7 +324,7 @@ void Pipewave::attgain(int n, float p)
         while (j < k)
         {
             m = (double)j / n;
-            _att [j++] = (1.0 - m) * z + m;
+            att [j++] = (1.0 - m) * z + m;
             z += d;
         }
     }
@@ -391,17 +389,53 @@ Rankwave::~Rankwave (void)
     delete[] _pipes;
 }
 
+//---------------------------------------------------------
+//   gen_waves
+//    reentrant, different ranks may be generated
+//    in parallel
+//---------------------------------------------------------
+
 void Rankwave::gen_waves(Addsynth* D, float fsamp, float fbase, float* scale)
 {
-    Pipewave::initstatic(fsamp);
+    std::vector<float> arg(int(fsamp));
+    std::vector<float> att(int(0.5f * fsamp));
+
+    // seeded per stop, the result must not depend on which thread
+    // generated which rank first
+    Rngen rgen;
+    rgen.init(qHash(QByteArray(D->_filename)) | 1);
 
     fbase *=  D->_fn / (D->_fd * scale [9]);
     for (int i = _n0; i <= _n1; i++) {
-        _pipes [i - _n0].genwave(D, i - _n0, fsamp, ldexpf(fbase * scale [i % 12], i / 12 - 5));
+        _pipes [i - _n0].genwave(D, i - _n0, fsamp, ldexpf(fbase * scale [i % 12], i / 12 - 5), rgen, arg.data(),
+                                 att.data());
     }
     _modif = true;
 }
 
+//---------------------------------------------------------
+//   cachefile
+//    The file name carries a digest of everything the
+//    waves depend on, so that edited stops or another
+//    tuning never pick up a stale file.
+//---------------------------------------------------------
+
+static QByteArray cachefile(const char* path, Addsynth* D, float fsamp, float fbase, float* scale)
+{
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(D->digest());
+    h.addData(reinterpret_cast<const char*>(&fsamp), sizeof(fsamp));
+    h.addData(reinterpret_cast<const char*>(&fbase), sizeof(fbase));
+    h.addData(reinterpret_cast<const char*>(scale), 12 * sizeof(float));
+
+    QByteArray name(D->_filename);
+    int dot = name.lastIndexOf('.');
+    if (dot >= 0) {
+        name.truncate(dot);
+    }
+    return QByteArray(path) + "/" + name + "-" + h.result().toHex().left(16) + ".ae1";
+}
+
 void Rankwave::set_param(float* out, int del, int pan)
 {
     int n, a, b;
@@ -448,16 +482,9 @@ int Rankwave::save(const char* path, Addsynth* D, float fsamp, float fbase, floa
     FILE* F;
     Pipewave* P;
     int i;
-    char name[1024];
     char data[64];
-    char* p;
-
-    sprintf(name, "%s/%s", path, D->_filename);
-    if ((p = strrchr(name, '.'))) {
-        strcpy(p, ".ae1");
-    } else {
-        strcat(name, ".ae1");
-    }
+    QByteArray file = cachefile(path, D, fsamp, fbase, scale);
+    const char* name = file.constData();
 
     F = fopen(name, "wb");
     if (F == NULL) {
@@ -499,17 +526,10 @@ int Rankwave::load(const char* path, Addsynth* D, float fsamp, float fbase, floa
     FILE* F;
     Pipewave* P;
     int i;
-    char name[1024];
     char data[64];
-    char* p;
     float f;
-
-    sprintf(name, "%s/%s", path, D->_filename);
-    if ((p = strrchr(name, '.'))) {
-        strcpy(p, ".ae1");
-    } else {
-        strcat(name, ".ae1");
-    }
+    QByteArray file = cachefile(path, D, fsamp, fbase, scale);
+    const char* name = file.constData();
 
     F = fopen(name, "rb");
     if (F == NULL) {
@@ -24,6 +24,9 @@
 
 #define PERIOD 64
 
+// bump when the .ae1 layout or the synthesis changes
+#define RANKWAVE_CACHE_VERSION 2
+
 class Pipewave
 {
 private:
@@ -38,13 +41,13 @@ private:
 
     friend class Rankwave;
 
-    void genwave(Addsynth* D, int n, float fsamp, float fpipe);
+    void genwave(Addsynth* D, int n, float fsamp, float fpipe, Rngen& rgen, float* arg, float* att);
     void save(FILE* F);
     void load(FILE* F);
     void play(void);
 
     static void looplen(float f, float fsamp, int lmax, int* aa, int* bb);
-    static void attgain(int n, float p);
+    static void attgain(int n, float p, float* att);
 
     float* _p0;        // attack start
     float* _p1;        // loop start
@@ -69,11 +72,7 @@ private:
     float _g_r;        // release gain
     int16_t _i_r;      // release count
 
-    static void initstatic(float fsamp);
-
     static Rngen _rgen;
-    static float* _arg;
-    static float* _att;
 };
 
 //---------------------------------------------------------
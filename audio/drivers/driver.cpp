@@ -19,6 +19,7 @@
 
 #include "config.h"
 #include "driver.h"
+#include "nullaudio.h"
 
 #include "mscore/preferences.h"
 
@@ -42,12 +43,23 @@ bool alsaIsUsed = false, jackIsUsed = false, portAudioIsUsed = false, pulseAudio
 
 //---------------------------------------------------------
 //   driverFactory
-//    driver can be: jack alsa pulse portaudio
+//    driver can be: jack alsa pulse portaudio null clock
 //---------------------------------------------------------
 
 Driver* driverFactory(Seq* seq, QString driverName)
 {
     Driver* driver = 0;
+
+    // Headless drivers, only on request
+    if (driverName.toLower() == "null" || driverName.toLower() == "clock") {
+        driver = new NullAudio(seq, driverName.toLower() == "clock");
+        if (!driver->init()) {
+            qDebug("init null audio driver failed");
+            delete driver;
+            driver = 0;
+        }
+        return driver;
+    }
 #if 1 // DEBUG: force "no audio"
     bool useJackFlag
         = (preferences.getBool(PREF_IO_JACK_USEJACKAUDIO) || preferences.getBool(PREF_IO_JACK_USEJACKMIDI));
@@ -4,6 +4,8 @@ set (DRIVERS_DIR ${CMAKE_CURRENT_LIST_DIR})
 set (DRIVERS_SRC
     ${DRIVERS_DIR}/driver.h
     ${DRIVERS_DIR}/driver.cpp
+    ${DRIVERS_DIR}/nullaudio.h
+    ${DRIVERS_DIR}/nullaudio.cpp
     )
 
 if ( NOT MINGW AND NOT MSVC )
@@ -0,0 +1,314 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "nullaudio.h"
+
+#include <chrono>
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include "mscore/preferences.h"
+#include "mscore/seq.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   NullAudioStats::add
+//---------------------------------------------------------
+
+void NullAudioStats::add(qint64 ns, qint64 periodNs)
+{
+    ++callbacks;
+    totalNs += ns;
+    maxNs = qMax(maxNs, ns);
+    if (ns > periodNs) {
+        ++deadlineMisses;
+    }
+    qint64 us = ns / 1000;
+    int bucket = 0;
+    while (us > 1 && bucket < HISTOGRAM_BUCKETS - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    ++histogram[bucket];
+}
+
+//---------------------------------------------------------
+//   NullAudioStats::toJson
+//---------------------------------------------------------
+
+QJsonObject NullAudioStats::toJson(int sampleRate, int periodFrames) const
+{
+    QJsonObject o;
+    o["sampleRate"]     = sampleRate;
+    o["periodFrames"]   = periodFrames;
+    o["periodUs"]       = double(periodFrames) * 1e6 / sampleRate;
+    o["callbacks"]      = double(callbacks);
+    o["frames"]         = double(frames);
+    o["deadlineMisses"] = double(deadlineMisses);
+    o["xruns"]          = double(xruns);
+    o["meanUs"]         = callbacks ? double(totalNs) / callbacks / 1000.0 : 0.0;
+    o["maxUs"]          = double(maxNs) / 1000.0;
+    QJsonArray h;
+    for (quint64 n : histogram) {
+        h.append(double(n));
+    }
+    o["histogramLog2Us"] = h;
+    return o;
+}
+
+//---------------------------------------------------------
+//   writeWavHeader
+//    stereo 32 bit float
+//---------------------------------------------------------
+
+static void writeWavHeader(QIODevice* f, int sampleRate, quint64 frames)
+{
+    const quint32 frameSize = 2 * sizeof(float);
+    const quint32 dataSize  = quint32(qMin(frames * frameSize, quint64(0xffffffff - 36)));
+
+    QDataStream s(f);
+    s.setByteOrder(QDataStream::LittleEndian);
+    s.writeRawData("RIFF", 4);
+    s << quint32(36 + dataSize);
+    s.writeRawData("WAVE", 4);
+    s.writeRawData("fmt ", 4);
+    s << quint32(16) << quint16(3) << quint16(2) << quint32(sampleRate) << quint32(sampleRate * frameSize)
+      << quint16(frameSize) << quint16(32);
+    s.writeRawData("data", 4);
+    s << dataSize;
+}
+
+//---------------------------------------------------------
+//   NullAudio
+//---------------------------------------------------------
+
+NullAudio::NullAudio(Seq* s, bool realtime)
+    : Driver(s), _realtime(realtime)
+{
+    _sampleRate   = preferences.getInt(PREF_IO_ALSA_SAMPLERATE);
+    _periodFrames = preferences.getInt(PREF_IO_ALSA_PERIODSIZE);
+    _fragments    = qMax(1, preferences.getInt(PREF_IO_ALSA_FRAGMENTS));
+    _state        = Transport::STOP;
+}
+
+//---------------------------------------------------------
+//   ~NullAudio
+//---------------------------------------------------------
+
+NullAudio::~NullAudio()
+{
+    stop();
+}
+
+//---------------------------------------------------------
+//   init
+//    return false on error
+//---------------------------------------------------------
+
+bool NullAudio::init(bool)
+{
+    if (_sampleRate <= 0 || _periodFrames <= 0) {
+        qDebug("NullAudio: invalid sample rate %d or period size %d", _sampleRate, _periodFrames);
+        return false;
+    }
+    _reportPath = preferences.getString(PREF_IO_NULLAUDIO_REPORTFILE);
+    QString wavPath = preferences.getString(PREF_IO_NULLAUDIO_WAVFILE);
+    if (!wavPath.isEmpty() && !openWav(wavPath)) {
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   start
+//---------------------------------------------------------
+
+bool NullAudio::start(bool)
+{
+    if (_running) {
+        return true;
+    }
+    _stats = NullAudioStats();
+    _running = true;
+    _thread = std::thread(&NullAudio::loop, this);
+    return true;
+}
+
+//---------------------------------------------------------
+//   stop
+//---------------------------------------------------------
+
+bool NullAudio::stop()
+{
+    if (!_running) {
+        return true;
+    }
+    _running = false;
+    _thread.join();
+    closeWav();
+    writeReport();
+    return true;
+}
+
+//---------------------------------------------------------
+//   startTransport
+//---------------------------------------------------------
+
+void NullAudio::startTransport()
+{
+    _state = Transport::PLAY;
+}
+
+//---------------------------------------------------------
+//   stopTransport
+//---------------------------------------------------------
+
+void NullAudio::stopTransport()
+{
+    _state = Transport::STOP;
+}
+
+//---------------------------------------------------------
+//   getState
+//---------------------------------------------------------
+
+Transport NullAudio::getState()
+{
+    return _state;
+}
+
+//---------------------------------------------------------
+//   loop
+//    The device is modelled as _fragments periods of
+//    buffer, prefilled with silence. With the real time
+//    clock we wait until a period is free again, an xrun
+//    happens when a period is not ready by the time the
+//    device needs it. With the simulated clock playback
+//    runs back to back as fast as possible, every period
+//    starts exactly when one got free, so an xrun is a
+//    callback longer than the whole buffer. Without
+//    playback both are paced by the real time clock.
+//---------------------------------------------------------
+
+void NullAudio::loop()
+{
+    using Clock = std::chrono::steady_clock;
+    const std::chrono::nanoseconds period(qint64(_periodFrames) * 1000000000LL / _sampleRate);
+    const std::chrono::nanoseconds buffered = period * _fragments;
+
+    std::vector<float> buffer(_periodFrames * 2);
+    Clock::time_point deadline = Clock::now() + buffered;
+
+    while (_running) {
+        const bool playing = _state == Transport::PLAY;
+        const bool simulated = playing && !_realtime;
+        if (!simulated) {
+            std::this_thread::sleep_until(deadline - buffered);
+        }
+
+        Clock::time_point start = Clock::now();
+        seq->process(_periodFrames, buffer.data());
+        Clock::time_point end = Clock::now();
+
+        const std::chrono::nanoseconds elapsed = end - start;
+        bool xrun;
+        if (simulated) {
+            xrun = elapsed > buffered;
+            deadline = end + buffered;
+        } else {
+            deadline += period;
+            xrun = end > deadline;
+            if (xrun) {
+                // the device restarts with a buffer full of silence
+                deadline = end + buffered;
+            }
+        }
+
+        if (!playing) {
+            continue;
+        }
+        _stats.add(elapsed.count(), period.count());
+        _stats.frames += _periodFrames;
+        if (xrun) {
+            ++_stats.xruns;
+        }
+        if (_wavFile.isOpen()) {
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+            for (float& f : buffer) {
+                quint32 v;
+                memcpy(&v, &f, sizeof(v));
+                v = qToLittleEndian(v);
+                memcpy(&f, &v, sizeof(v));
+            }
+#endif
+            _wavFile.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(float));
+            _wavFrames += _periodFrames;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   openWav
+//---------------------------------------------------------
+
+bool NullAudio::openWav(const QString& path)
+{
+    _wavFile.setFileName(path);
+    if (!_wavFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug("NullAudio: cannot open <%s>: %s", qPrintable(path), qPrintable(_wavFile.errorString()));
+        return false;
+    }
+    _wavFrames = 0;
+    writeWavHeader(&_wavFile, _sampleRate, 0);
+    return true;
+}
+
+//---------------------------------------------------------
+//   closeWav
+//    patch the final sizes into the header
+//---------------------------------------------------------
+
+void NullAudio::closeWav()
+{
+    if (!_wavFile.isOpen()) {
+        return;
+    }
+    _wavFile.seek(0);
+    writeWavHeader(&_wavFile, _sampleRate, _wavFrames);
+    _wavFile.close();
+}
+
+//---------------------------------------------------------
+//   writeReport
+//---------------------------------------------------------
+
+void NullAudio::writeReport()
+{
+    if (_stats.callbacks == 0) {
+        return;
+    }
+    qDebug("NullAudio: %llu callbacks, mean %.1f us, max %.1f us, period %.1f us, %llu deadline misses, %llu xruns",
+           _stats.callbacks, double(_stats.totalNs) / _stats.callbacks / 1000.0, double(_stats.maxNs) / 1000.0,
+           double(_periodFrames) * 1e6 / _sampleRate, _stats.deadlineMisses, _stats.xruns);
+
+    if (_reportPath.isEmpty()) {
+        return;
+    }
+    QJsonObject o = _stats.toJson(_sampleRate, _periodFrames);
+    o["clock"] = QString(_realtime ? "realtime" : "simulated");
+    QFile f(_reportPath);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug("NullAudio: cannot write report <%s>", qPrintable(_reportPath));
+        return;
+    }
+    f.write(QJsonDocument(o).toJson());
+}
+}
@@ -0,0 +1,84 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __NULLAUDIO_H__
+#define __NULLAUDIO_H__
+
+#include <atomic>
+#include <thread>
+
+#include "driver.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   NullAudioStats
+//    timing of the process() callbacks
+//---------------------------------------------------------
+
+struct NullAudioStats {
+    static const int HISTOGRAM_BUCKETS = 24;
+
+    quint64 callbacks      { 0 };
+    quint64 frames         { 0 };
+    quint64 deadlineMisses { 0 };   // callback took longer than one period
+    quint64 xruns          { 0 };   // the simulated device buffer ran empty
+    qint64 totalNs         { 0 };
+    qint64 maxNs           { 0 };
+    quint64 histogram[HISTOGRAM_BUCKETS] = {};   // bucket i: [2^i, 2^(i+1)) microseconds, 0: below 2
+
+    void add(qint64 ns, qint64 periodNs);
+    QJsonObject toJson(int sampleRate, int periodFrames) const;
+};
+
+//---------------------------------------------------------
+//   NullAudio
+//    Audio driver without sound hardware. Runs
+//    Seq::process() either back to back on a simulated
+//    clock ("null") or paced by the real time clock
+//    ("clock"), optionally writes the output to a wav
+//    file and reports callback timing when stopped.
+//---------------------------------------------------------
+
+class NullAudio : public Driver
+{
+    const bool _realtime;
+    int _sampleRate;
+    int _periodFrames;
+    int _fragments;
+    std::atomic<Transport> _state;
+    std::atomic<bool> _running { false };
+    std::thread _thread;
+
+    QFile _wavFile;
+    quint64 _wavFrames { 0 };
+    QString _reportPath;
+    NullAudioStats _stats;
+
+    void loop();
+    bool openWav(const QString& path);
+    void closeWav();
+    void writeReport();
+
+public:
+    NullAudio(Seq*, bool realtime);
+    virtual ~NullAudio();
+    virtual bool init(bool hot = false) override;
+    virtual bool start(bool hotPlug = false) override;
+    virtual bool stop() override;
+    virtual void stopTransport() override;
+    virtual void startTransport() override;
+    virtual Transport getState() override;
+    virtual int sampleRate() const override { return _sampleRate; }
+    virtual int bufferSize() override { return _periodFrames; }
+
+    const NullAudioStats& stats() const { return _stats; }     // only valid while stopped
+};
+} // namespace Ms
+#endif
@@ -13,6 +13,7 @@
 #include <math.h>
 
 #include "compressor.h"
+#include "effects/simd.h"
 
 namespace Ms {
 #define f_round(f) lrintf(f)
@@ -210,10 +211,16 @@ void Compressor::init(float sr)
 
 //---------------------------------------------------------
 //   Compressor::process
+//    Works in blocks of BLOCK frames: the input level and
+//    the gain are applied to two stereo frames per Float4,
+//    only the envelope follower in between runs sample
+//    by sample.
 //---------------------------------------------------------
 
 void Compressor::process(int frames, float* ip, float* op)
 {
+    static const int BLOCK = 128;
+
     const float ga       = _attack < 2.0f ? 0.0f : as[f_round(_attack * 0.001f * (float)(A_TBL - 1))];
     const float gr       = as[f_round(_release * 0.001f * (float)(A_TBL - 1))];
     const float rs       = (_ratio - 1.0f) / _ratio;
@@ -223,46 +230,73 @@ void Compressor::process(int frames, float* ip, float* op)
     const float ef_a     = ga * 0.25f;
     const float ef_ai    = 1.0f - ef_a;
 
-    for (int pos = 0; pos < frames; pos++) {
-        const float la = fabs(ip[pos * 2]);
-        const float ra = fabs(ip[pos * 2 + 1]);
-        const float lev_in = f_max(la, ra);
-
-        sum += lev_in * lev_in;
-        if (amp > env_rms) {
-            env_rms = env_rms * ga + amp * (1.0f - ga);
-        } else {
-            env_rms = env_rms * gr + amp * (1.0f - gr);
+    float level[BLOCK];
+    float gains[BLOCK];
+    float t[4];
+
+    for (int done = 0; done < frames; done += BLOCK) {
+        const int n     = qMin(BLOCK, frames - done);
+        const float* in = ip + done * 2;
+        float* out      = op + done * 2;
+
+        // louder channel of each frame
+        int pos = 0;
+        for (; pos + 1 < n; pos += 2) {
+            Float4 a = Float4::load(in + pos * 2).abs();
+            Float4::max(a, a.swapPairs()).store(t);
+            level[pos]     = t[0];
+            level[pos + 1] = t[2];
         }
-        round_to_zero(&env_rms);
-        if (lev_in > env_peak) {
-            env_peak = env_peak * ga + lev_in * (1.0f - ga);
-        } else {
-            env_peak = env_peak * gr + lev_in * (1.0f - gr);
+        for (; pos < n; pos++) {
+            level[pos] = f_max(fabs(in[pos * 2]), fabs(in[pos * 2 + 1]));
         }
-        round_to_zero(&env_peak);
-        if ((count++ & 3) == 3) {
-            amp = rms.process(sum * 0.25f);
-            sum = 0.0f;
-            if (qIsNaN(env_rms)) {         // This can happen sometimes, but I don't know why
-                env_rms = 0.0f;
+
+        for (pos = 0; pos < n; pos++) {
+            const float lev_in = level[pos];
+
+            sum += lev_in * lev_in;
+            if (amp > env_rms) {
+                env_rms = env_rms * ga + amp * (1.0f - ga);
+            } else {
+                env_rms = env_rms * gr + amp * (1.0f - gr);
             }
-            env = LIN_INTERP(rms_peak, env_rms, env_peak);
-            if (env <= knee_min) {
-                gain_t = 1.0f;
-            } else if (env < knee_max) {
-                const float x = -(_threshold - _knee - lin2db(env)) / _knee;
-                gain_t = db2lin(-_knee * rs * x * x * 0.25f);
+            round_to_zero(&env_rms);
+            if (lev_in > env_peak) {
+                env_peak = env_peak * ga + lev_in * (1.0f - ga);
             } else {
-                gain_t = db2lin((_threshold - lin2db(env)) * rs);
+                env_peak = env_peak * gr + lev_in * (1.0f - gr);
             }
+            round_to_zero(&env_peak);
+            if ((count++ & 3) == 3) {
+                amp = rms.process(sum * 0.25f);
+                sum = 0.0f;
+                if (qIsNaN(env_rms)) {         // This can happen sometimes, but I don't know why
+                    env_rms = 0.0f;
+                }
+                env = LIN_INTERP(rms_peak, env_rms, env_peak);
+                if (env <= knee_min) {
+                    gain_t = 1.0f;
+                } else if (env < knee_max) {
+                    const float x = -(_threshold - _knee - lin2db(env)) / _knee;
+                    gain_t = db2lin(-_knee * rs * x * x * 0.25f);
+                } else {
+                    gain_t = db2lin((_threshold - lin2db(env)) * rs);
+                }
+            }
+            gain       = gain * ef_a + gain_t * ef_ai;
+            gains[pos] = gain * mug;
         }
-        gain          = gain * ef_a + gain_t * ef_ai;
-        op[pos * 2]   = ip[pos * 2] * gain * mug;
-        op[pos * 2 + 1] = ip[pos * 2 + 1] * gain * mug;
-    }
 
-//printf("gain %f\n", gain);
+        // ip and op may be the same buffer
+        for (pos = 0; pos + 1 < n; pos += 2) {
+            Float4 g(gains[pos], gains[pos], gains[pos + 1], gains[pos + 1]);
+            (Float4::load(in + pos * 2) * g).store(out + pos * 2);
+        }
+        for (; pos < n; pos++) {
+            out[pos * 2]     = in[pos * 2] * gains[pos];
+            out[pos * 2 + 1] = in[pos * 2 + 1] * gains[pos];
+        }
+    }
 
 //      amplitude = lin2db(env);
 //      gain_red  = lin2db(gain);
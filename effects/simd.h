@@ -0,0 +1,113 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __EFFECTS_SIMD_H__
+#define __EFFECTS_SIMD_H__
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define MS_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MS_SIMD_NEON
+#include <arm_neon.h>
+#else
+#include <cmath>
+#endif
+
+namespace Ms {
+//---------------------------------------------------------
+//   Float4
+//    Four floats processed together, with SSE, NEON or
+//    plain C++ where neither is available. Loads and
+//    stores need no alignment.
+//---------------------------------------------------------
+
+struct Float4 {
+#if defined(MS_SIMD_SSE)
+    __m128 v;
+
+    Float4() {}
+    Float4(__m128 x)
+        : v(x) {}
+    explicit Float4(float x)
+        : v(_mm_set1_ps(x)) {}
+    Float4(float a, float b, float c, float d)
+        : v(_mm_setr_ps(a, b, c, d)) {}
+
+    static Float4 load(const float* p) { return _mm_loadu_ps(p); }
+    void store(float* p) const { _mm_storeu_ps(p, v); }
+
+    Float4 operator+(Float4 o) const { return _mm_add_ps(v, o.v); }
+    Float4 operator-(Float4 o) const { return _mm_sub_ps(v, o.v); }
+    Float4 operator*(Float4 o) const { return _mm_mul_ps(v, o.v); }
+
+    Float4 abs() const { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+    static Float4 max(Float4 a, Float4 b) { return _mm_max_ps(a.v, b.v); }
+
+    // (1, 0, 3, 2)
+    Float4 swapPairs() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+    // (2, 3, 0, 1)
+    Float4 swapHalves() const { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)); }
+#elif defined(MS_SIMD_NEON)
+    float32x4_t v;
+
+    Float4() {}
+    Float4(float32x4_t x)
+        : v(x) {}
+    explicit Float4(float x)
+        : v(vdupq_n_f32(x)) {}
+    Float4(float a, float b, float c, float d)
+    {
+        const float t[4] = { a, b, c, d };
+        v = vld1q_f32(t);
+    }
+
+    static Float4 load(const float* p) { return vld1q_f32(p); }
+    void store(float* p) const { vst1q_f32(p, v); }
+
+    Float4 operator+(Float4 o) const { return vaddq_f32(v, o.v); }
+    Float4 operator-(Float4 o) const { return vsubq_f32(v, o.v); }
+    Float4 operator*(Float4 o) const { return vmulq_f32(v, o.v); }
+
+    Float4 abs() const { return vabsq_f32(v); }
+    static Float4 max(Float4 a, Float4 b) { return vmaxq_f32(a.v, b.v); }
+
+    Float4 swapPairs() const { return vrev64q_f32(v); }
+    Float4 swapHalves() const { return vextq_f32(v, v, 2); }
+#else
+    float v[4];
+
+    Float4() {}
+    explicit Float4(float x)
+        : v{x, x, x, x} {}
+    Float4(float a, float b, float c, float d)
+        : v{a, b, c, d} {}
+
+    static Float4 load(const float* p) { return Float4(p[0], p[1], p[2], p[3]); }
+    void store(float* p) const { p[0] = v[0]; p[1] = v[1]; p[2] = v[2]; p[3] = v[3]; }
+
+    Float4 operator+(Float4 o) const { return Float4(v[0] + o.v[0], v[1] + o.v[1], v[2] + o.v[2], v[3] + o.v[3]); }
+    Float4 operator-(Float4 o) const { return Float4(v[0] - o.v[0], v[1] - o.v[1], v[2] - o.v[2], v[3] - o.v[3]); }
+    Float4 operator*(Float4 o) const { return Float4(v[0] * o.v[0], v[1] * o.v[1], v[2] * o.v[2], v[3] * o.v[3]); }
+
+    Float4 abs() const { return Float4(std::fabs(v[0]), std::fabs(v[1]), std::fabs(v[2]), std::fabs(v[3])); }
+    static Float4 max(Float4 a, Float4 b)
+    {
+        return Float4(a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1],
+                      a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3]);
+    }
+
+    Float4 swapPairs() const { return Float4(v[1], v[0], v[3], v[2]); }
+    Float4 swapHalves() const { return Float4(v[2], v[3], v[0], v[1]); }
+#endif
+    Float4& operator+=(Float4 o) { return *this = *this + o; }
+};
+}     // namespace Ms
+#endif
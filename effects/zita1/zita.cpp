@@ -18,6 +18,7 @@
 
 #include <math.h>
 #include "zita.h"
+#include "effects/simd.h"
 
 namespace Ms {
 enum {
@@ -287,14 +288,22 @@ void Vdelay::set_delay(int del)
     }
 }
 
-void Filt1::set_params(float del, float tmf, float tlo, float wlo, float thi, float chi)
+Filt8::Filt8()
 {
-    _gmf = powf(0.001f, del / tmf);
-    _glo = powf(0.001f, del / tlo) / _gmf - 1.0f;
-    _wlo = wlo;
-    float g    = powf(0.001f, del / thi) / _gmf;
-    float t    = (1 - g * g) / (2 * g * g * chi);
-    _whi = (sqrtf(1 + 4 * t) - 1) / (2 * t);
+    for (int i = 0; i < 8; i++) {
+        _gmf [i] = _glo [i] = _wlo [i] = _whi [i] = 0.0f;
+        _slo [i] = _shi [i] = 0.0f;
+    }
+}
+
+void Filt8::set_params(int i, float del, float tmf, float tlo, float wlo, float thi, float chi)
+{
+    _gmf [i] = powf(0.001f, del / tmf);
+    _glo [i] = powf(0.001f, del / tlo) / _gmf [i] - 1.0f;
+    _wlo [i] = wlo;
+    float g  = powf(0.001f, del / thi) / _gmf [i];
+    float t  = (1 - g * g) / (2 * g * g * chi);
+    _whi [i] = (sqrtf(1 + 4 * t) - 1) / (2 * t);
 }
 
 float ZitaReverb::_tdiff1[8] = {
@@ -397,7 +406,7 @@ void ZitaReverb::prepare(int nfram)
             chi = 1 - cosf(6.2832f * _fdamp / _fsamp);
         }
         for (int i = 0; i < 8; i++) {
-            _filt1 [i].set_params(_tdelay [i], _rtmid, _rtlow, wlo, 0.5f * _rtmid, chi);
+            _filt.set_params(i, _tdelay [i], _rtmid, _rtlow, wlo, 0.5f * _rtmid, chi);
         }
         _cntB2 = b;
     }
@@ -414,18 +423,50 @@ void ZitaReverb::prepare(int nfram)
     _pareq2.prepare(nfram);
 }
 
+//---------------------------------------------------------
+//   hadamard4
+//    the first two butterfly stages of the feedback
+//    matrix within one vector
+//---------------------------------------------------------
+
+static inline Float4 hadamard4(Float4 x)
+{
+    x = x.swapPairs() + x * Float4(1.0f, -1.0f, 1.0f, -1.0f);
+    return x.swapHalves() + x * Float4(1.0f, 1.0f, -1.0f, -1.0f);
+}
+
 //---------------------------------------------------------
 //   process
+//    The eight delay lines are processed as two Float4,
+//    lines 0-3 and 4-7. Only the delay line accesses
+//    remain scalar as every line has its own length.
 //---------------------------------------------------------
 
 void ZitaReverb::process(int nfram, float* inp, float* out)
 {
-    float t, g, x0, x1, x2, x3, x4, x5, x6, x7;
-    g = sqrtf(0.125f);
+    const Float4 g(sqrtf(0.125f));
+    const Float4 c(0.6f, -0.6f, 0.6f, -0.6f);          // see Diff1::init() in init()
+    const Float4 sign(1.0f, 1.0f, -1.0f, -1.0f);
+    const Float4 denorm(1e-10f);
+
+    Float4 gmf0 = Float4::load(_filt._gmf), gmf1 = Float4::load(_filt._gmf + 4);
+    Float4 glo0 = Float4::load(_filt._glo), glo1 = Float4::load(_filt._glo + 4);
+    Float4 wlo0 = Float4::load(_filt._wlo), wlo1 = Float4::load(_filt._wlo + 4);
+    Float4 whi0 = Float4::load(_filt._whi), whi1 = Float4::load(_filt._whi + 4);
+    Float4 slo0 = Float4::load(_filt._slo), slo1 = Float4::load(_filt._slo + 4);
+    Float4 shi0 = Float4::load(_filt._shi), shi1 = Float4::load(_filt._shi + 4);
+
+    float x[8];
+    float z[8];
 
     while (nfram) {
         if (!_nsamp) {
+            // may change the filter coefficients, the state stays in registers
             prepare(_fragm);
+            gmf0 = Float4::load(_filt._gmf), gmf1 = Float4::load(_filt._gmf + 4);
+            glo0 = Float4::load(_filt._glo), glo1 = Float4::load(_filt._glo + 4);
+            wlo0 = Float4::load(_filt._wlo), wlo1 = Float4::load(_filt._wlo + 4);
+            whi0 = Float4::load(_filt._whi), whi1 = Float4::load(_filt._whi + 4);
             _nsamp = _fragm;
         }
 
@@ -439,68 +480,46 @@ void ZitaReverb::process(int nfram, float* inp, float* out)
         for (int i = 0; i < k * 2; i += 2) {
             _vdelay0.write(p0 [i]);
             _vdelay1.write(p1 [i]);
+            const Float4 t0(0.3f * _vdelay0.read());
+            const Float4 t1(0.3f * _vdelay1.read());
 
-            t = 0.3f * _vdelay0.read();
-            x0 = _diff1 [0].process(_delay [0].read() + t);
-            x1 = _diff1 [1].process(_delay [1].read() + t);
-            x2 = _diff1 [2].process(_delay [2].read() - t);
-            x3 = _diff1 [3].process(_delay [3].read() - t);
-            t = 0.3f * _vdelay1.read();
-            x4 = _diff1 [4].process(_delay [4].read() + t);
-            x5 = _diff1 [5].process(_delay [5].read() + t);
-            x6 = _diff1 [6].process(_delay [6].read() - t);
-            x7 = _diff1 [7].process(_delay [7].read() - t);
-
-            t = x0 - x1;
-            x0 += x1;
-            x1 = t;
-            t = x2 - x3;
-            x2 += x3;
-            x3 = t;
-            t = x4 - x5;
-            x4 += x5;
-            x5 = t;
-            t = x6 - x7;
-            x6 += x7;
-            x7 = t;
-            t = x0 - x2;
-            x0 += x2;
-            x2 = t;
-            t = x1 - x3;
-            x1 += x3;
-            x3 = t;
-            t = x4 - x6;
-            x4 += x6;
-            x6 = t;
-            t = x5 - x7;
-            x5 += x7;
-            x7 = t;
-            t = x0 - x4;
-            x0 += x4;
-            x4 = t;
-            t = x1 - x5;
-            x1 += x5;
-            x5 = t;
-            t = x2 - x6;
-            x2 += x6;
-            x6 = t;
-            t = x3 - x7;
-            x3 += x7;
-            x7 = t;
+            for (int j = 0; j < 8; j++) {
+                x [j] = _delay [j].read();
+                z [j] = _diff1 [j].read();
+            }
+            Float4 z0 = Float4::load(z);
+            Float4 z1 = Float4::load(z + 4);
+            Float4 a  = Float4::load(x) + t0 * sign - c * z0;
+            Float4 b  = Float4::load(x + 4) + t1 * sign - c * z1;
+            a.store(x);
+            b.store(x + 4);
+            for (int j = 0; j < 8; j++) {
+                _diff1 [j].write(x [j]);
+            }
+            a = hadamard4(z0 + c * a);
+            b = hadamard4(z1 + c * b);
+            Float4 s = a + b;
+            b = a - b;
+            a = s;
 
+            a.store(x);
             _g1 += _d1;
-
-            q0 [i] = _g1 * (x1 + x2);
-            q1 [i] = _g1 * (x1 - x2);
-
-            _delay [0].write(_filt1 [0].process(g * x0));
-            _delay [1].write(_filt1 [1].process(g * x1));
-            _delay [2].write(_filt1 [2].process(g * x2));
-            _delay [3].write(_filt1 [3].process(g * x3));
-            _delay [4].write(_filt1 [4].process(g * x4));
-            _delay [5].write(_filt1 [5].process(g * x5));
-            _delay [6].write(_filt1 [6].process(g * x6));
-            _delay [7].write(_filt1 [7].process(g * x7));
+            q0 [i] = _g1 * (x [1] + x [2]);
+            q1 [i] = _g1 * (x [1] - x [2]);
+
+            a = a * g;
+            b = b * g;
+            slo0 = slo0 + (wlo0 * (a - slo0) + denorm);
+            slo1 = slo1 + (wlo1 * (b - slo1) + denorm);
+            a = a + glo0 * slo0;
+            b = b + glo1 * slo1;
+            shi0 = shi0 + whi0 * (a - shi0);
+            shi1 = shi1 + whi1 * (b - shi1);
+            (gmf0 * shi0).store(x);
+            (gmf1 * shi1).store(x + 4);
+            for (int j = 0; j < 8; j++) {
+                _delay [j].write(x [j]);
+            }
         }
         _pareq1.process(k, out);
         _pareq2.process(k, out);
@@ -513,6 +532,10 @@ void ZitaReverb::process(int nfram, float* inp, float* out)
         nfram  -= k;
         _nsamp -= k;
     }
+    slo0.store(_filt._slo);
+    slo1.store(_filt._slo + 4);
+    shi0.store(_filt._shi);
+    shi1.store(_filt._shi + 4);
 }
 
 void ZitaReverb::setNValue(int idx, double value)
@@ -86,6 +86,8 @@ public:
 
 //---------------------------------------------------------
 //   Diff1
+//    allpass diffuser, the arithmetic is done by
+//    ZitaReverb for all eight of them at once
 //---------------------------------------------------------
 
 class Diff1
@@ -102,46 +104,37 @@ class Diff1
     void  init(int size, float c);
     void  fini();
 
-    float process(float x)
+    float read() const { return _line [_i]; }
+
+    void write(float x)
     {
-        float z = _line [_i];
-        x -= _c * z;
         _line [_i] = x;
         if (++_i == _size) {
             _i = 0;
         }
-        return z + _c * x;
     }
 };
 
 //---------------------------------------------------------
-//   Filt1
+//   Filt8
+//    the eight feedback filters, one per lane, laid out
+//    to be processed as two Float4
 //---------------------------------------------------------
 
-class Filt1
+class Filt8
 {
     friend class ZitaReverb;
 
-    Filt1 ()
-        : _slo(0), _shi(0) {}
-    ~Filt1 () {}
-
-    void  set_params(float del, float tmf, float tlo, float wlo, float thi, float chi);
+    Filt8();
 
-    float process(float x)
-    {
-        _slo += _wlo * (x - _slo) + 1e-10f;
-        x += _glo * _slo;
-        _shi += _whi * (x - _shi);
-        return _gmf * _shi;
-    }
+    void  set_params(int i, float del, float tmf, float tlo, float wlo, float thi, float chi);
 
-    float _gmf;
-    float _glo;
-    float _wlo;
-    float _whi;
-    float _slo;
-    float _shi;
+    float _gmf[8];
+    float _glo[8];
+    float _wlo[8];
+    float _whi[8];
+    float _slo[8];
+    float _shi[8];
 };
 
 //---------------------------------------------------------
@@ -224,7 +217,7 @@ class ZitaReverb : public Effect
     Vdelay _vdelay0;
     Vdelay _vdelay1;
     Diff1 _diff1[8];
-    Filt1 _filt1[8];
+    Filt8 _filt;
     Delay _delay[8];
 
     volatile int _cntA1;
@@ -0,0 +1,219 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+//
+//    build step: compile the SMuFL metadata of the bundled score fonts
+//    into static tables for libmscore (see libmscore/smuflmetadata.h)
+//
+//    usage: gensmufl output.cpp glyphnames.json fontPath=metadata.json ...
+//
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+
+#include <algorithm>
+#include <stdio.h>
+
+//---------------------------------------------------------
+//   readJson
+//---------------------------------------------------------
+
+static bool readJson(const QString& path, QJsonObject* o)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly)) {
+        fprintf(stderr, "gensmufl: cannot open <%s>\n", qPrintable(path));
+        return false;
+    }
+    QJsonParseError error;
+    *o = QJsonDocument::fromJson(f.readAll(), &error).object();
+    if (error.error != QJsonParseError::NoError) {
+        fprintf(stderr, "gensmufl: json parse error in <%s>(offset: %d): %s\n", qPrintable(path),
+                error.offset, qPrintable(error.errorString()));
+        return false;
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   str
+//    C string literal
+//---------------------------------------------------------
+
+static QString str(const QString& s)
+{
+    QString r = s;
+    r.replace("\\", "\\\\").replace("\"", "\\\"");
+    return QString("\"%1\"").arg(r);
+}
+
+//---------------------------------------------------------
+//   num
+//    double literal, round trips exactly
+//---------------------------------------------------------
+
+static QString num(double v)
+{
+    return QString::number(v, 'g', 17);
+}
+
+//---------------------------------------------------------
+//   codepoint
+//    "U+E0A4" -> 0xe0a4, 0 if invalid
+//---------------------------------------------------------
+
+static uint codepoint(const QJsonValue& v)
+{
+    bool ok;
+    uint code = v.toString().mid(2).toUInt(&ok, 16);
+    return ok ? code : 0;
+}
+
+//---------------------------------------------------------
+//   main
+//---------------------------------------------------------
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: gensmufl output.cpp glyphnames.json fontPath=metadata.json ...\n");
+        return 1;
+    }
+    QJsonObject glyphNames;
+    if (!readJson(argv[2], &glyphNames)) {
+        return 1;
+    }
+
+    QString out;
+    QTextStream os(&out);
+    os << "// generated by fonttools/gensmufl, do not edit\n\n"
+       << "#include \"libmscore/smuflmetadata.h\"\n\n"
+       << "namespace Ms {\n";
+
+    // glyph names, sorted by name in strcmp() order (names are ASCII)
+    QList<QByteArray> names;
+    for (const QString& name : glyphNames.keys()) {
+        names.append(name.toLatin1());
+    }
+    std::sort(names.begin(), names.end());
+    int n = 0;
+    os << "const SmuflGlyphName smuflGlyphNames[] = {\n";
+    for (const QByteArray& name : names) {
+        uint code = codepoint(glyphNames.value(QString::fromLatin1(name)).toObject().value("codepoint"));
+        if (code) {
+            os << "    { " << str(QString::fromLatin1(name)) << ", 0x" << QString::number(code, 16) << " },\n";
+            ++n;
+        }
+    }
+    os << "};\n"
+       << "const int smuflGlyphNameCount = " << n << ";\n\n";
+
+    // per font metadata
+    QStringList fonts;
+    for (int i = 3; i < argc; ++i) {
+        QString arg  = QString::fromLocal8Bit(argv[i]);
+        int eq       = arg.indexOf('=');
+        if (eq == -1) {
+            fprintf(stderr, "gensmufl: bad argument <%s>\n", argv[i]);
+            return 1;
+        }
+        QString fontPath = arg.left(eq);
+        QJsonObject metadata;
+        if (!readJson(arg.mid(eq + 1), &metadata)) {
+            return 1;
+        }
+        QString prefix = QString("font%1").arg(i - 3);
+        QString font   = QString("    { %1").arg(str(fontPath));
+
+        // glyphsWithAnchors, keys in sorted order as seen by QJsonObject::keys()
+        int anchors = 0;
+        QJsonObject oo = metadata.value("glyphsWithAnchors").toObject();
+        os << "static const SmuflAnchor " << prefix << "Anchors[] = {\n";
+        for (const QString& glyph : oo.keys()) {
+            QJsonObject ooo = oo.value(glyph).toObject();
+            for (const QString& anchor : ooo.keys()) {
+                QJsonArray a = ooo.value(anchor).toArray();
+                os << "    { " << str(glyph) << ", " << str(anchor) << ", "
+                   << num(a.at(0).toDouble()) << ", " << num(a.at(1).toDouble()) << " },\n";
+                ++anchors;
+            }
+        }
+        if (!anchors) {
+            os << "    { 0, 0, 0.0, 0.0 }\n";
+        }
+        os << "};\n";
+        font += QString(", %1Anchors, %2").arg(prefix).arg(anchors);
+
+        // engravingDefaults
+        int defaults = 0;
+        oo = metadata.value("engravingDefaults").toObject();
+        os << "static const SmuflEngravingDefault " << prefix << "EngravingDefaults[] = {\n";
+        for (const QString& key : oo.keys()) {
+            os << "    { " << str(key) << ", " << num(oo.value(key).toDouble()) << " },\n";
+            ++defaults;
+        }
+        if (!defaults) {
+            os << "    { 0, 0.0 }\n";
+        }
+        os << "};\n";
+        font += QString(", %1EngravingDefaults, %2").arg(prefix).arg(defaults);
+
+        // glyphsWithAlternates, alternates in file order
+        int alternates = 0;
+        oo = metadata.value("glyphsWithAlternates").toObject();
+        os << "static const SmuflAlternate " << prefix << "Alternates[] = {\n";
+        for (const QString& glyph : oo.keys()) {
+            for (const QJsonValue& v : oo.value(glyph).toObject().value("alternates").toArray()) {
+                QJsonObject jo = v.toObject();
+                uint code = codepoint(jo.value("codepoint"));
+                if (code) {
+                    os << "    { " << str(glyph) << ", " << str(jo.value("name").toString())
+                       << ", 0x" << QString::number(code, 16) << " },\n";
+                    ++alternates;
+                }
+            }
+        }
+        if (!alternates) {
+            os << "    { 0, 0, 0 }\n";
+        }
+        os << "};\n\n";
+        font += QString(", %1Alternates, %2 },\n").arg(prefix).arg(alternates);
+        fonts.append(font);
+    }
+
+    os << "const SmuflFontMetadata smuflFonts[] = {\n";
+    for (const QString& font : fonts) {
+        os << font;
+    }
+    if (fonts.isEmpty()) {
+        os << "    { 0, 0, 0, 0, 0, 0, 0 }\n";
+    }
+    os << "};\n"
+       << "const int smuflFontCount = " << fonts.size() << ";\n"
+       << "}\n";
+    os.flush();
+
+    QByteArray data = out.toUtf8();
+    QFile f(argv[1]);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate) || f.write(data) != data.size()) {
+        fprintf(stderr, "gensmufl: cannot write <%s>\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -90,6 +90,7 @@ MidiSource::~MidiSource()
 void MidiSource::setSampleRate(float samplerate)
 {
     m_sl->mBaseSamplerate = samplerate;
+    m_seq->setSampleRate(static_cast<unsigned int>(samplerate));
 }
 
 SoLoud::AudioSource* MidiSource::source()
@@ -21,6 +21,8 @@
 
 #include <limits>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
 #include <thread>
 
 #include "log.h"
@@ -55,6 +57,8 @@ void Sequencer::loadMIDI(const std::shared_ptr<MidiStream>& stream)
     }
 
     buildTempoMap();
+    m_curTick = secToTick(m_curSec);
+
     setupChannels();
 }
 
@@ -109,56 +113,51 @@ void Sequencer::onChunkReceived(const Chunk& chunk)
     m_streamState.requested = false;
 }
 
-void Sequencer::process(float sec, Context* ctx)
+unsigned int Sequencer::process(float* buf, unsigned int samples, Context* ctx)
 {
     if (m_status != Running) {
-        return;
-    }
-
-    msec_t msec = static_cast<msec_t>(sec * 1000);
-    msec_t delta = msec - m_prevMSec;
-
-    if (delta < 1) {
-        return;
+        return 0;
     }
 
-    msec_t curMSec = m_curMSec + (delta * m_playSpeed);
-    tick_t curTick = ticks(curMSec);
-    tick_t prevTicks = ticks(m_prevMSec);
-    tick_t maxValidTick = validChunkTick(curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
+    double fromSec = m_curSec;
+    double toSec = fromSec + static_cast<double>(samples) * m_playSpeed / m_sampleRate;
+    tick_t fromTick = m_curTick;
+    tick_t toTick = secToTick(toSec);
+    tick_t maxValidTick = validChunkTick(fromTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
 
     if (m_midiStream->isStreamingAllowed) {
-        tick_t bufSize = maxValidTick - curTick;
+        tick_t bufSize = maxValidTick - fromTick;
         if (bufSize < REQUEST_BUFFER_SIZE) {
             requestData(maxValidTick);
         }
     }
 
-    tick_t toTick = curTick;
-    if (toTick > maxValidTick) {
-        toTick = maxValidTick;
+    tick_t sendToTick = toTick;
+    if (sendToTick > maxValidTick) {
+        sendToTick = maxValidTick;
         if (ctx) {
-            ctx->playTick = prevTicks;
-            ctx->fromTick = prevTicks;
-            ctx->toTick = toTick;
+            ctx->playTick = fromTick;
+            ctx->fromTick = fromTick;
+            ctx->toTick = sendToTick;
         }
 
         if (m_streamState.requested) {
-            return;
+            return 0;
         }
     }
 
-    m_curMSec = curMSec;
+    unsigned int rendered = sendEvents(fromTick, sendToTick, fromSec, buf, samples);
 
-    sendEvents(prevTicks, toTick);
+    m_curSec = toSec;
+    m_curTick = toTick;
 
     if (ctx) {
         ctx->playTick = m_playTick;
-        ctx->fromTick = prevTicks;
-        ctx->toTick = toTick;
+        ctx->fromTick = fromTick;
+        ctx->toTick = sendToTick;
     }
 
-    m_prevMSec = m_curMSec;
+    return rendered;
 }
 
 std::shared_ptr<ISynthesizer> Sequencer::determineSynthesizer(channel_t ch, const std::map<channel_t, std::string>& synthmap) const
@@ -193,7 +192,10 @@ std::shared_ptr<ISynthesizer> Sequencer::synth(channel_t ch) const
     return nullptr;
 }
 
-bool Sequencer::sendEvents(tick_t fromTick, tick_t toTick)
+//! NOTE Renders the synthesizers up to each event, so that the event
+//! sounds at its own sample offset in buf and not at the start of it.
+//! Returns the number of frames rendered.
+unsigned int Sequencer::sendEvents(tick_t fromTick, tick_t toTick, double fromSec, float* buf, unsigned int samples)
 {
     static const std::set<EventType> SKIP_EVENTS = { EventType::ME_TICK1, EventType::ME_TICK2, EventType::ME_EOT };
 
@@ -202,9 +204,11 @@ bool Sequencer::sendEvents(tick_t fromTick, tick_t toTick)
     m_isPlayTickSet = false;
 
     if (m_midiData.chunks.empty()) {
-        return false;
+        return 0;
     }
 
+    unsigned int rendered = 0;
+
     auto chunkIt = m_midiData.chunks.upper_bound(fromTick);
     --chunkIt;
 
@@ -242,6 +246,14 @@ bool Sequencer::sendEvents(tick_t fromTick, tick_t toTick)
         if (chState.muted || SKIP_EVENTS.find(event.type) != SKIP_EVENTS.end()) {
             // noop
         } else {
+            double offsetSec = (tickToSec(pos->first) - fromSec) / m_playSpeed;
+            long offset = std::lround(offsetSec * m_sampleRate);
+            offset = std::max(0L, std::min(offset, static_cast<long>(samples)));
+            if (static_cast<unsigned int>(offset) > rendered) {
+                renderSynths(buf, samples, rendered, offset - rendered);
+                rendered = offset;
+            }
+
             auto s = synth(event.channel);
             s->handleEvent(event);
             s->setIsActive(true);
@@ -250,38 +262,57 @@ bool Sequencer::sendEvents(tick_t fromTick, tick_t toTick)
         ++pos;
     }
 
-    return true;
+    return rendered;
 }
 
-float Sequencer::getAudio(float sec, float* buf, unsigned int samples, Context* ctx)
+void Sequencer::renderSynths(float* buf, unsigned int samples, unsigned int offset, unsigned int frames)
 {
-    process(sec, ctx);
+    if (frames == 0) {
+        return;
+    }
 
-    unsigned int totalSamples = samples * AUDIO_CHANNELS;
+    unsigned int totalSamples = frames * AUDIO_CHANNELS;
 
-    // write buffers
     for (SynthState& state : m_synthStates) {
-        if (state.synth->isActive()) {
-            if (state.buf.size() < totalSamples) {
-                state.buf.resize(totalSamples);
-            }
-            std::memset(&state.buf[0], 0, totalSamples * sizeof(float));
-            state.synth->writeBuf(&state.buf[0], samples);
+        if (!state.synth->isActive()) {
+            continue;
         }
-    }
 
-    // mix
-    std::memset(buf, 0, totalSamples * sizeof(float));
-    for (SynthState& state : m_synthStates) {
-        if (state.synth->isActive()) {
-            for (unsigned int s = 0; s < totalSamples; ++s) {
-                buf[s] += state.buf[s];
+        if (state.buf.size() < totalSamples) {
+            state.buf.resize(totalSamples);
+        }
+        std::memset(&state.buf[0], 0, totalSamples * sizeof(float));
+        state.synth->writeBuf(&state.buf[0], frames);
+
+        //! NOTE The buffers are planar, one channel after another
+        for (unsigned int c = 0; c < AUDIO_CHANNELS; ++c) {
+            float* dst = buf + c * samples + offset;
+            const float* src = &state.buf[c * frames];
+            for (unsigned int s = 0; s < frames; ++s) {
+                dst[s] += src[s];
             }
         }
     }
+}
 
-    float cur_sec = static_cast<float>(m_curMSec) / 1000.f;
-    return cur_sec;
+void Sequencer::setSampleRate(unsigned int sampleRate)
+{
+    IF_ASSERT_FAILED(sampleRate > 0) {
+        return;
+    }
+
+    m_sampleRate = sampleRate;
+}
+
+float Sequencer::getAudio(float /*sec*/, float* buf, unsigned int samples, Context* ctx)
+{
+    //! NOTE The position is counted in samples, the stream time is not precise enough
+    std::memset(buf, 0, samples * AUDIO_CHANNELS * sizeof(float));
+
+    unsigned int rendered = process(buf, samples, ctx);
+    renderSynths(buf, samples, rendered, samples - rendered);
+
+    return static_cast<float>(m_curSec);
 }
 
 bool Sequencer::hasEnded() const
@@ -290,8 +321,7 @@ bool Sequencer::hasEnded() const
         return false;
     }
 
-    tick_t prev = ticks(m_prevMSec);
-    if (prev >= m_midiStream->lastTick) {
+    if (m_curTick >= m_midiStream->lastTick) {
         return true;
     }
 
@@ -313,8 +343,8 @@ bool Sequencer::run(float init_sec)
         return false;
     }
 
-    m_prevMSec = static_cast<uint64_t>(init_sec * 1000);
-    m_curMSec = m_prevMSec;
+    m_curSec = init_sec;
+    m_curTick = secToTick(m_curSec);
 
     m_status = Running;
 
@@ -334,8 +364,8 @@ void Sequencer::stop()
 
 void Sequencer::reset()
 {
-    m_curMSec = 0;
-    m_prevMSec = 0;
+    m_curSec = 0.0;
+    m_curTick = 0;
 }
 
 void Sequencer::seek(float sec)
@@ -344,15 +374,12 @@ void Sequencer::seek(float sec)
         sec = 0;
     }
 
-    msec_t seekMsec = static_cast<msec_t>(sec * 1000.f);
-
-    m_curMSec = seekMsec;
-    m_prevMSec = seekMsec;
+    m_curSec = sec;
+    m_curTick = secToTick(m_curSec);
 
     if (m_midiStream->isStreamingAllowed) {
-        tick_t curTick = ticks(m_curMSec);
-        tick_t maxValidTick = validChunkTick(curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
-        tick_t bufSize = maxValidTick - curTick;
+        tick_t maxValidTick = validChunkTick(m_curTick, m_midiData.chunks, REQUEST_BUFFER_SIZE);
+        tick_t bufSize = maxValidTick - m_curTick;
         if (bufSize < REQUEST_BUFFER_SIZE) {
             requestData(maxValidTick);
         }
@@ -402,43 +429,61 @@ void Sequencer::buildTempoMap()
         tempos.push_back({ it.first, it.second });
     }
 
-    if (tempos.empty()) {
-        //! NOTE If temp is not set, then set the default temp to 120
-        tempos.push_back({ 0, 500000 });
+    if (tempos.empty() || tempos.front().first > 0) {
+        //! NOTE If temp is not set from the start, then set the default temp to 120
+        tempos.insert(tempos.begin(), { 0, 500000 });
     }
 
-    uint64_t msec{ 0 };
+    double sec = 0.0;
     for (size_t i = 0; i < tempos.size(); ++i) {
         TempoItem t;
 
         t.tempo = tempos.at(i).second;
         t.startTicks = tempos.at(i).first;
-        t.startMsec = msec;
-        t.onetickMsec = static_cast<double>(t.tempo) / static_cast<double>(m_midiData.division) / 1000.;
+        t.startSec = sec;
+        t.onetickSec = static_cast<double>(t.tempo) / static_cast<double>(m_midiData.division) / 1000000.;
 
-        uint32_t end_ticks = ((i + 1) < tempos.size()) ? tempos.at(i + 1).first : std::numeric_limits<uint32_t>::max();
+        if ((i + 1) < tempos.size()) {
+            sec += (tempos.at(i + 1).first - t.startTicks) * t.onetickSec;
+        }
 
-        uint32_t delta_ticks = end_ticks - t.startTicks;
-        msec += static_cast<uint64_t>(delta_ticks * t.onetickMsec);
+        m_tempoMap.push_back(std::move(t));
+    }
+}
 
-        m_tempoMap.insert({ msec, std::move(t) });
+double Sequencer::tickToSec(tick_t tick) const
+{
+    if (m_tempoMap.empty()) {
+        return 0.0;
+    }
 
-        //        LOGI() << "TempoItem t.tick: " << t.start_ticks
-        //               << ", t.tempo: " << t.tempo
-        //               << ", t.onetick_msec: " << t.onetick_msec
-        //               << ", end_msec: " << msec;
+    auto it = std::upper_bound(m_tempoMap.begin(), m_tempoMap.end(), tick, [](tick_t val, const TempoItem& t) {
+        return val < t.startTicks;
+    });
+    if (it != m_tempoMap.begin()) {
+        --it;
     }
+
+    return it->startSec + (tick - it->startTicks) * it->onetickSec;
 }
 
-tick_t Sequencer::ticks(uint64_t msec) const
+tick_t Sequencer::secToTick(double sec) const
 {
-    auto it = m_tempoMap.lower_bound(msec);
+    if (m_tempoMap.empty()) {
+        return 0;
+    }
 
-    const TempoItem& t = it->second;
+    auto it = std::upper_bound(m_tempoMap.begin(), m_tempoMap.end(), sec, [](double val, const TempoItem& t) {
+        return val < t.startSec;
+    });
+    if (it != m_tempoMap.begin()) {
+        --it;
+    }
 
-    uint64_t delta = msec - t.startMsec;
-    tick_t ticks = static_cast<tick_t>(delta / t.onetickMsec);
-    return t.startTicks + ticks;
+    //! NOTE The epsilon keeps a tick that falls exactly on sec from being rounded past it
+    double ticks = (sec - it->startSec) / it->onetickSec;
+    tick_t tick = it->startTicks + static_cast<tick_t>(std::ceil(ticks - 1e-6));
+    return std::max(tick, 0);
 }
 
 float Sequencer::playbackSpeed() const
@@ -58,6 +58,7 @@ public:
     void seek(float sec) override;
     void stop() override;
 
+    void setSampleRate(unsigned int sampleRate) override;
     float getAudio(float sec, float* buf, unsigned int samples, Context* ctx = nullptr) override;
     bool hasEnded() const override;
 
@@ -70,11 +71,12 @@ public:
 
 private:
 
-    void process(float sec, Context* ctx);
+    unsigned int process(float* buf, unsigned int samples, Context* ctx);
 
     void reset();
     tick_t validChunkTick(tick_t fromTick, const Chunks& chunks, tick_t maxDistanceTick) const;
-    bool sendEvents(tick_t fromTick, tick_t toTick);
+    unsigned int sendEvents(tick_t fromTick, tick_t toTick, double fromSec, float* buf, unsigned int samples);
+    void renderSynths(float* buf, unsigned int samples, unsigned int offset, unsigned int frames);
 
     std::shared_ptr<ISynthesizer> determineSynthesizer(channel_t ch, const std::map<channel_t, std::string>& synthmap) const;
     std::shared_ptr<ISynthesizer> synth(channel_t ch) const;
@@ -82,8 +84,8 @@ private:
     void buildTempoMap();
     void setupChannels();
 
-    void setCurrentMSec(uint64_t msec);
-    tick_t ticks(uint64_t msec) const;
+    double tickToSec(tick_t tick) const;
+    tick_t secToTick(double sec) const;     //! NOTE First tick at or after sec
 
     bool hasTrack(track_t num) const;
 
@@ -97,20 +99,22 @@ private:
     std::shared_ptr<MidiStream> m_midiStream;
 
     float m_playSpeed = 1.0;
+    unsigned int m_sampleRate = 44100;
 
-    msec_t m_prevMSec = 0;
-    msec_t m_curMSec = 0;
+    double m_curSec = 0.0;
+    tick_t m_curTick = 0;   //! NOTE Events before it are sent
 
     bool m_isPlayTickSet = false;
     tick_t m_playTick = 0;    //! NOTE First event tick
 
+    //! NOTE Piecewise linear tick to time mapping, one item per tempo change
     struct TempoItem {
         tempo_t tempo = 500000;
         tick_t startTicks = 0;
-        uint64_t startMsec = 0;
-        double onetickMsec = 0.0;
+        double startSec = 0.0;
+        double onetickSec = 0.0;
     };
-    std::map<uint64_t /*msec*/, TempoItem> m_tempoMap;
+    std::vector<TempoItem> m_tempoMap;
 
     struct StreamState {
         std::atomic<bool> requested{ false };
@@ -48,6 +48,7 @@ public:
         tick_t playTick = 0;
     };
 
+    virtual void setSampleRate(unsigned int sampleRate) = 0;
     virtual float getAudio(float sec, float* buf, unsigned int samples, Context* ctx = nullptr) = 0;
     virtual bool hasEnded() const = 0;
 
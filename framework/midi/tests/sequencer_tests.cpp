@@ -0,0 +1,204 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+
+#include "midi/internal/sequencer.h"
+#include "midi/isynthesizersregister.h"
+
+using namespace mu;
+using namespace mu::midi;
+
+namespace {
+static const unsigned int SAMPLE_RATE = 48000;
+static const int DIVISION = 480;
+static const int BARS = 8;
+static const tick_t BAR_TICKS = DIVISION * 4;
+
+//! NOTE Counts the frames it is asked to render and remembers
+//! at which frame every note on arrived
+class FrameCountingSynth : public ISynthesizer
+{
+public:
+    uint64_t frames = 0;
+    std::vector<uint64_t> noteOnFrames;
+
+    std::string name() const override { return "FrameCounting"; }
+    SoundFontFormats soundFontFormats() const override { return {}; }
+
+    Ret init(float) override { return make_ret(Ret::Code::Ok); }
+    Ret addSoundFonts(std::vector<io::path>) override { return make_ret(Ret::Code::Ok); }
+    Ret removeSoundFonts() override { return make_ret(Ret::Code::Ok); }
+
+    //! NOTE Always active, so that every frame is counted
+    bool isActive() const override { return true; }
+    void setIsActive(bool) override {}
+
+    Ret setupChannels(const std::vector<Event>&) override { return make_ret(Ret::Code::Ok); }
+    bool handleEvent(const Event& e) override
+    {
+        if (e.type == EventType::ME_NOTEON && e.b > 0) {
+            noteOnFrames.push_back(frames);
+        }
+        return true;
+    }
+
+    void writeBuf(float*, unsigned int samples) override { frames += samples; }
+
+    void allSoundsOff() override {}
+    void flushSound() override {}
+    void channelSoundsOff(channel_t) override {}
+    bool channelVolume(channel_t, float) override { return true; }
+    bool channelBalance(channel_t, float) override { return true; }
+    bool channelPitch(channel_t, int16_t) override { return true; }
+};
+
+class SingleSynthRegister : public ISynthesizersRegister
+{
+public:
+    SingleSynthRegister(std::shared_ptr<ISynthesizer> s)
+        : m_synth(s) {}
+
+    void registerSynthesizer(const SynthName&, std::shared_ptr<ISynthesizer>) override {}
+    std::shared_ptr<ISynthesizer> synthesizer(const SynthName&) const override { return m_synth; }
+    std::vector<std::shared_ptr<ISynthesizer> > synthesizers() const override { return { m_synth }; }
+
+    void setDefaultSynthesizer(const SynthName&) override {}
+    std::shared_ptr<ISynthesizer> defaultSynthesizer() const override { return m_synth; }
+
+private:
+    std::shared_ptr<ISynthesizer> m_synth;
+};
+}
+
+class SequencerTests : public ::testing::Test
+{
+public:
+
+    //! NOTE A click on every beat, the tempo changes at the start of the 3rd and 5th bars
+    static std::shared_ptr<MidiStream> makeClickTrack()
+    {
+        auto stream = std::make_shared<MidiStream>();
+        MidiData& data = stream->initData;
+        data.division = DIVISION;
+        data.tempoMap = { { 0, 500000 }, { 2 * BAR_TICKS, 333333 }, { 4 * BAR_TICKS, 750000 } };
+        data.initEvents.push_back(Event(0, EventType::ME_CONTROLLER, 7, 100));
+
+        Track track;
+        track.num = 0;
+        track.channels.push_back(0);
+        data.tracks.push_back(track);
+
+        for (int bar = 0; bar < BARS; ++bar) {
+            Chunk chunk;
+            chunk.beginTick = bar * BAR_TICKS;
+            chunk.endTick = chunk.beginTick + BAR_TICKS;
+            for (tick_t tick = chunk.beginTick; tick < chunk.endTick; tick += DIVISION) {
+                chunk.events.insert({ tick, Event(0, EventType::ME_NOTEON, 60, 100) });
+                chunk.events.insert({ tick + DIVISION / 2, Event(0, EventType::ME_NOTEOFF, 60, 0) });
+            }
+            data.chunks.insert({ chunk.beginTick, chunk });
+        }
+
+        stream->isStreamingAllowed = false;
+        stream->lastTick = BARS * BAR_TICKS;
+        return stream;
+    }
+
+    //! NOTE Computed independently of the sequencer
+    static double tickToSec(const TempoMap& tempoMap, tick_t tick)
+    {
+        double sec = 0.0;
+        auto it = tempoMap.begin();
+        while (it != tempoMap.end()) {
+            auto next = std::next(it);
+            tick_t end = (next == tempoMap.end() || next->first > tick) ? tick : next->first;
+            sec += static_cast<double>(end - it->first) * it->second / 1000000.0 / DIVISION;
+            if (end == tick) {
+                break;
+            }
+            it = next;
+        }
+        return sec;
+    }
+
+    struct Result {
+        size_t notes = 0;
+        double maxError = 0.0;
+        double meanError = 0.0;
+    };
+
+    static Result render(unsigned int blockSize, float speed)
+    {
+        auto synth = std::make_shared<FrameCountingSynth>();
+        std::shared_ptr<MidiStream> stream = makeClickTrack();
+
+        Sequencer seq;
+        seq.setsynthesizersRegister(std::make_shared<SingleSynthRegister>(synth));
+        seq.setSampleRate(SAMPLE_RATE);
+        seq.loadMIDI(stream);
+        seq.setPlaybackSpeed(speed);
+        seq.run(0.f);
+
+        std::vector<float> buf(blockSize * AUDIO_CHANNELS);
+        while (!seq.hasEnded()) {
+            seq.getAudio(0.f, &buf[0], blockSize);
+        }
+
+        std::vector<double> expected;
+        for (tick_t tick = 0; tick < stream->lastTick; tick += DIVISION) {
+            expected.push_back(tickToSec(stream->initData.tempoMap, tick) / speed * SAMPLE_RATE);
+        }
+
+        Result r;
+        r.notes = synth->noteOnFrames.size();
+        EXPECT_EQ(r.notes, expected.size());
+
+        double sum = 0.0;
+        for (size_t i = 0; i < std::min(r.notes, expected.size()); ++i) {
+            double err = std::fabs(static_cast<double>(synth->noteOnFrames[i]) - expected[i]);
+            r.maxError = std::max(r.maxError, err);
+            sum += err;
+        }
+        r.meanError = r.notes ? sum / r.notes : 0.0;
+
+        std::printf("block %5u, speed %.2f: %zu notes, error max %.2f, mean %.2f samples\n",
+                    blockSize, speed, r.notes, r.maxError, r.meanError);
+        return r;
+    }
+};
+
+TEST_F(SequencerTests, Sequencer_EventsAtTheirSampleOffsets)
+{
+    //! GIVEN A click track with tempo changes
+
+    for (unsigned int blockSize : { 64u, 512u, 4096u }) {
+        for (float speed : { 1.0f, 1.5f }) {
+            //! DO Render it with the block size
+            Result r = render(blockSize, speed);
+
+            //! CHECK Every click arrives within a sample of its time, whatever the block size
+            EXPECT_LE(r.maxError, 1.0);
+        }
+    }
+}
@@ -53,6 +53,9 @@
 #define PREF_APP_TELEMETRY_ALLOWED                          "application/telemetry/allowed"
 #define PREF_APP_BACKUP_GENERATE_BACKUP                     "application/backup/generateBackup"
 #define PREF_APP_BACKUP_SUBFOLDER                           "application/backup/subfolder"
+#define PREF_APP_SAVE_COMPRESSIONLEVEL                      "application/save/compressionLevel"
+#define PREF_APP_UNDO_LIMIT                                 "application/undo/limit"
+#define PREF_APP_UNDO_MEMORYLIMIT                           "application/undo/memoryLimit"
 #define PREF_EXPORT_AUDIO_NORMALIZE                         "export/audio/normalize"
 #define PREF_EXPORT_AUDIO_SAMPLERATE                        "export/audio/sampleRate"
 #define PREF_EXPORT_AUDIO_PCMRATE                           "export/audio/PCMRate"
@@ -90,6 +93,8 @@
 #define PREF_IO_MIDI_SHORTESTNOTE                           "io/midi/shortestNote"
 #define PREF_IO_MIDI_SHOWCONTROLSINMIXER                    "io/midi/showControlsInMixer"
 #define PREF_IO_MIDI_USEREMOTECONTROL                       "io/midi/useRemoteControl"
+#define PREF_IO_NULLAUDIO_REPORTFILE                        "io/nullAudio/reportFile"
+#define PREF_IO_NULLAUDIO_WAVFILE                           "io/nullAudio/wavFile"
 #define PREF_IO_OSC_PORTNUMBER                              "io/osc/portNumber"
 #define PREF_IO_OSC_USEREMOTECONTROL                        "io/osc/useRemoteControl"
 #define PREF_IO_PORTAUDIO_DEVICE                            "io/portAudio/device"
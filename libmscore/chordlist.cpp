@@ -513,6 +513,26 @@ void ParsedChord::correctXmlText(const QString& s)
 //---------------------------------------------------------
 
 bool ParsedChord::parse(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
+{
+    if (cl) {
+        const ParsedChord* pc = cl->cachedParse(s, syntaxOnly, preferMinor);
+        if (pc) {
+            *this = *pc;
+            return _parseable;
+        }
+    }
+    bool rv = parseUncached(s, cl, syntaxOnly, preferMinor);
+    if (cl) {
+        cl->cacheParse(s, syntaxOnly, preferMinor, *this);
+    }
+    return rv;
+}
+
+//---------------------------------------------------------
+//  parseUncached
+//---------------------------------------------------------
+
+bool ParsedChord::parseUncached(const QString& s, const ChordList* cl, bool syntaxOnly, bool preferMinor)
 {
     QString tok1, tok1L, tok2, tok2L;
     QString extensionDigits = "123456789";
@@ -1730,6 +1750,131 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 #endif
 }
 
+//---------------------------------------------------------
+//   insert
+//    add or replace a chord description,
+//    keeping the lookup index up to date
+//---------------------------------------------------------
+
+ChordList::iterator ChordList::insert(int id, const ChordDescription& cd)
+{
+    if (contains(id)) {
+        _indexValid = false;              // names of the old entry may still be indexed
+    }
+    iterator i = QMap<int, ChordDescription>::insert(id, cd);
+    if (_indexValid) {
+        addToIndex(*i);
+    }
+    return i;
+}
+
+//---------------------------------------------------------
+//   addToIndex
+//    a name maps to the lowest id using it,
+//    a parsed chord to the highest id having one of its
+//    names parse to it
+//---------------------------------------------------------
+
+void ChordList::addToIndex(const ChordDescription& cd) const
+{
+    if (cd.names.empty()) {
+        return;
+    }
+    for (const QString& name : cd.names) {
+        auto i = _nameIndex.find(name);
+        if (i == _nameIndex.end()) {
+            _nameIndex.insert(name, cd.id);
+        } else if (cd.id < i.value()) {
+            i.value() = cd.id;
+        }
+    }
+    for (const ParsedChord& pc : cd.parsedChords) {
+        auto i = _parsedIndex.find(pc.handle());
+        if (i == _parsedIndex.end()) {
+            _parsedIndex.insert(pc.handle(), cd.id);
+        } else if (cd.id > i.value()) {
+            i.value() = cd.id;
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   rebuildIndex
+//---------------------------------------------------------
+
+void ChordList::rebuildIndex() const
+{
+    _nameIndex.clear();
+    _parsedIndex.clear();
+    for (const ChordDescription& cd : *this) {
+        addToIndex(cd);
+    }
+    _indexValid = true;
+}
+
+//---------------------------------------------------------
+//   invalidate
+//    drop index and cached parse results,
+//    they depend on the chord list contents
+//---------------------------------------------------------
+
+void ChordList::invalidate()
+{
+    _indexValid = false;
+    _nameIndex.clear();
+    _parsedIndex.clear();
+    _parseCache.clear();
+}
+
+//---------------------------------------------------------
+//   description
+//    look up name in chord list
+//    optionally look up by parsed chord as fallback
+//    return chord description if found, or null
+//---------------------------------------------------------
+
+const ChordDescription* ChordList::description(const QString& name, const ParsedChord* pc) const
+{
+    if (!_indexValid) {
+        rebuildIndex();
+    }
+    auto i = _nameIndex.constFind(name);
+    if (i != _nameIndex.constEnd()) {
+        return &*constFind(i.value());
+    }
+    // exact match failed, so fall back on parsed match if one was found
+    if (pc) {
+        i = _parsedIndex.constFind(pc->handle());
+        if (i != _parsedIndex.constEnd()) {
+            return &*constFind(i.value());
+        }
+    }
+    return 0;
+}
+
+//---------------------------------------------------------
+//   cachedParse
+//    return result of an earlier ParsedChord::parse() of s
+//    or null
+//---------------------------------------------------------
+
+const ParsedChord* ChordList::cachedParse(const QString& s, bool syntaxOnly, bool preferMinor) const
+{
+    QString key = QString(QChar('0' + (syntaxOnly ? 1 : 0) + (preferMinor ? 2 : 0))) + s;
+    auto i = _parseCache.constFind(key);
+    return i == _parseCache.constEnd() ? 0 : &i.value();
+}
+
+//---------------------------------------------------------
+//   cacheParse
+//---------------------------------------------------------
+
+void ChordList::cacheParse(const QString& s, bool syntaxOnly, bool preferMinor, const ParsedChord& pc) const
+{
+    QString key = QString(QChar('0' + (syntaxOnly ? 1 : 0) + (preferMinor ? 2 : 0))) + s;
+    _parseCache.insert(key, pc);
+}
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -1737,6 +1882,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 void ChordList::read(XmlReader& e)
 {
     int fontIdx = 0;
+    invalidate();
     _autoAdjust = false;
     while (e.readNextStartElement()) {
         const QStringRef& tag(e.name());
@@ -1836,6 +1982,8 @@ void ChordList::read(XmlReader& e)
             e.unknown();
         }
     }
+    // tokens read above change how chords parse
+    _parseCache.clear();
 }
 
 //---------------------------------------------------------
@@ -1996,6 +2144,7 @@ bool ChordList::loaded() const
 void ChordList::unload()
 {
     clear();
+    invalidate();
     symbols.clear();
     fonts.clear();
     renderListRoot.clear();
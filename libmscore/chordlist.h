@@ -157,6 +157,8 @@ public:
     bool operator!=(const ParsedChord& c) const { return !(*this == c); }
     ParsedChord();
 private:
+    bool parseUncached(const QString&, const ChordList*, bool syntaxOnly, bool preferMinor);
+
     QString _name;
     QString _handle;
     QString _quality;
@@ -247,6 +249,17 @@ class ChordList : public QMap<int, ChordDescription>
     qreal _emag = 1.0, _eadjust = 0.0;
     qreal _mmag = 1.0, _madjust = 0.0;
 
+    // lookup index: chord name -> id, ParsedChord handle -> id
+    // rebuilt lazily after bulk changes, updated incrementally by insert()
+    mutable QHash<QString, int> _nameIndex;
+    mutable QHash<QString, int> _parsedIndex;
+    mutable bool _indexValid = false;
+    mutable QHash<QString, ParsedChord> _parseCache;
+
+    void addToIndex(const ChordDescription&) const;
+    void rebuildIndex() const;
+    void invalidate();
+
 public:
     QList<ChordFont> fonts;
     QList<RenderAction> renderListRoot;
@@ -268,6 +281,12 @@ public:
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    iterator insert(int id, const ChordDescription& cd);
+    const ChordDescription* description(const QString& name, const ParsedChord* pc = 0) const;
+
+    const ParsedChord* cachedParse(const QString& s, bool syntaxOnly, bool preferMinor) const;
+    void cacheParse(const QString& s, bool syntaxOnly, bool preferMinor, const ParsedChord& pc) const;
 };
 }     // namespace Ms
 #endif
@@ -249,6 +249,7 @@ void Score::undoRedo(bool undo, EditData* ed)
     } else {
         undoStack()->redo(ed);
     }
+    invalidatePositions();
     update(false);
     masterScore()->setPlaylistDirty();    // TODO: flag all individual operations
     updateSelection();
@@ -110,6 +110,7 @@ void Element::spatiumChanged(qreal oldValue, qreal newValue)
 {
     if (sizeIsSpatiumDependent()) {
         _offset *= (newValue / oldValue);
+        invalidatePositions();
     }
 }
 
@@ -122,6 +123,7 @@ void Element::localSpatiumChanged(qreal oldValue, qreal newValue)
 {
     if (sizeIsSpatiumDependent()) {
         _offset *= (newValue / oldValue);
+        invalidatePositions();
     }
 }
 
@@ -425,12 +427,41 @@ QColor Element::curColor(bool isVisible, QColor normalColor) const
     return normalColor;
 }
 
+//---------------------------------------------------------
+//   invalidatePositions
+//---------------------------------------------------------
+
+void Element::invalidatePositions() const
+{
+    if (Score* s = score()) {
+        s->invalidatePositions();
+    }
+}
+
 //---------------------------------------------------------
 //   pagePos
 //    return position in canvas coordinates
 //---------------------------------------------------------
 
 QPointF Element::pagePos() const
+{
+    const Score* s = score();
+    if (!s) {
+        return computePagePos();
+    }
+    const quint64 epoch = s->positionEpoch();
+    if (_pagePosEpoch != epoch) {
+        _pagePosCache = computePagePos();
+        _pagePosEpoch = epoch;
+    }
+    return _pagePosCache;
+}
+
+//---------------------------------------------------------
+//   computePagePos
+//---------------------------------------------------------
+
+QPointF Element::computePagePos() const
 {
     QPointF p(pos());
     if (parent() == 0) {
@@ -475,6 +506,24 @@ QPointF Element::pagePos() const
 //---------------------------------------------------------
 
 QPointF Element::canvasPos() const
+{
+    const Score* s = score();
+    if (!s) {
+        return computeCanvasPos();
+    }
+    const quint64 epoch = s->positionEpoch();
+    if (_canvasPosEpoch != epoch) {
+        _canvasPosCache = computeCanvasPos();
+        _canvasPosEpoch = epoch;
+    }
+    return _canvasPosCache;
+}
+
+//---------------------------------------------------------
+//   computeCanvasPos
+//---------------------------------------------------------
+
+QPointF Element::computeCanvasPos() const
 {
     QPointF p(pos());
     if (parent() == nullptr) {
@@ -1314,6 +1363,7 @@ bool Element::setProperty(Pid propertyId, const QVariant& v)
         break;
     case Pid::OFFSET:
         _offset = v.toPointF();
+        invalidatePositions();
         break;
     case Pid::MIN_DISTANCE:
         setMinDistance(v.value<Spatium>());
@@ -176,6 +176,14 @@ class Element : public ScoreElement
     ///< valid after call to layout()
     uint _tag;                    ///< tag bitmask
 
+    mutable QPointF _pagePosCache;        ///< last result of pagePos()
+    mutable QPointF _canvasPosCache;      ///< last result of canvasPos()
+    mutable quint64 _pagePosEpoch   { 0 };
+    mutable quint64 _canvasPosEpoch { 0 };
+
+    QPointF computePagePos() const;
+    QPointF computeCanvasPos() const;
+
 public:
     enum class EditBehavior {
         SelectOnly,
@@ -199,7 +207,7 @@ public:
     void deleteLater();
 
     Element* parent() const { return _parent; }
-    void setParent(Element* e) { _parent = e; }
+    void setParent(Element* e) { _parent = e; invalidatePositions(); }
 
     virtual ScoreElement* treeParent() const override { return _parent; }
 
@@ -266,15 +274,23 @@ public:
     virtual const QPointF pos() const { return _pos + _offset; }
     virtual qreal x() const { return _pos.x() + _offset.x(); }
     virtual qreal y() const { return _pos.y() + _offset.y(); }
-    void setPos(qreal x, qreal y) { _pos.rx() = x, _pos.ry() = y; }
-    void setPos(const QPointF& p) { _pos = p; }
-    QPointF& rpos() { return _pos; }
-    qreal& rxpos() { return _pos.rx(); }
-    qreal& rypos() { return _pos.ry(); }
-    virtual void move(const QPointF& s) { _pos += s; }
+    void setPos(qreal x, qreal y) { _pos.rx() = x, _pos.ry() = y; invalidatePositions(); }
+    void setPos(const QPointF& p) { _pos = p; invalidatePositions(); }
+    QPointF& rpos() { invalidatePositions(); return _pos; }
+    qreal& rxpos() { invalidatePositions(); return _pos.rx(); }
+    qreal& rypos() { invalidatePositions(); return _pos.ry(); }
+    virtual void move(const QPointF& s) { _pos += s; invalidatePositions(); }
 
     virtual QPointF pagePos() const;            ///< position in page coordinates
     virtual QPointF canvasPos() const;          ///< position in canvas coordinates
+
+    //! Absolute positions are cached per element and stay valid until the
+    //! position epoch of the element's score changes. Every position setter
+    //! bumps it, layout bumps it on entry and exit; code changing positions
+    //! behind the accessors' back (e.g. System for its SysStaff geometry) has
+    //! to call invalidatePositions() itself. The r*pos() and r*offset()
+    //! accessors are for writing, read-only code uses ipos() and offset().
+    void invalidatePositions() const;
     qreal pageX() const;
     qreal canvasX() const;
 
@@ -282,11 +298,11 @@ public:
     QPointF mapToCanvas(const QPointF& p) const { return p + canvasPos(); }
 
     const QPointF& offset() const { return _offset; }
-    virtual void setOffset(const QPointF& o) { _offset = o; }
-    void setOffset(qreal x, qreal y) { _offset.rx() = x, _offset.ry() = y; }
-    QPointF& roffset() { return _offset; }
-    qreal& rxoffset() { return _offset.rx(); }
-    qreal& ryoffset() { return _offset.ry(); }
+    virtual void setOffset(const QPointF& o) { _offset = o; invalidatePositions(); }
+    void setOffset(qreal x, qreal y) { _offset.rx() = x, _offset.ry() = y; invalidatePositions(); }
+    QPointF& roffset() { invalidatePositions(); return _offset; }
+    qreal& rxoffset() { invalidatePositions(); return _offset.rx(); }
+    qreal& ryoffset() { invalidatePositions(); return _offset.ry(); }
 
     virtual Fraction tick() const;
     virtual Fraction rtick() const;
@@ -374,7 +390,7 @@ public:
     virtual std::vector<QPointF> gripsPositions(const EditData& = EditData()) const { return std::vector<QPointF>(); }
 
     int track() const { return _track; }
-    virtual void setTrack(int val) { _track = val; }
+    virtual void setTrack(int val) { _track = val; invalidatePositions(); }
 
     int z() const;
     void setZ(int val) { _z = val; }
@@ -1211,24 +1211,7 @@ const ChordDescription* Harmony::descr() const
 const ChordDescription* Harmony::descr(const QString& name, const ParsedChord* pc) const
 {
     const ChordList* cl = score()->style().chordList();
-    const ChordDescription* match = 0;
-    if (cl) {
-        for (const ChordDescription& cd : *cl) {
-            for (const QString& s : cd.names) {
-                if (s == name) {
-                    return &cd;
-                } else if (pc) {
-                    for (const ParsedChord& sParsed : cd.parsedChords) {
-                        if (sParsed == *pc) {
-                            match = &cd;
-                        }
-                    }
-                }
-            }
-        }
-    }
-    // exact match failed, so fall back on parsed match if one was found
-    return match;
+    return cl ? cl->description(name, pc) : 0;
 }
 
 //---------------------------------------------------------
@@ -1399,7 +1382,7 @@ QPoint Harmony::calculateBoundingRect()
             if (align() & Align::RIGHT) {
                 xx = fd->width() / 2.0;
             }
-            yy = rypos();
+            yy = ipos().y();
         } else {
             if (align() & Align::RIGHT) {
                 xx = cw;
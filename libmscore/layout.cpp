@@ -940,7 +940,7 @@ void Score::layoutChords3(std::vector<Note*>& notes, const Staff* staff, Segment
         }
 
         qreal ny = (note->line() + stepOffset) * stepDistance;
-        if (note->rypos() != ny) {
+        if (note->ipos().y() != ny) {
             note->rypos() = ny;
             if (chord->stem()) {
                 chord->stem()->layout();
@@ -3571,9 +3571,9 @@ void alignHarmonies(const System* system, const std::vector<Segment*>& sl, bool
                     be = getReferenceElement(s, above, true);
                 }
                 if (be && ((above && (be->y() < (reference + maxShift))) || ((!above && (be->y() > (reference - maxShift)))))) {
-                    qreal shift = be->rypos();
-                    be->rypos() = reference - be->ryoffset();
-                    shift -= be->rypos();
+                    qreal shift = be->ipos().y();
+                    be->rypos() = reference - be->offset().y();
+                    shift -= be->ipos().y();
                     for (Element* e : elements[s]) {
                         if ((above && e->placeBelow()) || (!above && e->placeAbove())) {
                             continue;
@@ -3663,13 +3663,13 @@ static void processLines(System* system, std::vector<Spanner*> lines, bool align
     if (align && segments.size() > 1) {
         const int nstaves = system->staves()->size();
         constexpr qreal minY = -1000000.0;
-        const qreal defaultY = segments[0]->rypos();
+        const qreal defaultY = segments[0]->ipos().y();
         std::vector<qreal> y(nstaves, minY);
 
         for (SpannerSegment* ss : segments) {
             if (ss->visible()) {
                 qreal& staffY = y[ss->staffIdx()];
-                staffY = qMax(staffY, ss->rypos());
+                staffY = qMax(staffY, ss->ipos().y());
             }
         }
         for (SpannerSegment* ss : segments) {
@@ -4532,7 +4532,7 @@ void Score::layoutSystemElements(System* system, LayoutContext& lc)
                         break;
                     }
                 }
-                y = qMin(y, ss->rypos());
+                y = qMin(y, ss->ipos().y());
                 ++idx;
                 prevVolta = volta;
             }
@@ -4855,6 +4855,22 @@ public:
     ~CmdStateLocker() { score->cmdState().unlock(); }
 };
 
+//---------------------------------------------------------
+//   PositionsInvalidator
+//    layout moves elements in many ways the position
+//    epoch does not see, so cached positions are dropped
+//    when it starts and again when it is done
+//---------------------------------------------------------
+
+class PositionsInvalidator
+{
+    Score* score;
+public:
+    PositionsInvalidator(Score* s)
+        : score(s) { score->invalidatePositions(); }
+    ~PositionsInvalidator() { score->invalidatePositions(); }
+};
+
 //---------------------------------------------------------
 //   doLayoutRange
 //---------------------------------------------------------
@@ -4862,7 +4878,9 @@ public:
 void Score::doLayoutRange(const Fraction& st, const Fraction& et)
 {
     CmdStateLocker cmdStateLocker(this);
+    PositionsInvalidator positionsInvalidator(this);
     LayoutContext lc(this);
+    invalidateLayoutElementIndex();
 
     Fraction stick(st);
     Fraction etick(et);
@@ -1038,6 +1038,7 @@ void Measure::moveTicks(const Fraction& diff)
 
 void Measure::removeStaves(int sStaff, int eStaff)
 {
+    score()->invalidateElementIndex();        // segments drop the elements of the staves
     for (Segment* s = first(); s; s = s->next()) {
         for (int staff = eStaff - 1; staff >= sStaff; --staff) {
             s->removeStaff(staff);
@@ -1062,6 +1063,7 @@ void Measure::removeStaves(int sStaff, int eStaff)
 
 void Measure::insertStaves(int sStaff, int eStaff)
 {
+    score()->invalidateElementIndex();
     for (Element* e : el()) {
         if (e->track() == -1) {
             continue;
@@ -1233,6 +1235,7 @@ void Measure::cmdAddStaves(int sStaff, int eStaff, bool createRest)
 
 void Measure::insertMStaff(MStaff* staff, int idx)
 {
+    score()->invalidateElementIndex();        // spacers
     _mstaves.insert(_mstaves.begin() + idx, staff);
     for (unsigned staffIdx = 0; staffIdx < _mstaves.size(); ++staffIdx) {
         _mstaves[staffIdx]->setTrack(staffIdx * VOICES);
@@ -1245,6 +1248,7 @@ void Measure::insertMStaff(MStaff* staff, int idx)
 
 void Measure::removeMStaff(MStaff* /*staff*/, int idx)
 {
+    score()->invalidateElementIndex();
     _mstaves.erase(_mstaves.begin() + idx);
     for (unsigned staffIdx = 0; staffIdx < _mstaves.size(); ++staffIdx) {
         _mstaves[staffIdx]->setTrack(staffIdx * VOICES);
@@ -3842,7 +3846,7 @@ qreal Measure::createEndBarLines(bool isLastMeasureInSystem)
     // fix segment layout
     Segment* s = seg->prevActive();
     if (s) {
-        qreal x    = s->rxpos();
+        qreal x    = s->ipos().x();
         computeMinWidth(s, x, false);
     }
 
@@ -101,6 +101,8 @@ qreal MScore::nudgeStep;
 qreal MScore::nudgeStep10;
 qreal MScore::nudgeStep50;
 int MScore::defaultPlayDuration;
+int MScore::undoLimit       = 0;    // max. undo steps, 0 is unlimited
+int MScore::undoMemoryLimit = 0;    // max. estimated undo stack size in MB, 0 is unlimited
 
 QString MScore::lastError;
 int MScore::division    = 480;     // 3840;   // pulses per quarter note (PPQ) // ticks per beat
@@ -345,6 +345,8 @@ public:
     static qreal nudgeStep10;
     static qreal nudgeStep50;
     static int defaultPlayDuration;
+    static int undoLimit;
+    static int undoMemoryLimit;
     static QString lastError;
 
 // #ifndef NDEBUG
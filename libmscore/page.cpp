@@ -478,6 +478,33 @@ QList<Element*> Page::elements()
     return el;
 }
 
+//---------------------------------------------------------
+//   renderList
+//    Flat list of all elements of this page in paint order,
+//    together with their page position. The list is rebuilt
+//    lazily whenever element positions or the page contents
+//    changed since it was last built.
+//---------------------------------------------------------
+
+const std::vector<RenderItem>& Page::renderList()
+{
+    const quint64 epoch = score()->positionEpoch();
+    if (_renderListEpoch == epoch && _renderListShowInvisible == score()->showInvisible()) {
+        return _renderList;
+    }
+    QList<Element*> el = elements();
+    std::stable_sort(el.begin(), el.end(), elementLessThan);
+
+    _renderList.clear();
+    _renderList.reserve(el.size());
+    for (Element* e : el) {
+        _renderList.push_back({ e, e->pagePos(), e->z() });
+    }
+    _renderListEpoch = epoch;
+    _renderListShowInvisible = score()->showInvisible();
+    return _renderList;
+}
+
 //---------------------------------------------------------
 //   tm
 //---------------------------------------------------------
@@ -25,6 +25,17 @@ class XmlWriter;
 class Score;
 class MeasureBase;
 
+//---------------------------------------------------------
+//   RenderItem
+//    one entry of the flat per-page render list
+//---------------------------------------------------------
+
+struct RenderItem {
+    Element* element;
+    QPointF pos;                    // page coordinates
+    int z;
+};
+
 //---------------------------------------------------------
 //   @@ Page
 //   @P pagenumber int (read only)
@@ -39,6 +50,9 @@ class Page final : public Element
     void doRebuildBspTree();
 #endif
     bool bspTreeValid;
+    std::vector<RenderItem> _renderList;
+    quint64 _renderListEpoch { 0 };
+    bool _renderListShowInvisible { false };
 
     QString replaceTextMacros(const QString&) const;
     void drawHeaderFooter(QPainter*, int area, const QString&) const;
@@ -76,9 +90,10 @@ public:
 
     QList<Element*> items(const QRectF& r);
     QList<Element*> items(const QPointF& p);
-    void rebuildBspTree() { bspTreeValid = false; }
+    void rebuildBspTree() { bspTreeValid = false; _renderListEpoch = 0; }
     QPointF pagePos() const override { return QPointF(); }       ///< position in page coordinates
     QList<Element*> elements();                 ///< list of visible elements
+    const std::vector<RenderItem>& renderList();  ///< elements sorted for painting, with page positions
     QRectF tbbox();                             // tight bounding box, excluding white space
     Fraction endTick() const;
 };
@@ -71,7 +71,7 @@ void RehearsalMark::layout()
                 // special case for right aligned rehearsal marks at start of system
                 // left align with start of measure if that is further left
                 if (align() & Align::RIGHT) {
-                    rxpos() = qMin(rpos().x(), measureX + width());
+                    rxpos() = qMin(ipos().x(), measureX + width());
                 }
             }
         }
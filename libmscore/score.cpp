@@ -276,6 +276,19 @@ void MeasureBaseList::fixupSystems()
     }
 }
 
+//---------------------------------------------------------
+//   newPositionEpoch
+//    epochs are unique over all scores, so that a cached
+//    position never matches by chance after an element
+//    moved to another score
+//---------------------------------------------------------
+
+quint64 Score::newPositionEpoch()
+{
+    static std::atomic<quint64> lastEpoch { 0 };
+    return ++lastEpoch;
+}
+
 //---------------------------------------------------------
 //   Score
 //---------------------------------------------------------
@@ -1328,6 +1341,8 @@ static void spatiumHasChanged(void* data, Element* e)
 
 //---------------------------------------------------------
 //   spatiumChanged
+//    every element scales with the spatium, so this
+//    walks the whole score and not the element index
 //---------------------------------------------------------
 
 void Score::spatiumChanged(qreal oldValue, qreal newValue)
@@ -1356,6 +1371,8 @@ static void updateStyle(void*, Element* e)
 //---------------------------------------------------------
 //   styleChanged
 //    must be called after every style change
+//    Any element can have styled properties, so this
+//    walks the whole score and not the element index.
 //---------------------------------------------------------
 
 void Score::styleChanged()
@@ -1414,6 +1431,7 @@ void Score::addElement(Element* element)
 {
     Element* parent = element->parent();
     element->triggerLayout();
+    indexElement(element);
 
 //      qDebug("Score(%p) Element(%p)(%s) parent %p(%s)",
 //         this, element, element->name(), parent, parent ? parent->name() : "");
@@ -1554,6 +1572,7 @@ void Score::removeElement(Element* element)
 {
     Element* parent = element->parent();
     element->triggerLayout();
+    unindexElement(element);
 
 //      qDebug("Score(%p) Element(%p)(%s) parent %p(%s)",
 //         this, element, element->name(), parent, parent ? parent->name() : "");
@@ -3532,6 +3551,197 @@ void Score::collectNoteMatch(void* data, Element* e)
     p->el.append(n);
 }
 
+//---------------------------------------------------------
+//   isLayoutElement
+//    elements of these types are created and deleted by
+//    layout without going through addElement() and
+//    removeElement(), the element index rescans them
+//    after every layout. Their children of other types,
+//    such as tuplet numbers, are not indexed.
+//---------------------------------------------------------
+
+bool Score::isLayoutElement(ElementType t)
+{
+    switch (t) {
+    case ElementType::PAGE:
+    case ElementType::SYSTEM:
+    case ElementType::BRACKET:
+    case ElementType::INSTRUMENT_NAME:
+    case ElementType::SYSTEM_DIVIDER:
+    case ElementType::MEASURE_NUMBER:
+    case ElementType::STAFF_LINES:
+    case ElementType::MMREST:
+    case ElementType::BAR_LINE:         // end bar lines
+    case ElementType::CLEF:             // courtesy and system header elements
+    case ElementType::KEYSIG:
+    case ElementType::TIMESIG:
+    case ElementType::STEM:
+    case ElementType::HOOK:
+    case ElementType::BEAM:
+    case ElementType::STEM_SLASH:
+    case ElementType::LEDGER_LINE:
+    case ElementType::TAB_DURATION_SYMBOL:
+    case ElementType::TUPLET:
+    case ElementType::SLUR_SEGMENT:
+    case ElementType::TIE_SEGMENT:
+    case ElementType::HAIRPIN_SEGMENT:
+    case ElementType::OTTAVA_SEGMENT:
+    case ElementType::TRILL_SEGMENT:
+    case ElementType::LET_RING_SEGMENT:
+    case ElementType::VIBRATO_SEGMENT:
+    case ElementType::PALM_MUTE_SEGMENT:
+    case ElementType::TEXTLINE_SEGMENT:
+    case ElementType::VOLTA_SEGMENT:
+    case ElementType::PEDAL_SEGMENT:
+    case ElementType::LYRICSLINE_SEGMENT:
+    case ElementType::GLISSANDO_SEGMENT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   ElementIndexScan
+//---------------------------------------------------------
+
+struct ElementIndexScan {
+    Score* score;
+    bool layoutElements;        // collect elements owned by layout
+    bool add;
+};
+
+//---------------------------------------------------------
+//   collectElementIndex
+//---------------------------------------------------------
+
+void Score::collectElementIndex(void* data, Element* e)
+{
+    ElementIndexScan* scan = static_cast<ElementIndexScan*>(data);
+    if (isLayoutElement(e->type()) != scan->layoutElements) {
+        return;
+    }
+    if (!scan->layoutElements && e->parent() && isLayoutElement(e->parent()->type())) {
+        return;
+    }
+    ElementIndexEntry& entry = scan->score->_elementIndex[e->type()];
+    if (scan->add) {
+        if (entry.members.insert(e).second) {
+            entry.list.push_back(e);
+        }
+    } else if (entry.members.erase(e)) {
+        entry.compacted = false;
+    }
+}
+
+//---------------------------------------------------------
+//   rebuildElementIndex
+//    Score elements are collected from the measure list,
+//    layout elements from the pages.
+//---------------------------------------------------------
+
+void Score::rebuildElementIndex(bool layoutElements)
+{
+    for (auto& i : _elementIndex) {
+        if (isLayoutElement(i.first) == layoutElements) {
+            i.second = ElementIndexEntry();
+        }
+    }
+    ElementIndexScan scan { this, layoutElements, true };
+    if (layoutElements) {
+        scanElements(&scan, collectElementIndex, true);
+        _layoutElementIndexValid = true;
+    } else {
+        for (MeasureBase* mb = first(); mb; mb = mb->next()) {
+            mb->scanElements(&scan, collectElementIndex, true);
+        }
+        _elementIndexValid = true;
+    }
+}
+
+//---------------------------------------------------------
+//   indexElement
+//    add e and its children to the element index,
+//    called by addElement()
+//    Elements of a multimeasure rest are copies owned by
+//    layout and are not indexed.
+//---------------------------------------------------------
+
+void Score::indexElement(Element* e)
+{
+    if (!_elementIndexValid) {
+        return;
+    }
+    const Measure* m = e->findMeasure();
+    if (m && m->isMMRest()) {
+        return;
+    }
+    ElementIndexScan scan { this, false, true };
+    e->scanElements(&scan, collectElementIndex, true);
+}
+
+//---------------------------------------------------------
+//   unindexElement
+//    remove e and its children from the element index,
+//    called by removeElement()
+//---------------------------------------------------------
+
+void Score::unindexElement(Element* e)
+{
+    if (!_elementIndexValid) {
+        return;
+    }
+    ElementIndexScan scan { this, false, false };
+    e->scanElements(&scan, collectElementIndex, true);
+}
+
+//---------------------------------------------------------
+//   elements
+//    all elements of type t
+//    Score elements are kept up to date by addElement()
+//    and removeElement(), so edits do not rescan the
+//    score. Elements owned by layout (see isLayoutElement())
+//    are rescanned on the first query after a layout.
+//    Elements are listed in score order, followed by the
+//    ones added since the index was built.
+//---------------------------------------------------------
+
+const std::vector<Element*>& Score::elements(ElementType t)
+{
+    const bool layoutElement = isLayoutElement(t);
+    if (layoutElement ? !_layoutElementIndexValid : !_elementIndexValid) {
+        rebuildElementIndex(layoutElement);
+    }
+    static const std::vector<Element*> empty;
+    auto i = _elementIndex.find(t);
+    if (i == _elementIndex.end()) {
+        return empty;
+    }
+    ElementIndexEntry& entry = i->second;
+    if (!entry.compacted) {
+        // drop removed elements; an element removed and added
+        // again (undo) is kept at its first position
+        std::unordered_set<Element*> seen;
+        auto last = std::remove_if(entry.list.begin(), entry.list.end(), [&entry, &seen](Element* e) {
+                return !entry.members.count(e) || !seen.insert(e).second;
+            });
+        entry.list.erase(last, entry.list.end());
+        entry.compacted = true;
+    }
+    return entry.list;
+}
+
+std::vector<Element*> Score::elements(ElementType t, int staffIdx)
+{
+    std::vector<Element*> el;
+    for (Element* e : elements(t)) {
+        if (e->staffIdx() == staffIdx) {
+            el.push_back(e);
+        }
+    }
+    return el;
+}
+
 //---------------------------------------------------------
 //   selectSimilar
 //---------------------------------------------------------
@@ -3558,7 +3768,9 @@ void Score::selectSimilar(Element* e, bool sameStaff)
     pattern.system  = 0;
     pattern.durationTicks = Fraction(-1,1);
 
-    score->scanElements(&pattern, collectMatch);
+    for (Element* ee : score->elements(type)) {
+        collectMatch(&pattern, ee);
+    }
 
     score->select(0, SelectType::SINGLE, 0);
     for (Element* ee : pattern.el) {
@@ -18,6 +18,9 @@
  Definition of Score class.
 */
 
+#include <atomic>
+#include <unordered_set>
+
 #include "config.h"
 #include "input.h"
 #include "instrument.h"
@@ -353,6 +356,19 @@ public:
     bool isNewerThan(const ScoreContentState& s2) const { return score == s2.score && num > s2.num; }
 };
 
+//---------------------------------------------------------
+//   MsczEntry
+//    an uncompressed file of an mscz archive
+//---------------------------------------------------------
+
+struct MsczEntry {
+    QString path;
+    QByteArray data;
+    bool compress { true };       // false for data which is compressed already
+};
+
+using MsczEntries = std::vector<MsczEntry>;
+
 class MasterScore;
 
 //-----------------------------------------------------------------------------
@@ -496,6 +512,21 @@ private:
 
     int _mscVersion { MSCVERSION };     ///< version of current loading *.msc file
 
+    std::atomic<quint64> _posEpoch { newPositionEpoch() };   ///< see Element::invalidatePositions()
+    static quint64 newPositionEpoch();
+
+    struct ElementIndexEntry {
+        std::unordered_set<Element*> members;
+        std::vector<Element*> list;             ///< members in index order, removed ones stay until compacted
+        bool compacted { true };
+    };
+    std::map<ElementType, ElementIndexEntry> _elementIndex;   ///< live elements by type, see elements()
+    bool _elementIndexValid { false };          ///< score elements, updated by addElement()/removeElement()
+    bool _layoutElementIndexValid { false };    ///< elements owned by layout, rebuilt after layout
+
+    void rebuildElementIndex(bool layoutElements);
+    static void collectElementIndex(void* data, Element* e);
+
     QMap<QString, QString> _metaTags;
 
     constexpr static double _defaultTempo = 2.0;   //default tempo is equal 120 bpm
@@ -505,6 +536,9 @@ private:
     Audio* _audio { 0 };
     PlayMode _playMode { PlayMode::SYNTHESIZER };
 
+    QByteArray _thumbnailKey;             // content of page 1 when _thumbnailPng was created
+    QByteArray _thumbnailPng;
+
     qreal _noteHeadWidth { 0.0 };         // cached value
     QString accInfo;                      ///< information about selected element(s) for use by screen-readers
     QString accMessage;                   ///< temporary status message for use by screen-readers
@@ -834,6 +868,8 @@ public:
     bool saveFile(QIODevice* f, bool msczFormat, bool onlySelection = false);
     bool saveCompressedFile(QFileInfo&, bool onlySelection, bool createThumbnail = true);
     bool saveCompressedFile(QIODevice*, const QFileInfo&, bool onlySelection, bool createThumbnail = true);
+    bool msczEntries(MsczEntries&, const QFileInfo&, bool onlySelection, bool createThumbnail = true);
+    static bool writeMscz(QIODevice*, const MsczEntries&, int compressionLevel = -1);
 
     void print(QPainter* printer, int page);
     ChordRest* getSelectedChordRest() const;
@@ -845,6 +881,18 @@ public:
     void selectSimilarInRange(Element* e);
     static void collectMatch(void* data, Element* e);
     static void collectNoteMatch(void* data, Element* e);
+
+    const std::vector<Element*>& elements(ElementType);
+    std::vector<Element*> elements(ElementType, int staffIdx);
+    int elementCount(ElementType t) { return int(elements(t).size()); }
+    static bool isLayoutElement(ElementType);
+    void indexElement(Element*);
+    void unindexElement(Element*);
+    void invalidateElementIndex() { _elementIndexValid = false; _layoutElementIndexValid = false; }
+    void invalidateLayoutElementIndex() { _layoutElementIndexValid = false; }
+
+    void invalidatePositions() { _posEpoch.store(newPositionEpoch(), std::memory_order_relaxed); }
+    quint64 positionEpoch() const { return _posEpoch.load(std::memory_order_relaxed); }
     void deselect(Element* obj);
     void deselectAll() { _selection.deselectAll(); }
     void updateSelection() { _selection.update(); }
@@ -1250,6 +1298,7 @@ public:
     QString accessibleMessage() const { return accMessage; }
 
     QImage createThumbnail();
+    QByteArray thumbnailPng();
     QString createRehearsalMarkText(RehearsalMark* current) const;
     QString nextRehearsalMarkText(RehearsalMark* previous, RehearsalMark* current) const;
     //@ ??
@@ -1340,6 +1389,7 @@ class MasterScore : public Score
     Fraction _pos[3];                      ///< 0 - current, 1 - left loop, 2 - right loop
 
     int _midiPortCount      { 0 };                    // A count of JACK/ALSA midi out ports
+    int _cachedPageCount    { -1 };                   // page count stored in the mscz, see loadMscFiles()
     QQueue<MidiInputEvent> _midiInputQueue;           // MIDI events that have yet to be processed
     std::list<MidiInputEvent> _activeMidiPitches;     // MIDI keys currently being held down
     std::vector<MidiMapping> _midiMapping;
@@ -1418,8 +1468,12 @@ public:
     bool saveFile(bool generateBackup = true);
     FileError read1(XmlReader&, bool ignoreVersionError);
     FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
+    FileError loadMscFiles(const QStringList& paths, std::function<QByteArray(const QString&)> fileData,
+                           bool ignoreVersionError);
     FileError loadMsc(QString name, bool ignoreVersionError);
     FileError loadMsc(QString name, QIODevice*, bool ignoreVersionError);
+    FileError loadMscMetadata(QString name);
+    int cachedPageCount() const { return _cachedPageCount; }
     FileError read114(XmlReader&);
     FileError read206(XmlReader&);
     FileError read301(XmlReader&);
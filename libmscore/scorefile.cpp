@@ -19,6 +19,7 @@
 #include "slur.h"
 #include "chordrest.h"
 #include "chord.h"
+#include "note.h"
 #include "tuplet.h"
 #include "beam.h"
 #include "revisions.h"
@@ -589,6 +590,53 @@ QImage Score::createThumbnail()
     return pm;
 }
 
+//---------------------------------------------------------
+//   thumbnailPng
+//    the thumbnail as png; it is only painted again when
+//    anything drawn on the first page has changed
+//---------------------------------------------------------
+
+QByteArray Score::thumbnailPng()
+{
+    QByteArray key;
+    if (layoutMode() == LayoutMode::PAGE && !pages().isEmpty()) {
+        Page* page = pages().front();
+        QByteArray data;
+        QDataStream s(&data, QIODevice::WriteOnly);
+        s << page->bbox();
+        for (const RenderItem& ri : page->renderList()) {
+            const Element* e = ri.element;
+            if (!e->visible()) {
+                continue;
+            }
+            s << int(e->type()) << e->subtype() << ri.pos << e->bbox() << e->color();
+            if (e->isTextBase()) {
+                s << toTextBase(e)->xmlText();
+            } else if (e->isNote()) {
+                s << int(toNote(e)->noteHead());
+            }
+        }
+        key = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+        if (key == _thumbnailKey) {
+            return _thumbnailPng;
+        }
+    }
+
+    QImage pm = createThumbnail();
+
+    QByteArray ba;
+    QBuffer b(&ba);
+    if (!b.open(QIODevice::WriteOnly)) {
+        qDebug("open buffer failed");
+    }
+    if (!pm.save(&b, "PNG")) {
+        qDebug("save failed");
+    }
+    _thumbnailKey = key;
+    _thumbnailPng = ba;
+    return ba;
+}
+
 //---------------------------------------------------------
 //   saveCompressedFile
 //    file is already opened
@@ -596,8 +644,22 @@ QImage Score::createThumbnail()
 
 bool Score::saveCompressedFile(QIODevice* f, const QFileInfo& info, bool onlySelection, bool doCreateThumbnail)
 {
-    MQZipWriter uz(f);
+    MsczEntries entries;
+    if (!msczEntries(entries, info, onlySelection, doCreateThumbnail)) {
+        return false;
+    }
+    return writeMscz(f, entries, preferences.getInt(PREF_APP_SAVE_COMPRESSIONLEVEL));
+}
 
+//---------------------------------------------------------
+//   msczEntries
+//    serialize the score into the uncompressed entries
+//    of an mscz file; this is the only part of saving
+//    which needs access to the score
+//---------------------------------------------------------
+
+bool Score::msczEntries(MsczEntries& entries, const QFileInfo& info, bool onlySelection, bool doCreateThumbnail)
+{
     QString fn = info.completeBaseName() + ".mscx";
     QBuffer cbuf;
     cbuf.open(QIODevice::ReadWrite);
@@ -618,44 +680,43 @@ bool Score::saveCompressedFile(QIODevice* f, const QFileInfo& info, bool onlySel
     xml.etag();
     xml.etag();
     cbuf.seek(0);
-    //uz.addDirectory("META-INF");
-    uz.addFile("META-INF/container.xml", cbuf.data());
+    entries.push_back({ "META-INF/container.xml", cbuf.data() });
 
     QBuffer dbuf;
     dbuf.open(QIODevice::ReadWrite);
     saveFile(&dbuf, true, onlySelection);
     dbuf.seek(0);
-    uz.addFile(fn, dbuf.data());
-
-    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
-    if (fd) { // if is file (may be buffer)
-        fd->flush();     // flush to preserve score data in case of
+    entries.push_back({ fn, dbuf.data() });
+
+    // cache the page count, it is the only metadata
+    // which cannot be derived without a layout
+    if (!onlySelection && layoutMode() == LayoutMode::PAGE && !pages().isEmpty()) {
+        const QByteArray& data = dbuf.data();
+        QBuffer lbuf;
+        lbuf.open(QIODevice::ReadWrite);
+        XmlWriter lxml(this, &lbuf);
+        lxml << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+        lxml.stag("layout");
+        lxml.tag("rootfileSize", data.size());
+        lxml.tag("rootfileChecksum", int(qChecksum(data.constData(), data.size())));
+        lxml.tag("pages", int(pages().size()));
+        lxml.etag();
+        entries.push_back({ "META-INF/layout.xml", lbuf.data() });
     }
-    // any failures on the further operations.
 
     // save images
-    //uz.addDirectory("Pictures");
     for (ImageStoreItem* ip : imageStore) {
         if (!ip->isUsed(this)) {
             continue;
         }
         QString path = QString("Pictures/") + ip->hashName();
-        uz.addFile(path, ip->buffer());
+        // png and jpg would not get smaller, only svg is worth compressing
+        entries.push_back({ path, ip->buffer(), path.endsWith(".svg", Qt::CaseInsensitive) });
     }
 
     // create thumbnail
     if (doCreateThumbnail && !pages().isEmpty()) {
-        QImage pm = createThumbnail();
-
-        QByteArray ba;
-        QBuffer b(&ba);
-        if (!b.open(QIODevice::WriteOnly)) {
-            qDebug("open buffer failed");
-        }
-        if (!pm.save(&b, "PNG")) {
-            qDebug("save failed");
-        }
-        uz.addFile("Thumbnails/thumbnail.png", ba);
+        entries.push_back({ "Thumbnails/thumbnail.png", thumbnailPng(), false });
     }
 
 #ifdef OMR
@@ -673,7 +734,7 @@ bool Score::saveCompressedFile(QIODevice* f, const QFileInfo& info, bool onlySel
                 MScore::lastError = tr("Save file: cannot save image (%1x%2)").arg(image.width(), image.height());
                 return false;
             }
-            uz.addFile(path, cbuf1.data());
+            entries.push_back({ path, cbuf1.data(), false });
             cbuf1.close();
         }
     }
@@ -682,11 +743,52 @@ bool Score::saveCompressedFile(QIODevice* f, const QFileInfo& info, bool onlySel
     // save audio
     //
     if (_audio) {
-        uz.addFile("audio.ogg", _audio->data());
+        entries.push_back({ "audio.ogg", _audio->data(), false });
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   compressMsczEntry
+//---------------------------------------------------------
+
+static MQZipWriter::CompressedData compressMsczEntry(const MsczEntry& entry, int compressionLevel)
+{
+    return MQZipWriter::compress(entry.data,
+                                 entry.compress ? MQZipWriter::AutoCompress : MQZipWriter::NeverCompress,
+                                 compressionLevel);
+}
+
+//---------------------------------------------------------
+//   writeMscz
+//    compress the entries into an mscz file; does not
+//    touch any score and can run in a worker thread.
+//    The entries are compressed in parallel and written
+//    in order as soon as they are ready.
+//---------------------------------------------------------
+
+bool Score::writeMscz(QIODevice* f, const MsczEntries& entries, int compressionLevel)
+{
+    QList<QFuture<MQZipWriter::CompressedData> > compressed;
+    for (const MsczEntry& entry : entries) {
+        compressed.append(QtConcurrent::run(compressMsczEntry, entry, compressionLevel));
     }
 
+    MQZipWriter uz(f);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const MsczEntry& entry = entries[i];
+        uz.addCompressedFile(entry.path, compressed[int(i)].result());
+
+        if (entry.path.endsWith(".mscx")) {
+            QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
+            if (fd) { // if is file (may be buffer)
+                fd->flush();     // flush to preserve score data in case of
+            }
+            // any failures on the further operations.
+        }
+    }
     uz.close();
-    return true;
+    return uz.status() == MQZipWriter::NoError;
 }
 
 //---------------------------------------------------------
@@ -800,11 +902,10 @@ bool Score::saveFile(QIODevice* f, bool msczFormat, bool onlySelection)
 //   readRootFile
 //---------------------------------------------------------
 
-QString readRootFile(MQZipReader* uz, QList<QString>& images)
+static QString readRootFile(const QByteArray& cbuf, QList<QString>& images)
 {
     QString rootfile;
 
-    QByteArray cbuf = uz->fileData("META-INF/container.xml");
     if (cbuf.isEmpty()) {
         qDebug("can't find container.xml");
         return rootfile;
@@ -841,6 +942,11 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
     return rootfile;
 }
 
+QString readRootFile(MQZipReader* uz, QList<QString>& images)
+{
+    return readRootFile(uz->fileData("META-INF/container.xml"), images);
+}
+
 //---------------------------------------------------------
 //   loadCompressedMsc
 //    return false on error
@@ -849,9 +955,65 @@ QString readRootFile(MQZipReader* uz, QList<QString>& images)
 Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersionError)
 {
     MQZipReader uz(io);
+    QStringList paths;
+    for (const MQZipReader::FileInfo& fi : uz.fileInfoList()) {
+        if (fi.isFile) {
+            paths.append(fi.filePath);
+        }
+    }
+    return loadMscFiles(paths, [&uz](const QString& path) { return uz.fileData(path); }, ignoreVersionError);
+}
+
+//---------------------------------------------------------
+//   readCachedPageCount
+//    page count stored by saveCompressedFile(), -1 if
+//    missing or written for different score data
+//---------------------------------------------------------
 
+static int readCachedPageCount(const QByteArray& layout, const QByteArray& rootfile)
+{
+    if (layout.isEmpty()) {
+        return -1;
+    }
+    int size     = -1;
+    int checksum = -1;
+    int pages    = -1;
+    XmlReader e(layout);
+    while (e.readNextStartElement()) {
+        if (e.name() != "layout") {
+            e.skipCurrentElement();
+            continue;
+        }
+        while (e.readNextStartElement()) {
+            const QStringRef& tag(e.name());
+            if (tag == "rootfileSize") {
+                size = e.readInt();
+            } else if (tag == "rootfileChecksum") {
+                checksum = e.readInt();
+            } else if (tag == "pages") {
+                pages = e.readInt();
+            } else {
+                e.skipCurrentElement();
+            }
+        }
+    }
+    if (size != rootfile.size() || checksum != qChecksum(rootfile.constData(), rootfile.size())) {
+        return -1;
+    }
+    return pages;
+}
+
+//---------------------------------------------------------
+//   loadMscFiles
+//    load the score from the entries of an mscz file;
+//    fileData() is asked only for the entries needed
+//---------------------------------------------------------
+
+Score::FileError MasterScore::loadMscFiles(const QStringList& paths, std::function<QByteArray(const QString&)> fileData,
+                                           bool ignoreVersionError)
+{
     QList<QString> sl;
-    QString rootfile = readRootFile(&uz, sl);
+    QString rootfile = readRootFile(fileData("META-INF/container.xml"), sl);
     if (rootfile.isEmpty()) {
         return FileError::FILE_NO_ROOTFILE;
     }
@@ -861,21 +1023,22 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     //
     if (!MScore::noImages) {
         foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
+            QByteArray dbuf = fileData(s);
             imageStore.add(s, dbuf);
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
+    QByteArray dbuf = fileData(rootfile);
     if (dbuf.isEmpty()) {
-        QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
-        foreach (const MQZipReader::FileInfo& fi, fil) {
-            if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+        for (const QString& path : paths) {
+            if (path.endsWith(".mscx")) {
+                dbuf = fileData(path);
                 break;
             }
         }
     }
+    _cachedPageCount = readCachedPageCount(fileData("META-INF/layout.xml"), dbuf);
+
     XmlReader e(dbuf);
     e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
@@ -889,7 +1052,7 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
         int n = masterScore()->omr()->numPages();
         for (int i = 0; i < n; ++i) {
             QString path = QString("OmrPages/page%1.png").arg(i + 1);
-            QByteArray dbuf1 = uz.fileData(path);
+            QByteArray dbuf1 = fileData(path);
             OmrPage* page = masterScore()->omr()->page(i);
             QImage image;
             if (image.loadFromData(dbuf1, "PNG")) {
@@ -904,7 +1067,7 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     //  read audio
     //
     if (audio()) {
-        QByteArray dbuf1 = uz.fileData("audio.ogg");
+        QByteArray dbuf1 = fileData("audio.ogg");
         audio()->setData(dbuf1);
     }
     return retval;
@@ -938,6 +1101,25 @@ Score::FileError MasterScore::loadMsc(QString name, QIODevice* io, bool ignoreVe
     }
 }
 
+//---------------------------------------------------------
+//   loadMscMetadata
+//    read a score for its metadata only: parts and images
+//    are skipped. The score is not laid out; the page count
+//    of an mscz saved in page mode is in cachedPageCount().
+//---------------------------------------------------------
+
+Score::FileError MasterScore::loadMscMetadata(QString name)
+{
+    const bool noExcerpts = MScore::noExcerpts;
+    const bool noImages   = MScore::noImages;
+    MScore::noExcerpts = true;
+    MScore::noImages   = true;
+    FileError rv = loadMsc(name, false);
+    MScore::noExcerpts = noExcerpts;
+    MScore::noImages   = noImages;
+    return rv;
+}
+
 //---------------------------------------------------------
 //   parseVersion
 //---------------------------------------------------------
@@ -1040,17 +1222,14 @@ void Score::print(QPainter* painter, int pageNo)
     _printing  = true;
     MScore::pdfPrinting = true;
     Page* page = pages().at(pageNo);
-    QRectF fr  = page->abbox();
 
-    QList<Element*> ell = page->items(fr);
-    std::stable_sort(ell.begin(), ell.end(), elementLessThan);
-    for (const Element* e : ell) {
-        if (!e->visible()) {
+    for (const RenderItem& ri : page->renderList()) {
+        if (!ri.element->visible()) {
             continue;
         }
         painter->save();
-        painter->translate(e->pagePos());
-        e->draw(painter);
+        painter->translate(ri.pos);
+        ri.element->draw(painter);
         painter->restore();
     }
     MScore::pdfPrinting = false;
@@ -0,0 +1,64 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SMUFLMETADATA_H__
+#define __SMUFLMETADATA_H__
+
+#include <QtGlobal>
+
+namespace Ms {
+//---------------------------------------------------------
+//   SMuFL metadata of the bundled score fonts
+//    Generated at build time by fonttools/gensmufl from
+//    fonts/smufl/glyphnames.json and fonts/*/metadata.json,
+//    so loading a score font needs no json parsing.
+//---------------------------------------------------------
+
+struct SmuflGlyphName {
+    const char* name;
+    uint code;
+};
+
+struct SmuflAnchor {
+    const char* glyph;
+    const char* anchor;         // stemDownNW, stemUpSE, cutOutNE, ...
+    double x;
+    double y;
+};
+
+struct SmuflEngravingDefault {
+    const char* name;
+    double value;
+};
+
+struct SmuflAlternate {
+    const char* glyph;
+    const char* name;           // name of the alternate glyph
+    uint code;
+};
+
+struct SmuflFontMetadata {
+    const char* fontPath;       // as in ScoreFont::fontPath()
+    const SmuflAnchor* anchors;
+    int anchorCount;
+    const SmuflEngravingDefault* engravingDefaults;
+    int engravingDefaultCount;
+    const SmuflAlternate* alternates;
+    int alternateCount;
+};
+
+extern const SmuflGlyphName smuflGlyphNames[];      // sorted by name (strcmp)
+extern const int smuflGlyphNameCount;
+extern const SmuflFontMetadata smuflFonts[];
+extern const int smuflFontCount;
+}     // namespace Ms
+#endif
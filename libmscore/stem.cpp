@@ -115,7 +115,7 @@ void Stem::layout()
             // move stem start to note attach point
             Note* n  = up() ? chord()->downNote() : chord()->upNote();
             y1      += (up() ? n->stemUpSE().y() : n->stemDownNW().y());
-            rypos() = n->rypos();
+            rypos() = n->ipos().y();
         }
     }
 
@@ -12,11 +12,14 @@
 
 #include "style.h"
 #include "sym.h"
+#include "smuflmetadata.h"
 #include "utils.h"
 #include "score.h"
 #include "xml.h"
 #include "mscore.h"
 
+#include <algorithm>
+
 #include FT_GLYPH_H
 #include FT_IMAGE_H
 #include FT_BBOX_H
@@ -5845,6 +5848,38 @@ const char* Sym::id2name(SymId id)
     return symNames[int(id)];
 }
 
+//---------------------------------------------------------
+//   smuflCodepoint
+//    look up a glyph in the compiled glyphnames table,
+//    return 0 if not found
+//---------------------------------------------------------
+
+static uint smuflCodepoint(const char* name)
+{
+    const SmuflGlyphName* end = smuflGlyphNames + smuflGlyphNameCount;
+    const SmuflGlyphName* i   = std::lower_bound(smuflGlyphNames, end, name,
+                                                 [](const SmuflGlyphName& g, const char* n) {
+        return strcmp(g.name, n) < 0;
+    });
+    return (i != end && strcmp(i->name, name) == 0) ? i->code : 0;
+}
+
+//---------------------------------------------------------
+//   smuflFontMetadata
+//    compiled metadata for a bundled font, 0 if there
+//    is none and metadata.json has to be read instead
+//---------------------------------------------------------
+
+static const SmuflFontMetadata* smuflFontMetadata(const QString& fontPath)
+{
+    for (int i = 0; i < smuflFontCount; ++i) {
+        if (fontPath == smuflFonts[i].fontPath) {
+            return &smuflFonts[i];
+        }
+    }
+    return 0;
+}
+
 //---------------------------------------------------------
 //   initScoreFonts
 //    load default score font
@@ -5852,9 +5887,12 @@ const char* Sym::id2name(SymId id)
 
 void initScoreFonts()
 {
-    QJsonObject glyphNamesJson(ScoreFont::initGlyphNamesJson());
-    if (glyphNamesJson.empty()) {
-        qFatal("initGlyphNamesJson failed");
+    QJsonObject glyphNamesJson;
+    if (!smuflGlyphNameCount) {
+        glyphNamesJson = ScoreFont::initGlyphNamesJson();
+        if (glyphNamesJson.empty()) {
+            qFatal("initGlyphNamesJson failed");
+        }
     }
     int error = FT_Init_FreeType(&ftlib);
     if (!ftlib || error) {
@@ -5864,7 +5902,13 @@ void initScoreFonts()
         const char* name = Sym::symNames[i];
         Sym::lnhash.insert(name, SymId(i));
         bool ok;
-        uint code = glyphNamesJson.value(name).toObject().value("codepoint").toString().mid(2).toUInt(&ok, 16);
+        uint code;
+        if (smuflGlyphNameCount) {
+            code = smuflCodepoint(name);
+            ok   = code != 0;
+        } else {
+            code = glyphNamesJson.value(name).toObject().value("codepoint").toString().mid(2).toUInt(&ok, 16);
+        }
         if (ok) {
             ScoreFont::_mainSymCodeTable[i] = code;
         } else if (MScore::debugMode) {
@@ -5934,6 +5978,71 @@ void ScoreFont::computeMetrics(Sym* sym, int code)
 //            qDebug("no index");
 }
 
+//---------------------------------------------------------
+//   setAnchor
+//    apply a SMuFL glyph anchor, x and y in staff spaces
+//---------------------------------------------------------
+
+void ScoreFont::setAnchor(Sym* sym, const QString& anchor, qreal x, qreal y)
+{
+    constexpr qreal scale = SPATIUM20;
+    if (anchor == "stemDownNW") {
+        sym->setStemDownNW(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
+    } else if (anchor == "stemUpSE") {
+        sym->setStemUpSE(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
+    } else if (anchor == "cutOutNE") {
+        sym->setCutOutNE(QPointF(x * scale, -y * scale));
+    } else if (anchor == "cutOutNW") {
+        sym->setCutOutNW(QPointF(x * scale, -y * scale));
+    } else if (anchor == "cutOutSE") {
+        sym->setCutOutSE(QPointF(x * scale, -y * scale));
+    } else if (anchor == "cutOutSW") {
+        sym->setCutOutSW(QPointF(x * scale, -y * scale));
+    }
+}
+
+//---------------------------------------------------------
+//   setEngravingDefault
+//    map a SMuFL engravingDefaults entry to style values
+//---------------------------------------------------------
+
+void ScoreFont::setEngravingDefault(const QString& key, double value)
+{
+    static const std::list<std::pair<QString, Sid> > engravingDefaultsMapping = {
+        { "staffLineThickness",            Sid::staffLineWidth },
+        { "stemThickness",                 Sid::stemWidth },
+        { "beamThickness",                 Sid::beamWidth },
+        { "beamSpacing",                   Sid::beamDistance },
+        { "legerLineThickness",            Sid::ledgerLineWidth },
+        { "legerLineExtension",            Sid::ledgerLineLength },
+        { "slurEndpointThickness",         Sid::SlurEndWidth },
+        { "slurMidpointThickness",         Sid::SlurMidWidth },
+        { "thinBarlineThickness",          Sid::barWidth },
+        { "thinBarlineThickness",          Sid::doubleBarWidth },
+        { "thickBarlineThickness",         Sid::endBarWidth },
+        { "dashedBarlineThickness",        Sid::barWidth },
+        { "barlineSeparation",             Sid::doubleBarDistance },
+        { "barlineSeparation",             Sid::endBarDistance },
+        { "repeatBarlineDotSeparation",    Sid::repeatBarlineDotSeparation },
+        { "bracketThickness",              Sid::bracketWidth },
+        { "hairpinThickness",              Sid::hairpinLineWidth },
+        { "octaveLineThickness",           Sid::ottavaLineWidth },
+        { "pedalLineThickness",            Sid::pedalLineWidth },
+        { "repeatEndingLineThickness",     Sid::voltaLineWidth },
+        { "lyricLineThickness",            Sid::lyricsLineThickness },
+        { "tupletBracketThickness",        Sid::tupletBracketWidth }
+    };
+    if (key == "textEnclosureThickness") {
+        _textEnclosureThickness = value;
+        return;
+    }
+    for (const auto& mapping : engravingDefaultsMapping) {
+        if (key == mapping.first) {
+            _engravingDefaults.push_back(std::make_pair(mapping.second, value));
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   load
 //---------------------------------------------------------
@@ -5967,90 +6076,52 @@ void ScoreFont::load()
         computeMetrics(sym, code);
     }
 
-    QJsonParseError error;
-    QFile fi(_fontPath + "metadata.json");
-    if (!fi.open(QIODevice::ReadOnly)) {
-        qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
-    }
-    QJsonObject metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
-    if (error.error != QJsonParseError::NoError) {
-        qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
-               error.offset, qPrintable(error.errorString()));
-    }
-
-    QJsonObject oo = metadataJson.value("glyphsWithAnchors").toObject();
-    for (auto i : oo.keys()) {
-        constexpr qreal scale = SPATIUM20;
-        QJsonObject ooo = oo.value(i).toObject();
-        SymId symId = Sym::lnhash.value(i, SymId::noSym);
-        if (symId == SymId::noSym) {
-            // currently, Bravura contains a bunch of entries in glyphsWithAnchors
-            // for glyph names that will not be found - flag32ndUpStraight, etc.
-            //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(fi.fileName()));
-            continue;
-        }
-        Sym* sym = &_symbols[int(symId)];
-        for (auto j : ooo.keys()) {
-            if (j == "stemDownNW") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble();
-                qreal y = ooo.value(j).toArray().at(1).toDouble();
-                sym->setStemDownNW(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
-            } else if (j == "stemUpSE") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble();
-                qreal y = ooo.value(j).toArray().at(1).toDouble();
-                sym->setStemUpSE(QPointF(4.0 * DPI_F * x, 4.0 * DPI_F * -y));
-            } else if (j == "cutOutNE") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                sym->setCutOutNE(QPointF(x, -y));
-            } else if (j == "cutOutNW") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                sym->setCutOutNW(QPointF(x, -y));
-            } else if (j == "cutOutSE") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                sym->setCutOutSE(QPointF(x, -y));
-            } else if (j == "cutOutSW") {
-                qreal x = ooo.value(j).toArray().at(0).toDouble() * scale;
-                qreal y = ooo.value(j).toArray().at(1).toDouble() * scale;
-                sym->setCutOutSW(QPointF(x, -y));
+    const SmuflFontMetadata* metadata = smuflFontMetadata(_fontPath);
+    QJsonObject metadataJson;
+    if (metadata) {
+        for (int i = 0; i < metadata->anchorCount; ++i) {
+            const SmuflAnchor& a = metadata->anchors[i];
+            SymId symId = Sym::lnhash.value(a.glyph, SymId::noSym);
+            if (symId != SymId::noSym) {
+                setAnchor(&_symbols[int(symId)], a.anchor, a.x, a.y);
             }
         }
-    }
-    oo = metadataJson.value("engravingDefaults").toObject();
-    static std::list<std::pair<QString, Sid> > engravingDefaultsMapping = {
-        { "staffLineThickness",            Sid::staffLineWidth },
-        { "stemThickness",                 Sid::stemWidth },
-        { "beamThickness",                 Sid::beamWidth },
-        { "beamSpacing",                   Sid::beamDistance },
-        { "legerLineThickness",            Sid::ledgerLineWidth },
-        { "legerLineExtension",            Sid::ledgerLineLength },
-        { "slurEndpointThickness",         Sid::SlurEndWidth },
-        { "slurMidpointThickness",         Sid::SlurMidWidth },
-        { "thinBarlineThickness",          Sid::barWidth },
-        { "thinBarlineThickness",          Sid::doubleBarWidth },
-        { "thickBarlineThickness",         Sid::endBarWidth },
-        { "dashedBarlineThickness",        Sid::barWidth },
-        { "barlineSeparation",             Sid::doubleBarDistance },
-        { "barlineSeparation",             Sid::endBarDistance },
-        { "repeatBarlineDotSeparation",    Sid::repeatBarlineDotSeparation },
-        { "bracketThickness",              Sid::bracketWidth },
-        { "hairpinThickness",              Sid::hairpinLineWidth },
-        { "octaveLineThickness",           Sid::ottavaLineWidth },
-        { "pedalLineThickness",            Sid::pedalLineWidth },
-        { "repeatEndingLineThickness",     Sid::voltaLineWidth },
-        { "lyricLineThickness",            Sid::lyricsLineThickness },
-        { "tupletBracketThickness",        Sid::tupletBracketWidth }
-    };
-    for (auto i : oo.keys()) {
-        for (auto mapping : engravingDefaultsMapping) {
-            if (i == mapping.first) {
-                _engravingDefaults.push_back(std::make_pair(mapping.second, oo.value(i).toDouble()));
-            } else if (i == "textEnclosureThickness") {
-                _textEnclosureThickness = oo.value(i).toDouble();
+        for (int i = 0; i < metadata->engravingDefaultCount; ++i) {
+            const SmuflEngravingDefault& d = metadata->engravingDefaults[i];
+            setEngravingDefault(d.name, d.value);
+        }
+    } else {
+        QJsonParseError error;
+        QFile fi(_fontPath + "metadata.json");
+        if (!fi.open(QIODevice::ReadOnly)) {
+            qDebug("ScoreFont: open glyph metadata file <%s> failed", qPrintable(fi.fileName()));
+        }
+        metadataJson = QJsonDocument::fromJson(fi.readAll(), &error).object();
+        if (error.error != QJsonParseError::NoError) {
+            qDebug("Json parse error in <%s>(offset: %d): %s", qPrintable(fi.fileName()),
+                   error.offset, qPrintable(error.errorString()));
+        }
+
+        QJsonObject oo = metadataJson.value("glyphsWithAnchors").toObject();
+        for (auto i : oo.keys()) {
+            QJsonObject ooo = oo.value(i).toObject();
+            SymId symId = Sym::lnhash.value(i, SymId::noSym);
+            if (symId == SymId::noSym) {
+                // currently, Bravura contains a bunch of entries in glyphsWithAnchors
+                // for glyph names that will not be found - flag32ndUpStraight, etc.
+                //qDebug("ScoreFont: symId not found <%s> in <%s>", qPrintable(i), qPrintable(fi.fileName()));
+                continue;
+            }
+            Sym* sym = &_symbols[int(symId)];
+            for (auto j : ooo.keys()) {
+                QJsonArray a = ooo.value(j).toArray();
+                setAnchor(sym, j, a.at(0).toDouble(), a.at(1).toDouble());
             }
         }
+        oo = metadataJson.value("engravingDefaults").toObject();
+        for (auto i : oo.keys()) {
+            setEngravingDefault(i, oo.value(i).toDouble());
+        }
     }
     _engravingDefaults.push_back(std::make_pair(Sid::MusicalTextFont, QString("%1 Text").arg(_family)));
 
@@ -6211,6 +6282,16 @@ void ScoreFont::load()
     QJsonObject oa = metadataJson.value("glyphsWithAlternates").toObject();
     bool ok;
     for (const StylisticAlternate& c : alternate) {
+        if (metadata) {
+            for (int i = 0; i < metadata->alternateCount; ++i) {
+                const SmuflAlternate& a = metadata->alternates[i];
+                if (c.key == a.glyph && c.altKey == a.name) {
+                    computeMetrics(&_symbols[int(c.id)], a.code);
+                    break;
+                }
+            }
+            continue;
+        }
         QJsonObject::const_iterator i = oa.find(c.key);
         if (i != oa.end()) {
             QJsonArray oaa = i.value().toObject().value("alternates").toArray();
@@ -2781,6 +2781,8 @@ class ScoreFont
     static std::array<uint, size_t(SymId::lastSym) + 1> _mainSymCodeTable;
     void load();
     void computeMetrics(Sym* sym, int code);
+    void setAnchor(Sym* sym, const QString& anchor, qreal x, qreal y);
+    void setEngravingDefault(const QString& key, double value);
 
 public:
     ScoreFont() {}
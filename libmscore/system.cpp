@@ -175,6 +175,7 @@ SysStaff* System::insertStaff(int idx)
         staff->bbox().setY(_staves[idx - 1]->y() + 6 * spatium());
     }
     _staves.insert(idx, staff);
+    invalidatePositions();
     return staff;
 }
 
@@ -185,6 +186,7 @@ SysStaff* System::insertStaff(int idx)
 void System::removeStaff(int idx)
 {
     _staves.takeAt(idx);
+    invalidatePositions();
 }
 
 //---------------------------------------------------------
@@ -310,6 +312,7 @@ void System::layoutSystem(qreal xo1)
             s->bbox().setRect(_leftMargin + xo1, 0.0, 0.0, h);
         }
     }
+    invalidatePositions();          // SysStaff geometry changed
 
     //---------------------------------------------------
     //  layout brackets
@@ -684,6 +687,7 @@ void System::layout2()
         ss->bbox().setRect(_leftMargin, y - yOffset, width() - _leftMargin, h);
         y += dist;
     }
+    invalidatePositions();          // SysStaff geometry changed
 
     qreal systemHeight = staff(visibleStaves.back().first)->bbox().bottom();
     setHeight(systemHeight);
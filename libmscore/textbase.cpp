@@ -12,6 +12,7 @@
 
 #include "text.h"
 #include "textedit.h"
+#include "textmetrics.h"
 #include "jump.h"
 #include "marker.h"
 #include "score.h"
@@ -249,7 +250,7 @@ QRectF TextCursor::cursorRect() const
     const TextFragment* fragment = tline.fragment(column());
 
     QFont _font  = fragment ? fragment->font(_text) : _text->font();
-    qreal ascent = QFontMetricsF(_font, MScore::paintDevice()).ascent();
+    qreal ascent = TextMetrics::fontMetrics(_font).ascent();
     qreal h = ascent;
     qreal x = tline.xpos(column(), _text);
     qreal y = tline.y() - ascent * .9;
@@ -963,7 +964,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
+        QFontMetricsF fm = TextMetrics::fontMetrics(font, false);
 
         bool fail = false;
         for (int i = 0; i < text.size(); ++i) {
@@ -1063,7 +1064,7 @@ void TextBlock::layout(TextBase* t)
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        QFontMetricsF fm = TextMetrics::fontMetrics(f.font(t));
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
             qreal voffset = fm.xHeight() / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1085,7 +1086,8 @@ void TextBlock::layout(TextBase* t)
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
+            QFontMetricsF fm = TextMetrics::fontMetrics(font);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
                 qreal voffset = fm.xHeight() / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
@@ -1098,14 +1100,14 @@ void TextBlock::layout(TextBase* t)
                 f.pos.setY(0.0);
             }
 
+            const TextRun run = TextMetrics::run(font, f.text);
             // Optimization: don't calculate character position
             // for the next fragment if there is no next fragment
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
-                x += w;
+                x += run.width;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
+            _bbox   |= run.tightBoundingRect.translated(f.pos);
             _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
         }
     }
@@ -1153,7 +1155,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        QFontMetricsF fm = TextMetrics::fontMetrics(f.font(t));
         int idx = 0;
         for (const QChar& c : f.text) {
             ++idx;
@@ -1253,12 +1255,12 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        QFontMetricsF fm = TextMetrics::fontMetrics(f.font(t));
         for (const QChar& c : f.text) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
             qreal xo = fm.width(f.text.left(idx));
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
@@ -1998,7 +2000,7 @@ void TextBase::layoutFrame()
 //      if (empty()) {    // or bbox.width() <= 1.0
     if (bbox().width() <= 1.0 || bbox().height() < 1.0) {      // or bbox.width() <= 1.0
         // this does not work for Harmony:
-        QFontMetricsF fm = QFontMetricsF(font(), MScore::paintDevice());
+        QFontMetricsF fm = TextMetrics::fontMetrics(font());
         qreal ch = fm.ascent();
         qreal cw = fm.width('n');
         frame = QRectF(0.0, -ch, cw, ch);
@@ -2935,7 +2937,7 @@ QFont TextBase::font() const
 
 QFontMetricsF TextBase::fontMetrics() const
 {
-    return QFontMetricsF(font());
+    return TextMetrics::fontMetrics(font(), false);
 }
 
 //---------------------------------------------------------
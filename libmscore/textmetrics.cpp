@@ -0,0 +1,108 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "textmetrics.h"
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   cache
+//---------------------------------------------------------
+
+static const int maxRuns = 20000;
+
+static QMutex metricsMutex;
+static QHash<QString, QFontMetricsF> metricsCache;
+static QCache<QString, TextRun> runCache(maxRuns);
+static TextMetrics::Stats cacheStats;
+
+//---------------------------------------------------------
+//   metricsKey
+//---------------------------------------------------------
+
+static QString metricsKey(const QFont& f, bool paintDevice)
+{
+    return f.key() + (paintDevice ? QChar('d') : QChar('s'));
+}
+
+//---------------------------------------------------------
+//   fontMetrics
+//---------------------------------------------------------
+
+QFontMetricsF TextMetrics::fontMetrics(const QFont& f, bool paintDevice)
+{
+    QString key = metricsKey(f, paintDevice);
+    QMutexLocker lock(&metricsMutex);
+    auto i = metricsCache.constFind(key);
+    if (i != metricsCache.constEnd()) {
+        ++cacheStats.metricsHits;
+        return *i;
+    }
+    ++cacheStats.metricsMisses;
+    QFontMetricsF fm = paintDevice ? QFontMetricsF(f, MScore::paintDevice()) : QFontMetricsF(f);
+    metricsCache.insert(key, fm);
+    return fm;
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+TextRun TextMetrics::run(const QFont& f, const QString& s)
+{
+    QString key = metricsKey(f, true) + QChar(0) + s;
+    {
+        QMutexLocker lock(&metricsMutex);
+        if (const TextRun* r = runCache.object(key)) {
+            ++cacheStats.runHits;
+            return *r;
+        }
+        ++cacheStats.runMisses;
+    }
+    // measure outside of the lock, concurrent misses for the same
+    // key just compute the same value twice
+    QFontMetricsF fm = fontMetrics(f);
+    TextRun* r = new TextRun;
+    r->width             = fm.width(s);
+    r->tightBoundingRect = fm.tightBoundingRect(s);
+    TextRun result = *r;
+
+    QMutexLocker lock(&metricsMutex);
+    runCache.insert(key, r);
+    return result;
+}
+
+//---------------------------------------------------------
+//   clear
+//    drop all cached values and reset the statistics,
+//    needed if the set of available fonts changes
+//---------------------------------------------------------
+
+void TextMetrics::clear()
+{
+    QMutexLocker lock(&metricsMutex);
+    metricsCache.clear();
+    runCache.clear();
+    cacheStats = Stats();
+}
+
+//---------------------------------------------------------
+//   stats
+//    hit and miss counts since the last clear()
+//---------------------------------------------------------
+
+TextMetrics::Stats TextMetrics::stats()
+{
+    QMutexLocker lock(&metricsMutex);
+    return cacheStats;
+}
+}
@@ -0,0 +1,53 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TEXTMETRICS_H__
+#define __TEXTMETRICS_H__
+
+namespace Ms {
+//---------------------------------------------------------
+//   TextRun
+//    measured extent of a string in one font
+//---------------------------------------------------------
+
+struct TextRun {
+    qreal width { 0.0 };
+    QRectF tightBoundingRect;
+};
+
+//---------------------------------------------------------
+//   TextMetrics
+//    process wide cache of font metrics and measured
+//    text runs used by text layout; thread safe
+//
+//    Metrics are for MScore::paintDevice() unless
+//    paintDevice is false.
+//---------------------------------------------------------
+
+class TextMetrics
+{
+public:
+    struct Stats {
+        int metricsHits   { 0 };
+        int metricsMisses { 0 };
+        int runHits       { 0 };
+        int runMisses     { 0 };
+    };
+
+    static QFontMetricsF fontMetrics(const QFont&, bool paintDevice = true);
+    static TextRun run(const QFont&, const QString&);
+    static qreal width(const QFont& f, const QString& s) { return run(f, s).width; }
+    static void clear();
+    static Stats stats();
+};
+}     // namespace Ms
+#endif
@@ -237,6 +237,88 @@ void UndoCommand::filterChildren(UndoCommand::Filter f, Element* target)
     childList = std::move(acceptedList);
 }
 
+//---------------------------------------------------------
+//   memoryUsage
+///   Rough estimate of the memory held by this command
+///   and its children. Commands keeping variable sized
+///   data override it.
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t size = sizeof(UndoCommand) + size_t(childList.size()) * sizeof(UndoCommand*);
+    for (const UndoCommand* c : childList) {
+        size += c->memoryUsage();
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   elementMemoryUsage
+//    rough size of an element and its tree children,
+//    for commands which hold elements removed from the
+//    score
+//---------------------------------------------------------
+
+static size_t elementMemoryUsage(const ScoreElement* e)
+{
+    size_t size;
+    switch (e->type()) {
+    case ElementType::MEASURE:
+        size = sizeof(Measure);
+        break;
+    case ElementType::SEGMENT:
+        size = sizeof(Segment);
+        break;
+    case ElementType::CHORD:
+        size = sizeof(Chord);
+        break;
+    case ElementType::NOTE:
+        size = sizeof(Note);
+        break;
+    case ElementType::REST:
+        size = sizeof(Rest);
+        break;
+    default:
+        if (e->isTextBase()) {
+            size = sizeof(TextBase) + size_t(toTextBase(e)->xmlText().capacity()) * sizeof(QChar);
+        } else {
+            size = sizeof(Element);
+        }
+        break;
+    }
+    for (const ScoreElement* child : *e) {
+        size += elementMemoryUsage(child);
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   compactChildren
+///   Drop children which are made redundant by the
+///   preceding child, see canAbsorb().
+///   Returns the number of dropped commands.
+//---------------------------------------------------------
+
+int UndoCommand::compactChildren()
+{
+    int n = 0;
+    QList<UndoCommand*> compacted;
+    compacted.reserve(childList.size());
+    for (UndoCommand* cmd : qAsConst(childList)) {
+        if (!compacted.empty() && compacted.back()->canAbsorb(cmd)) {
+            delete cmd;
+            ++n;
+        } else {
+            compacted.push_back(cmd);
+        }
+    }
+    if (n) {
+        childList = std::move(compacted);
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   unwind
 //---------------------------------------------------------
@@ -358,12 +440,53 @@ void UndoStack::remove(int idx)
     curIdx = idx;
 }
 
+//---------------------------------------------------------
+//   applyLimits
+//    drop the oldest steps until the stack fits into
+//    MScore::undoLimit steps and MScore::undoMemoryLimit
+//    megabytes. The redo stack and the last step are
+//    always kept.
+//---------------------------------------------------------
+
+void UndoStack::applyLimits()
+{
+    const int maxSteps = MScore::undoLimit;
+    const size_t maxMemory = size_t(qMax(MScore::undoMemoryLimit, 0)) * 1024 * 1024;
+    if (maxSteps <= 0 && maxMemory == 0) {
+        return;
+    }
+
+    size_t memory = 0;
+    for (const UndoMacro* m : qAsConst(list)) {
+        memory += m->estimatedSize();
+    }
+    while (curIdx > 1 && ((maxSteps > 0 && list.size() > maxSteps) || (maxMemory && memory > maxMemory))) {
+        UndoMacro* m = list.takeFirst();
+        stateList.erase(stateList.begin());
+        memory -= m->estimatedSize();
+        m->cleanup(true);
+        delete m;
+        --curIdx;
+        ++droppedSteps;
+    }
+}
+
 //---------------------------------------------------------
 //   mergeCommands
 //---------------------------------------------------------
 
 void UndoStack::mergeCommands(int startIdx)
 {
+    // startIdx counts from the start of the session, see getCurIdx()
+    startIdx -= droppedSteps;
+    if (startIdx < 0) {
+        // The first steps since startIdx have been dropped
+        // because of the undo limits. The steps left are
+        // all newer than startIdx, merge them into the
+        // oldest one; undoing it cannot go back further.
+        qDebug("UndoStack::mergeCommands: %d steps to merge already dropped", -startIdx);
+        startIdx = 0;
+    }
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -376,6 +499,8 @@ void UndoStack::mergeCommands(int startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    compactedCommands += startMacro->compactChildren();
+    startMacro->updateEstimatedSize();
 }
 
 //---------------------------------------------------------
@@ -428,11 +553,16 @@ void UndoStack::endMacro(bool rollback)
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        compactedCommands += curCmd->compactChildren();
+        curCmd->updateEstimatedSize();
         list.append(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+    if (!rollback) {
+        applyLimits();
+    }
 }
 
 //---------------------------------------------------------
@@ -471,7 +601,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -495,6 +625,24 @@ void UndoStack::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   stats
+//---------------------------------------------------------
+
+UndoStackStats UndoStack::stats() const
+{
+    UndoStackStats s;
+    s.undoSteps = curIdx;
+    s.redoSteps = list.size() - curIdx;
+    for (const UndoMacro* m : list) {
+        s.commands    += m->childCount();
+        s.memoryUsage += m->estimatedSize();
+    }
+    s.droppedSteps      = droppedSteps;
+    s.compactedCommands = compactedCommands;
+    return s;
+}
+
 //---------------------------------------------------------
 //   UndoMacro
 //---------------------------------------------------------
@@ -576,6 +724,16 @@ void UndoMacro::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   updateEstimatedSize
+//---------------------------------------------------------
+
+void UndoMacro::updateEstimatedSize()
+{
+    _estimatedSize = sizeof(UndoMacro) - sizeof(UndoCommand) + UndoCommand::memoryUsage()
+                     + (undoSelectionInfo.elements.capacity() + redoSelectionInfo.elements.capacity()) * sizeof(Element*);
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
@@ -608,6 +766,7 @@ void CloneVoice::undo(EditData*)
     Fraction ticks = d->tick() + lTick - sf->tick();
     int sTrack = otrack == -1 ? dtrack : otrack;   // use the correct source / destination if deleting the source
     int dTrack = otrack == -1 ? strack : dtrack;
+    s->invalidateElementIndex();        // the destination voice is cleared directly
 
     // Clear destination voice (in case of not linked and otrack = -1 we would delete our source
     if (otrack != -1 && linked) {
@@ -656,6 +815,7 @@ void CloneVoice::redo(EditData*)
 {
     Score* s = d->score();
     Fraction ticks = d->tick() + lTick - sf->tick();
+    s->invalidateElementIndex();
 
     // Clear destination voice (in case of not linked and otrack = -1 we would delete our source
     if (otrack != -1 && linked) {
@@ -893,6 +1053,17 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryUsage
+//    the removed element is held by the command
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryUsage() const
+{
+    return sizeof(RemoveElement) - sizeof(UndoCommand) + UndoCommand::memoryUsage()
+           + (element ? elementMemoryUsage(element) : 0);
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1017,6 +1188,15 @@ void RemovePart::redo(EditData*)
     part->score()->removePart(part);
 }
 
+//---------------------------------------------------------
+//   RemovePart::memoryUsage
+//---------------------------------------------------------
+
+size_t RemovePart::memoryUsage() const
+{
+    return sizeof(RemovePart) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + sizeof(Part);
+}
+
 //---------------------------------------------------------
 //   InsertStaff
 //---------------------------------------------------------
@@ -1057,6 +1237,15 @@ void RemoveStaff::redo(EditData*)
     staff->score()->removeStaff(staff);
 }
 
+//---------------------------------------------------------
+//   RemoveStaff::memoryUsage
+//---------------------------------------------------------
+
+size_t RemoveStaff::memoryUsage() const
+{
+    return sizeof(RemoveStaff) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + sizeof(Staff);
+}
+
 //---------------------------------------------------------
 //   InsertMStaff
 //---------------------------------------------------------
@@ -1257,6 +1446,16 @@ void ChangeElement::flip(EditData*)
     // score->setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   ChangeElement::memoryUsage
+//    the replaced element is held by the command
+//---------------------------------------------------------
+
+size_t ChangeElement::memoryUsage() const
+{
+    return sizeof(ChangeElement) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + elementMemoryUsage(oldElement);
+}
+
 //---------------------------------------------------------
 //   InsertStaves
 //---------------------------------------------------------
@@ -1874,6 +2073,12 @@ void InsertRemoveMeasures::insertMeasures()
         prevMeasureClefs = getCourtesyClefs(toMeasure(fm));
     }
     score->measures()->insert(fm, lm);
+    for (MeasureBase* mb = fm;; mb = mb->next()) {
+        score->indexElement(mb);
+        if (mb == lm) {
+            break;
+        }
+    }
 
     if (fm->isMeasure()) {
         score->fixTicks();
@@ -1957,6 +2162,12 @@ void InsertRemoveMeasures::removeMeasures()
         }
     }
     score->measures()->remove(fm, lm);
+    for (MeasureBase* mb = fm;; mb = mb->next()) {
+        score->unindexElement(mb);
+        if (mb == lm) {
+            break;
+        }
+    }
 
     score->fixTicks();
     if (fm->isMeasure()) {
@@ -2025,6 +2236,32 @@ void InsertRemoveMeasures::removeMeasures()
     score->setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   measuresMemoryUsage
+//---------------------------------------------------------
+
+size_t InsertRemoveMeasures::measuresMemoryUsage() const
+{
+    size_t size = 0;
+    for (const MeasureBase* m = fm; m; m = m->next()) {
+        size += elementMemoryUsage(m);
+        if (m == lm) {
+            break;
+        }
+    }
+    return size;
+}
+
+//---------------------------------------------------------
+//   RemoveMeasures::memoryUsage
+//    the removed measures are held by the command
+//---------------------------------------------------------
+
+size_t RemoveMeasures::memoryUsage() const
+{
+    return sizeof(RemoveMeasures) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + measuresMemoryUsage();
+}
+
 //---------------------------------------------------------
 //   AddExcerpt::undo
 //---------------------------------------------------------
@@ -2061,6 +2298,24 @@ void RemoveExcerpt::redo(EditData*)
     excerpt->oscore()->removeExcerpt(excerpt);
 }
 
+//---------------------------------------------------------
+//   RemoveExcerpt::memoryUsage
+//    the part score of the removed excerpt is held by
+//    the command
+//---------------------------------------------------------
+
+size_t RemoveExcerpt::memoryUsage() const
+{
+    size_t size = sizeof(RemoveExcerpt) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + sizeof(Excerpt);
+    if (Score* ps = excerpt->partScore()) {
+        size += sizeof(Score);
+        for (const MeasureBase* m = ps->first(); m; m = m->next()) {
+            size += elementMemoryUsage(m);
+        }
+    }
+    return size;
+}
+
 //---------------------------------------------------------
 //   SwapExcerpt::flip
 //---------------------------------------------------------
@@ -2274,6 +2529,56 @@ void ChangeProperty::flip(EditData*)
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   variantMemoryUsage
+//---------------------------------------------------------
+
+static size_t variantMemoryUsage(const QVariant& v)
+{
+    switch (v.type()) {
+    case QVariant::String:
+        return size_t(v.toString().capacity()) * sizeof(QChar);
+    case QVariant::ByteArray:
+        return size_t(v.toByteArray().capacity());
+    case QVariant::List: {
+        size_t size = 0;
+        for (const QVariant& i : v.toList()) {
+            size += sizeof(QVariant) + variantMemoryUsage(i);
+        }
+        return size;
+    }
+    default:
+        return 0;
+    }
+}
+
+//---------------------------------------------------------
+//   ChangeProperty::memoryUsage
+//---------------------------------------------------------
+
+size_t ChangeProperty::memoryUsage() const
+{
+    return sizeof(ChangeProperty) - sizeof(UndoCommand) + UndoCommand::memoryUsage() + variantMemoryUsage(property);
+}
+
+//---------------------------------------------------------
+//   ChangeProperty::canAbsorb
+//    A following change of the same property of the same
+//    element is redundant: undoing this command alone
+//    restores the original value and flags, redoing it
+//    restores the final ones.
+//---------------------------------------------------------
+
+bool ChangeProperty::canAbsorb(const UndoCommand* next) const
+{
+    // derived commands like ChangeBracketProperty do more than set the property
+    if (strcmp(name(), "ChangeProperty") || strcmp(next->name(), "ChangeProperty")) {
+        return false;
+    }
+    const ChangeProperty* cp = static_cast<const ChangeProperty*>(next);
+    return cp->element == element && cp->id == id && cp->childCount() == 0;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
@@ -129,6 +129,10 @@ public:
     bool hasFilteredChildren(Filter, const Element* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const Element* target) const;
     void filterChildren(UndoCommand::Filter f, Element* target);
+
+    virtual size_t memoryUsage() const;
+    virtual bool canAbsorb(const UndoCommand* /* next */) const { return false; }
+    int compactChildren();
 };
 
 //---------------------------------------------------------
@@ -155,6 +159,7 @@ class UndoMacro : public UndoCommand
     SelectionInfo redoSelectionInfo;
 
     Score* score;
+    size_t _estimatedSize { 0 };
 
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
@@ -166,13 +171,33 @@ public:
     bool empty() const { return childCount() == 0; }
     void append(UndoMacro&& other);
 
+    size_t estimatedSize() const { return _estimatedSize; }
+    void updateEstimatedSize();
+
     static bool canRecordSelectedElement(const Element* e);
 
     UNDO_NAME("UndoMacro");
 };
 
+//---------------------------------------------------------
+//   UndoStackStats
+//---------------------------------------------------------
+
+struct UndoStackStats {
+    int undoSteps { 0 };
+    int redoSteps { 0 };
+    int commands { 0 };             // top level commands in all steps
+    size_t memoryUsage { 0 };       // estimated, in bytes
+    int droppedSteps { 0 };         // oldest steps freed because of the undo limits
+    int compactedCommands { 0 };    // redundant property changes merged away
+};
+
 //---------------------------------------------------------
 //   UndoStack
+//    Steps are numbered from the start of the session;
+//    getCurIdx() keeps counting when the oldest steps are
+//    dropped because of MScore::undoLimit or
+//    MScore::undoMemoryLimit.
 //---------------------------------------------------------
 
 class UndoStack
@@ -183,8 +208,11 @@ class UndoStack
     int nextState;
     int cleanState;
     int curIdx;
+    int droppedSteps { 0 };
+    int compactedCommands { 0 };
 
     void remove(int idx);
+    void applyLimits();
 
 public:
     UndoStack();
@@ -201,7 +229,7 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    int getCurIdx() const { return curIdx; }
+    int getCurIdx() const { return droppedSteps + curIdx; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -213,6 +241,8 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    UndoStackStats stats() const;
 };
 
 //---------------------------------------------------------
@@ -244,6 +274,7 @@ public:
     RemovePart(Part*, int idx);
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
+    size_t memoryUsage() const override;
     UNDO_NAME("RemovePart")
 };
 
@@ -276,6 +307,7 @@ public:
     RemoveStaff(Staff*);
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
+    size_t memoryUsage() const override;
     UNDO_NAME("RemoveStaff")
 };
 
@@ -445,6 +477,7 @@ class ChangeElement : public UndoCommand
 
 public:
     ChangeElement(Element* oldElement, Element* newElement);
+    size_t memoryUsage() const override;
     UNDO_NAME("ChangeElement")
 };
 
@@ -584,6 +617,7 @@ public:
     virtual void redo(EditData*) override;
     virtual void cleanup(bool);
     virtual const char* name() const override;
+    size_t memoryUsage() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
 };
@@ -813,6 +847,7 @@ class InsertRemoveMeasures : public UndoCommand
 protected:
     void removeMeasures();
     void insertMeasures();
+    size_t measuresMemoryUsage() const;
 
 public:
     InsertRemoveMeasures(MeasureBase* _fm, MeasureBase* _lm)
@@ -832,6 +867,7 @@ public:
         : InsertRemoveMeasures(m1, m2) {}
     virtual void undo(EditData*) override { insertMeasures(); }
     virtual void redo(EditData*) override { removeMeasures(); }
+    size_t memoryUsage() const override;
     UNDO_NAME("RemoveMeasures")
 };
 
@@ -878,6 +914,7 @@ public:
         : excerpt(ex) {}
     virtual void undo(EditData*) override;
     virtual void redo(EditData*) override;
+    size_t memoryUsage() const override;
     UNDO_NAME("RemoveExcerpt")
 };
 
@@ -1101,6 +1138,9 @@ public:
     QVariant data() const { return property; }
     UNDO_NAME("ChangeProperty")
 
+    size_t memoryUsage() const override;
+    bool canAbsorb(const UndoCommand* next) const override;
+
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override
     {
         return f == UndoCommand::Filter::ChangePropertyLinked && target->linkList().contains(element);
@@ -109,13 +109,20 @@ static void paintElement(QPainter& p, const Element* e)
     p.translate(-pos);
 }
 
-static void paintElements(QPainter& p, const QList<Element*>& el)
+static void paintElement(QPainter& p, const RenderItem& ri)
 {
-    for (Element* e : el) {
-        if (!e->visible()) {
+    p.translate(ri.pos);
+    ri.element->draw(&p);
+    p.translate(-ri.pos);
+}
+
+static void paintElements(QPainter& p, const std::vector<RenderItem>& rl)
+{
+    for (const RenderItem& ri : rl) {
+        if (!ri.element->visible()) {
             continue;
         }
-        paintElement(p, e);
+        paintElement(p, ri);
     }
 }
 
@@ -520,6 +527,7 @@ bool MuseScore::saveFile(MasterScore* score)
     }
     QString tmp = score->tmpName();
     if (!tmp.isEmpty()) {
+        waitForAutoSave();
         QFile f(tmp);
         if (!f.remove()) {
             qDebug("cannot remove temporary file <%s>", qPrintable(f.fileName()));
@@ -2840,9 +2848,7 @@ bool MuseScore::savePng(Score* score, QIODevice* device, int pageNumber, bool dr
         p.translate(-r.topLeft());
     }
 
-    QList< Element*> pel = page->elements();
-    std::stable_sort(pel.begin(), pel.end(), elementLessThan);
-    paintElements(p, pel);
+    paintElements(p, page->renderList());
     if (format == QImage::Format_Indexed8) {
         //convert to grayscale & respect alpha
         QVector<QRgb> colorTable;
@@ -3125,10 +3131,9 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber, bool dr
         }
     }
     // 2nd pass: the rest of the elements
-    QList<Element*> pel = page->elements();
-    std::stable_sort(pel.begin(), pel.end(), elementLessThan);
     ElementType eType;
-    for (const Element* e : pel) {
+    for (const RenderItem& ri : page->renderList()) {
+        const Element* e = ri.element;
         // Always exclude invisible elements
         if (!e->visible()) {
             continue;
@@ -3147,7 +3152,7 @@ bool MuseScore::saveSvg(Score* score, QIODevice* device, int pageNumber, bool dr
         printer.setElement(e);
 
         // Paint it
-        paintElement(p, e);
+        paintElement(p, ri);
     }
     p.end();   // Writes MuseScore SVG file to disk, finally
 
@@ -3227,7 +3232,7 @@ bool MuseScore::saveMetadataJSON(Score* score, const QString& name)
 //          Tid specifies text style
 //          QStringList* specifies the container to keep found text
 //
-//    For usage with Score::scanElements().
+//    For usage with scanElements().
 //    Finds all text elements with specified style.
 //---------------------------------------------------------
 static void findTextByType(void* data, Element* element)
@@ -3298,7 +3303,12 @@ QJsonObject MuseScore::saveMetadataJSON(Score* score)
     json.insert("mscoreVersion", score->mscoreVersion());
     json.insert("fileVersion", score->mscVersion());
 
-    json.insert("pages", score->npages());
+    // a score read by readScoreForMetadata() is not laid out
+    int pages = score->npages();
+    if (pages == 0 && score->masterScore()->cachedPageCount() > 0) {
+        pages = score->masterScore()->cachedPageCount();
+    }
+    json.insert("pages", pages);
     json.insert("measures", score->nmeasures());
     json.insert("hasLyrics", boolToString(score->hasLyrics()));
     json.insert("hasHarmonies", boolToString(score->hasHarmonies()));
@@ -3383,7 +3393,10 @@ QJsonObject MuseScore::saveMetadataJSON(Score* score)
         QJsonArray typeData;
         QStringList typeTextStrings;
         std::pair<Tid, QStringList*> extendedTitleData = std::make_pair(nameType.second, &typeTextStrings);
-        score->scanElements(&extendedTitleData, findTextByType);
+        // walk the measures, not the pages, frames are found also if the score is not laid out
+        for (MeasureBase* mb = score->first(); mb; mb = mb->next()) {
+            mb->scanElements(&extendedTitleData, findTextByType, true);
+        }
         for (auto typeStr : typeTextStrings) {
             typeData.append(typeStr);
         }
@@ -3590,18 +3603,48 @@ bool MuseScore::exportAllMediaFiles(const QString& inFilePath, const QString& ou
     return res;
 }
 
+//---------------------------------------------------------
+//   readScoreForMetadata
+//    read an mscz without parts, images and layout, see
+//    MasterScore::loadMscMetadata(). Returns nullptr if the
+//    file has no valid cached page count, the only metadata
+//    which needs a layout.
+//---------------------------------------------------------
+
+static MasterScore* readScoreForMetadata(const QString& path)
+{
+    QFileInfo info(path);
+    if (info.suffix().toLower() != "mscz") {
+        return nullptr;
+    }
+    std::unique_ptr<MasterScore> score(new MasterScore(MScore::baseStyle()));
+    score->setName(info.completeBaseName());
+    if (score->loadMscMetadata(path) != Score::FileError::FILE_NO_ERROR || score->cachedPageCount() <= 0) {
+        return nullptr;
+    }
+    // the json reports midi programs and channels
+    for (Part* p : score->parts()) {
+        p->updateHarmonyChannels(false);
+    }
+    score->rebuildMidiMapping();
+    return score.release();
+}
+
 //---------------------------------------------------------
 //   exportScoreMetadata
 //---------------------------------------------------------
 
 bool MuseScore::exportScoreMetadata(const QString& inFilePath, const QString& outFilePath)
 {
-    std::unique_ptr<MasterScore> score(mscore->readScore(inFilePath));
+    std::unique_ptr<MasterScore> score(readScoreForMetadata(inFilePath));
     if (!score) {
-        return false;
+        score.reset(mscore->readScore(inFilePath));
+        if (!score) {
+            return false;
+        }
+        score->switchToPageMode();
     }
-
-    score->switchToPageMode();
+    QJsonObject json = mscore->saveMetadataJSON(score.get());
 
     //// JSON specification ///////////////////////////
     //jsonForMedia["metadata"] = mdJson;
@@ -3610,7 +3653,7 @@ bool MuseScore::exportScoreMetadata(const QString& inFilePath, const QString& ou
     CustomJsonWriter jsonWriter(outFilePath);
 
     //export metadata
-    QJsonDocument doc(mscore->saveMetadataJSON(score.get()));
+    QJsonDocument doc(json);
     jsonWriter.addKey("metadata");
     jsonWriter.addValue(doc.toJson(QJsonDocument::Compact), true, true);
 
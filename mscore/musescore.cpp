@@ -128,6 +128,7 @@
 #include "libmscore/icon.h"
 
 #include "audio/drivers/driver.h"
+#include "audio/drivers/nullaudio.h"
 
 #include "effects/zita1/zita.h"
 #include "effects/compressor/compressor.h"
@@ -222,6 +223,7 @@ bool exportScoreMp3 = false;
 bool exportScorePartsPdf = false;
 static bool exportTransposedScore = false;
 static QString transposeExportOptions;
+static bool headlessPlayback = false;
 
 QString mscoreGlobalShare;
 
@@ -406,6 +408,7 @@ void MuseScore::closeEvent(QCloseEvent* ev)
     }
 
     writeSessionFile(true);
+    waitForAutoSave();
     for (MasterScore* score : scoreList) {
         if (!score->tmpName().isEmpty()) {
             QFile f(score->tmpName());
@@ -436,6 +439,8 @@ void updateExternalValuesFromPreferences()
     MScore::playRepeats = preferences.getBool(PREF_APP_PLAYBACK_PLAYREPEATS);
     MScore::warnPitchRange = preferences.getBool(PREF_SCORE_NOTE_WARNPITCHRANGE);
     MScore::pedalEventsMinTicks = preferences.getInt(PREF_IO_MIDI_PEDAL_EVENTS_MIN_TICKS);
+    MScore::undoLimit = preferences.getInt(PREF_APP_UNDO_LIMIT);
+    MScore::undoMemoryLimit = preferences.getInt(PREF_APP_UNDO_MEMORYLIMIT);
     MScore::layoutBreakColor = preferences.getColor(PREF_UI_SCORE_LAYOUTBREAKCOLOR);
     MScore::frameMarginColor = preferences.getColor(PREF_UI_SCORE_FRAMEMARGINCOLOR);
     MScore::setVerticalOrientation(preferences.getBool(PREF_UI_CANVAS_SCROLL_VERTICALORIENTATION));
@@ -2065,6 +2070,8 @@ MuseScore::MuseScore()
     autoSaveTimer = new QTimer(this);
     autoSaveTimer->setSingleShot(true);
     connect(autoSaveTimer, SIGNAL(timeout()), this, SLOT(autoSaveTimerTimeout()));
+    autoSavePool = new QThreadPool(this);
+    autoSavePool->setMaxThreadCount(1);       // keeps the writes of one file in order
     initOsc();
     startAutoSave();
 
@@ -3279,7 +3286,7 @@ void MuseScore::restartAudioEngine()
     }
 
     if (seq) {
-        Driver* driver = driverFactory(seq, "");
+        Driver* driver = driverFactory(seq, audioDriver);
         if (driver) {
             // Updating synthesizer's sample rate
             if (seq->synti()) {
@@ -3560,6 +3567,7 @@ void MuseScore::removeTab(int i)
     }
     writeSessionFile(false);
     if (!tmpName.isEmpty()) {
+        waitForAutoSave();
         QFile f(tmpName);
         f.remove();
     }
@@ -4121,12 +4129,50 @@ static bool doProcessJob(QString jsonFile)
     return true;
 }
 
+//---------------------------------------------------------
+//   playHeadless
+//    play the score to the end on the null or clock audio
+//    driver and print the callback timing as JSON
+//---------------------------------------------------------
+
+static bool playHeadless(const QString& inFile)
+{
+    NullAudio* driver = seq ? dynamic_cast<NullAudio*>(seq->driver()) : nullptr;
+    if (!driver || !seq->isRunning()) {
+        fprintf(stderr, "headless playback needs the null or clock audio driver\n");
+        return false;
+    }
+    MasterScore* score = mscore->readScore(inFile);
+    if (!score) {
+        return false;
+    }
+    int index = mscore->appendScore(score);
+    mscore->setCurrentView(index, 0);       // also sets the score view of the sequencer
+
+    seq->start();
+    while (driver->getState() == Transport::PLAY || seq->isPlaying()) {
+        QThread::msleep(10);
+        qApp->processEvents();
+    }
+
+    mscore->closeScore(score);
+    driver->stop();                         // stats are only valid while stopped
+    const NullAudioStats& stats = driver->stats();
+    QJsonObject o = stats.toJson(driver->sampleRate(), driver->bufferSize());
+    o["clock"] = QString(audioDriver.toLower() == "clock" ? "realtime" : "simulated");
+    printf("%s", QJsonDocument(o).toJson().constData());
+    return stats.callbacks > 0;
+}
+
 //---------------------------------------------------------
 //   processNonGui
 //---------------------------------------------------------
 
 static bool processNonGui(const QStringList& argv)
 {
+    if (headlessPlayback) {
+        return playHeadless(argv.value(0));
+    }
     if (exportScoreMedia) {
         return mscore->exportAllMediaFiles(argv[0]);
     }
@@ -5551,6 +5597,26 @@ void MuseScore::removeSessionFile()
     }
 }
 
+//---------------------------------------------------------
+//   writeAutoSaveFile
+//    runs in a worker thread; the file is replaced
+//    atomically so a crash never leaves a broken backup
+//---------------------------------------------------------
+
+static void writeAutoSaveFile(const QString& path, const MsczEntries& entries)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    if (!Score::writeMscz(&buffer, entries, 1)) {         // fastest compression for backups
+        qDebug("autosave: cannot compress <%s>", qPrintable(path));
+        return;
+    }
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly) || f.write(buffer.data()) != buffer.data().size() || !f.commit()) {
+        qDebug("autosave: cannot write <%s>: %s", qPrintable(path), qPrintable(f.errorString()));
+    }
+}
+
 //---------------------------------------------------------
 //   autoSaveTimerTimeout
 //---------------------------------------------------------
@@ -5565,11 +5631,7 @@ void MuseScore::autoSaveTimerTimeout()
         if (s->autosaveDirty()) {
             qDebug("<%s>", qPrintable(s->fileInfo()->completeBaseName()));
             QString tmp = s->tmpName();
-            if (!tmp.isEmpty()) {
-                QFileInfo fi(tmp);
-                // TODO: cannot catch exception here:
-                s->saveCompressedFile(fi, false, false);         // no thumbnail
-            } else {
+            if (tmp.isEmpty()) {
                 QDir dir;
                 dir.mkpath(dataPath);
                 QTemporaryFile tf(dataPath + "/scXXXXXX.mscz");
@@ -5578,12 +5640,18 @@ void MuseScore::autoSaveTimerTimeout()
                     qDebug("autoSaveTimerTimeout(): create temporary file failed");
                     return;
                 }
-                s->setTmpName(tf.fileName());
-                QFileInfo info(tf.fileName());
-                s->saveCompressedFile(&tf, info, false, false);          // no thumbnail
+                tmp = tf.fileName();
                 tf.close();
+                s->setTmpName(tmp);
                 sessionChanged = true;
             }
+            // only serializing needs the score, compressing and
+            // writing are done in the background
+            MsczEntries entries;
+            // TODO: cannot catch exception here:
+            if (s->msczEntries(entries, QFileInfo(tmp), false, false)) {         // no thumbnail
+                QtConcurrent::run(autoSavePool, writeAutoSaveFile, tmp, entries);
+            }
             s->setAutosaveDirty(false);
         }
     }
@@ -5596,6 +5664,16 @@ void MuseScore::autoSaveTimerTimeout()
     }
 }
 
+//---------------------------------------------------------
+//   waitForAutoSave
+//    wait until pending autosave files are written
+//---------------------------------------------------------
+
+void MuseScore::waitForAutoSave()
+{
+    autoSavePool->waitForDone();
+}
+
 class CallOnReturn
 {
     std::function<void()> f;
@@ -6111,7 +6189,9 @@ void MuseScore::selectElementDialog(Element* e)
             if (sd.isInSelection()) {
                 score->scanElementsInRange(&pattern, Score::collectNoteMatch);
             } else {
-                score->scanElements(&pattern, Score::collectNoteMatch);
+                for (Element* ee : score->elements(ElementType::NOTE)) {
+                    Score::collectNoteMatch(&pattern, ee);
+                }
             }
 
             if (sd.doReplace()) {
@@ -6146,7 +6226,9 @@ void MuseScore::selectElementDialog(Element* e)
             if (sd.isInSelection()) {
                 score->scanElementsInRange(&pattern, Score::collectMatch);
             } else {
-                score->scanElements(&pattern, Score::collectMatch);
+                for (Element* ee : score->elements(ElementType(pattern.type))) {
+                    Score::collectMatch(&pattern, ee);
+                }
             }
 
             if (sd.doReplace()) {
@@ -7991,7 +8073,7 @@ MuseScoreApplication::CommandLineParseResult MuseScoreApplication::parseCommandL
     parser.addOption(QCommandLineOption({ "L", "layout-debug" }, "Layout debug mode"));
     parser.addOption(QCommandLineOption({ "s", "no-synthesizer" }, "No internal synthesizer"));
     parser.addOption(QCommandLineOption({ "m", "no-midi" }, "No MIDI"));
-    parser.addOption(QCommandLineOption({ "a", "use-audio" }, "Use audio driver: jack, alsa, pulse, or portaudio",
+    parser.addOption(QCommandLineOption({ "a", "use-audio" }, "Use audio driver: jack, alsa, pulse, portaudio, null or clock",
                                         "driver"));
     parser.addOption(QCommandLineOption({ "n", "new-score" }, "Start with new score"));
     parser.addOption(QCommandLineOption({ "I", "dump-midi-in" }, "Dump midi input"));
@@ -8039,6 +8121,8 @@ MuseScoreApplication::CommandLineParseResult MuseScoreApplication::parseCommandL
     parser.addOption(QCommandLineOption("score-transpose",
                                         "Transpose the given score and export the data to a single JSON file, print it to stdout",
                                         "options"));
+    parser.addOption(QCommandLineOption("headless-playback",
+                                        "Play the given score to the end on the null or clock audio driver ('-a null' if none given), print the callback timing as JSON to stdout and exit"));
     parser.addOption(QCommandLineOption("raw-diff", "Print a raw diff for the given scores"));
     parser.addOption(QCommandLineOption("diff", "Print a diff for the given scores"));
 
@@ -8225,6 +8309,17 @@ MuseScoreApplication::CommandLineParseResult MuseScoreApplication::parseCommandL
         converterMode = true;
     }
 
+    if (parser.isSet("headless-playback")) {
+        if (audioDriver.isEmpty()) {
+            audioDriver = "null";
+        } else if (audioDriver.toLower() != "null" && audioDriver.toLower() != "clock") {
+            fprintf(stderr, "headless playback needs '-a null' or '-a clock'\n");
+            parser.showHelp(EXIT_FAILURE);
+        }
+        MScore::noGui = true;
+        noSeq = false;
+        headlessPlayback = true;
+    }
     if (parser.isSet("raw-diff")) {
         MScore::noGui = true;
         rawDiffMode = true;
@@ -8492,7 +8587,7 @@ void MuseScore::init(QStringList& argv)
         MuseScore::updateUiStyleAndTheme();
     } else {
         genIcons();     // in GUI mode generated in updateUiStyleAndTheme()
-        noSeq = true;
+        noSeq = !headlessPlayback;      // headless playback runs on the null audio driver
     }
 
     // Do not create sequencer and audio drivers if run with '-s'
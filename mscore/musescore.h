@@ -327,6 +327,7 @@ class MuseScore : public QMainWindow, public MuseScoreCore, public mu::framework
 #endif
 
     QTimer* autoSaveTimer;
+    QThreadPool* autoSavePool;
     QList<QAction*> pluginActions;
 
     PianorollEditor* pianorollEditor   { 0 };
@@ -603,6 +604,7 @@ public:
     bool loadPlugin(const QString& filename);
     QString createDefaultName() const;
     void startAutoSave();
+    void waitForAutoSave();
     double getMag(ScoreView*) const;
     void setMag(double);
     bool noScore() const { return scoreList.isEmpty(); }
@@ -125,6 +125,11 @@ Navigator::Navigator(NScrollArea* sa, QWidget* parent)
     sa->setWidget(this);
     sa->setWidgetResizable(false);
     _previewOnly = false;
+    _thumbnailScale = 0.0;
+    _thumbnailTimer = new QTimer(this);
+    _thumbnailTimer->setSingleShot(true);
+    _thumbnailTimer->setInterval(0);
+    connect(_thumbnailTimer, &QTimer::timeout, this, &Navigator::renderNextThumbnail);
 }
 
 //---------------------------------------------------------
@@ -150,6 +155,7 @@ void Navigator::setScoreView(ScoreView* v)
         disconnect(_cv, SIGNAL(viewRectChanged()), this, SLOT(updateViewRect()));
     }
     _cv = QPointer<ScoreView>(v);
+    _thumbnails.clear();
     if (v) {
         _score  = v->score();
         rescale();
@@ -174,6 +180,7 @@ void Navigator::setScore(Score* v)
 {
     setScoreView(nullptr);   // ensure all connections to ScoreView get disconnected
     _score = v;
+    invalidateThumbnails(true);
     rescale();
     updateViewRect();
     update();
@@ -213,6 +220,12 @@ void Navigator::rescale()
         setFixedWidth(int(scoreWidth * m));
         matrix = QTransform(m, 0, 0, m, 0, 0);
     }
+
+    qreal scale = matrix.m11() * devicePixelRatioF();
+    if (scale != _thumbnailScale) {
+        _thumbnailScale = scale;
+        invalidateThumbnails(true);
+    }
 }
 
 //---------------------------------------------------------
@@ -339,9 +352,157 @@ void Navigator::layoutChanged()
     if (_score && !_score->pages().isEmpty()) {
         rescale();
     }
+    invalidateThumbnails(false);
     update();
 }
 
+//---------------------------------------------------------
+//   pagePos
+//---------------------------------------------------------
+
+QPointF Navigator::pagePos(Page* page, int idx) const
+{
+    if (_previewOnly) {
+        return QPointF(idx * page->width(), 0);
+    }
+    return page->pos();
+}
+
+//---------------------------------------------------------
+//   pageLayoutKey
+//    changes whenever systems are added to, removed from
+//    or moved on the page
+//---------------------------------------------------------
+
+QString Navigator::pageLayoutKey(Page* page) const
+{
+    QString key = QString("%1 %2 %3 %4").arg(page->no()).arg(_score->pages().size())
+                  .arg(page->bbox().width()).arg(page->bbox().height());
+    for (System* s : page->systems()) {
+        key += QString(" %1:%2,%3").arg(quintptr(s)).arg(s->pos().x()).arg(s->pos().y());
+        if (!s->measures().empty()) {
+            key += QString(",%1-%2").arg(s->measures().front()->tick().ticks()).arg(s->endTick().ticks());
+        }
+    }
+    return key;
+}
+
+//---------------------------------------------------------
+//   invalidateThumbnails
+//    mark the pages touched by the last layout; outside of
+//    a command the changed range is unknown and all pages
+//    are painted again
+//---------------------------------------------------------
+
+void Navigator::invalidateThumbnails(bool all)
+{
+    if (!_score) {
+        _thumbnails.clear();
+        return;
+    }
+    const CmdState& cmdState = _score->cmdState();
+    Fraction startTick = cmdState.startTick();
+    Fraction endTick = cmdState.endTick();
+    if (!cmdState.layoutRange() || startTick < Fraction(0, 1)) {
+        all = true;
+    }
+
+    QHash<Page*, PageThumbnail> thumbnails;
+    for (Page* page : _score->pages()) {
+        PageThumbnail thumbnail = _thumbnails.value(page);
+        QString layoutKey = pageLayoutKey(page);
+        if (all || thumbnail.layoutKey != layoutKey) {
+            thumbnail.valid = false;
+        } else {
+            for (System* s : page->systems()) {
+                if (!s->measures().empty() && s->measures().front()->tick() <= endTick && s->endTick() >= startTick) {
+                    thumbnail.valid = false;
+                    break;
+                }
+            }
+        }
+        thumbnail.layoutKey = layoutKey;
+        thumbnails.insert(page, thumbnail);
+    }
+    _thumbnails = thumbnails;
+    _thumbnailTimer->start();
+}
+
+//---------------------------------------------------------
+//   renderThumbnail
+//---------------------------------------------------------
+
+QImage Navigator::renderThumbnail(Page* page, qreal scale) const
+{
+    QRectF r(page->bbox());
+    QImage image(int(ceil(r.width() * scale)), int(ceil(r.height() * scale)), QImage::Format_ARGB32_Premultiplied);
+    if (image.isNull()) {
+        return image;
+    }
+    int dpm = lrint(DPMM * 1000.0);
+    image.setDotsPerMeterX(dpm);
+    image.setDotsPerMeterY(dpm);
+    image.fill(0xffffffff);
+
+    double pr = MScore::pixelRatio;
+    MScore::pixelRatio = 1.0;
+
+    QPainter p(&image);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setRenderHint(QPainter::TextAntialiasing, true);
+    p.scale(scale, scale);
+    p.translate(-r.topLeft());
+    for (System* s : page->systems()) {
+        for (MeasureBase* m : s->measures()) {
+            m->scanElements(&p, paintElement, false);
+        }
+    }
+    page->scanElements(&p, paintElement, false);
+    p.end();
+
+    MScore::pixelRatio = pr;
+    return image;
+}
+
+//---------------------------------------------------------
+//   renderNextThumbnail
+//    paint one outdated page, visible pages first; the
+//    timer brings us back for the next one so the ui
+//    stays responsive
+//---------------------------------------------------------
+
+void Navigator::renderNextThumbnail()
+{
+    if (!_score || !isVisible() || _thumbnailScale <= 0.0) {
+        return;
+    }
+    QRectF visible = matrix.inverted().mapRect(QRectF(visibleRegion().boundingRect()));
+    const QList<Page*>& pages = _score->pages();
+    int next = -1;
+    for (int i = 0; i < pages.size(); ++i) {
+        if (_thumbnails.value(pages[i]).valid) {
+            continue;
+        }
+        if (next == -1) {
+            next = i;
+        }
+        if (pages[i]->abbox().translated(pagePos(pages[i], i)).intersects(visible)) {
+            next = i;
+            break;
+        }
+    }
+    if (next == -1) {
+        return;
+    }
+
+    Page* page = pages[next];
+    PageThumbnail& thumbnail = _thumbnails[page];
+    thumbnail.image = renderThumbnail(page, _thumbnailScale);
+    thumbnail.valid = true;
+    update(matrix.mapRect(page->abbox().translated(pagePos(page, next))).toAlignedRect());
+    _thumbnailTimer->start();
+}
+
 //---------------------------------------------------------
 //   paintEvent
 //---------------------------------------------------------
@@ -373,13 +534,12 @@ void Navigator::paintEvent(QPaintEvent* ev)
     font.setPointSizeF(font.pointSizeF() * factor);
 
     p.setTransform(matrix);
+    p.setRenderHint(QPainter::SmoothPixmapTransform, true);
     QRectF fr = matrix.inverted().mapRect(QRectF(r));
-    int i = 0;
-    for (Page* page : _score->pages()) {
-        QPointF pos(page->pos());
-        if (_previewOnly) {
-            pos = QPointF(i * page->width(), 0);
-        }
+    const QList<Page*>& pages = _score->pages();
+    for (int i = 0; i < pages.size(); ++i) {
+        Page* page = pages[i];
+        QPointF pos(pagePos(page, i));
         QRectF pr(page->abbox().translated(pos));
         if (pr.right() < fr.left()) {
             continue;
@@ -388,21 +548,29 @@ void Navigator::paintEvent(QPaintEvent* ev)
             break;
         }
 
-        p.fillRect(pr, Qt::white);
+        const PageThumbnail thumbnail = _thumbnails.value(page);
+        if (!thumbnail.valid && !_thumbnailTimer->isActive()) {
+            _thumbnailTimer->start();
+        }
         p.translate(pos);
-        for (System* s  : page->systems()) {
-            for (MeasureBase* m : s->measures()) {
-                m->scanElements(&p, paintElement, false);
+        if (!thumbnail.image.isNull()) {
+            // may still be the image of an older layout or scale until the timer catches up
+            p.drawImage(page->bbox(), thumbnail.image);
+        } else {
+            p.fillRect(page->bbox(), Qt::white);
+            for (System* s  : page->systems()) {
+                for (MeasureBase* m : s->measures()) {
+                    m->scanElements(&p, paintElement, false);
+                }
             }
+            page->scanElements(&p, paintElement, false);
         }
-        page->scanElements(&p, paintElement, false);
         if (page->score()->layoutMode() == LayoutMode::PAGE) {
             p.setFont(font);
             p.setPen(MScore::layoutBreakColor);
             p.drawText(page->bbox(), Qt::AlignCenter, QString("%1").arg(page->no() + 1 + _score->pageNumberOffset()));
         }
         p.translate(-pos);
-        i++;
     }
 }
 }
@@ -56,6 +56,17 @@ public:
     ViewRect(QWidget* w = 0);
 };
 
+//---------------------------------------------------------
+//   PageThumbnail
+//    a page rasterized at navigator scale
+//---------------------------------------------------------
+
+struct PageThumbnail {
+    QImage image;
+    QString layoutKey;          // systems and geometry the page had when last checked
+    bool valid { false };       // image is up to date
+};
+
 //---------------------------------------------------------
 //   Navigator
 //---------------------------------------------------------
@@ -73,13 +84,24 @@ class Navigator : public QWidget
     QTransform matrix;
     bool _previewOnly;
 
+    QHash<Page*, PageThumbnail> _thumbnails;
+    qreal _thumbnailScale;
+    QTimer* _thumbnailTimer;
+
     void rescale();
+    QPointF pagePos(Page* page, int idx) const;
+    QString pageLayoutKey(Page* page) const;
+    QImage renderThumbnail(Page* page, qreal scale) const;
+    void invalidateThumbnails(bool all);
 
     virtual void paintEvent(QPaintEvent*);
     virtual void mousePressEvent(QMouseEvent*);
     virtual void mouseMoveEvent(QMouseEvent*);
     virtual void resizeEvent(QResizeEvent*);
 
+private slots:
+    void renderNextThumbnail();
+
 public slots:
     void updateViewRect();
     void layoutChanged();
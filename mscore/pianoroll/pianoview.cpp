@@ -171,6 +171,25 @@ bool PianoItem::intersects(int startTick, int endTick, int highPitch, int lowPit
     }
 }
 
+//---------------------------------------------------------
+//   updateExtent
+//    has to be called whenever the note may have changed
+//---------------------------------------------------------
+
+void PianoItem::updateExtent()
+{
+    QRect r = boundingRectTicks(0);
+    if (_pianoView->playEventsView()) {
+        for (NoteEvent& e : _note->playEvents()) {
+            r |= boundingRectTicks(&e);
+        }
+    }
+    _startTick = r.left();
+    _endTick   = r.right();
+    _lowPitch  = r.top();
+    _highPitch = r.bottom();
+}
+
 //---------------------------------------------------------
 //   getTweakNoteEvent
 //---------------------------------------------------------
@@ -307,6 +326,7 @@ PianoView::PianoView()
     _inProgressUndoEvent = false;
 
     memset(_pitchHighlight, 0, 128);
+    _gridTiles.setMaxCost(GRID_TILE_CACHE_SIZE);
 }
 
 //---------------------------------------------------------
@@ -319,77 +339,129 @@ PianoView::~PianoView()
 }
 
 //---------------------------------------------------------
-//   drawBackground
+//   PianoGridColors
 //---------------------------------------------------------
 
-void PianoView::drawBackground(QPainter* p, const QRectF& r)
-{
-    if (_staff == 0) {
-        return;
-    }
-    Score* _score = _staff->score();
-    setFrameShape(QFrame::NoFrame);
-
-    QColor colSelectionBox;
-
-    QColor colWhiteKeyBg;
-    QColor colGutter;
-    QColor colBlackKeyBg;
-    QColor colHilightKeyBg;
-
-    QColor colGridLine;
+struct PianoGridColors {
+    QColor whiteKeyBg;
+    QColor gutter;
+    QColor blackKeyBg;
+    QColor highlightKeyBg;
+    QColor gridLine;
+};
 
+static PianoGridColors pianoGridColors()
+{
+    PianoGridColors c;
     switch (preferences.globalStyle()) {
     case MuseScoreStyleType::DARK_FUSION:
-        colSelectionBox = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_SELECTION_BOX_COLOR));
-
-        colHilightKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_HIGHLIGHT_COLOR));
-        colWhiteKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_WHITE_COLOR));
-        colGutter = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_BASE_COLOR));
-        colBlackKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_BLACK_COLOR));
+        c.highlightKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_HIGHLIGHT_COLOR));
+        c.whiteKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_WHITE_COLOR));
+        c.gutter = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_BASE_COLOR));
+        c.blackKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_KEY_BLACK_COLOR));
 
-        colGridLine = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_GRIDLINE_COLOR));
+        c.gridLine = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_BG_GRIDLINE_COLOR));
         break;
     default:
-        colSelectionBox = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_SELECTION_BOX_COLOR));
-
-        colHilightKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_HIGHLIGHT_COLOR));
-        colWhiteKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_WHITE_COLOR));
-        colGutter = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_BASE_COLOR));
-        colBlackKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_BLACK_COLOR));
+        c.highlightKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_HIGHLIGHT_COLOR));
+        c.whiteKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_WHITE_COLOR));
+        c.gutter = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_BASE_COLOR));
+        c.blackKeyBg = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_KEY_BLACK_COLOR));
 
-        colGridLine = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_GRIDLINE_COLOR));
+        c.gridLine = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_BG_GRIDLINE_COLOR));
         break;
     }
+    return c;
+}
 
-    const QColor colSelectionBoxFill = QColor(
-        colSelectionBox.red(), colSelectionBox.green(), colSelectionBox.blue(),
-        128);
+//---------------------------------------------------------
+//   gridKey
+//    hash of everything the grid tiles depend on, except
+//    the tempo and time signature maps; tiles are dropped
+//    in updateNotes() for those
+//---------------------------------------------------------
+
+uint PianoView::gridKey() const
+{
+    const PianoGridColors c = pianoGridColors();
+    uint h = qHash(_xZoom);
+    h = qHash(_noteHeight, h);
+    h = qHash(_barPattern, h);
+    h = qHash(_tuplet, h);
+    h = qHash(_subdiv, h);
+    h = qHash(_ticks, h);
+    h = qHash(_staff->part()->instrument()->transpose().chromatic, h);
+    h = qHash(QByteArray::fromRawData(reinterpret_cast<const char*>(_pitchHighlight), 128), h);
+    for (const QColor& color : { c.whiteKeyBg, c.gutter, c.blackKeyBg, c.highlightKeyBg, c.gridLine }) {
+        h = qHash(color.rgba(), h);
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   gridTile
+//    returns the grid of the scene area
+//    (col, row) * GRID_TILE_SIZE
+//---------------------------------------------------------
+
+QPixmap PianoView::gridTile(int col, int row, qreal dpr)
+{
+    const quint64 key = (quint64(quint32(col)) << 32) | quint32(row);
+    if (QPixmap* tile = _gridTiles.object(key)) {
+        return *tile;
+    }
+
+    QPixmap* tile = new QPixmap(QSize(GRID_TILE_SIZE, GRID_TILE_SIZE) * dpr);
+    tile->setDevicePixelRatio(dpr);
+    const QRectF r(col * GRID_TILE_SIZE, row * GRID_TILE_SIZE, GRID_TILE_SIZE, GRID_TILE_SIZE);
+    QPainter p(tile);
+    p.translate(-r.topLeft());
+    p.setClipRect(r);
+    drawGrid(&p, r);
+    p.end();
+
+    QPixmap pm = *tile;
+    _gridTiles.insert(key, tile);
+    return pm;
+}
+
+//---------------------------------------------------------
+//   drawGrid
+//    draw key rows, bar and beat lines
+//---------------------------------------------------------
+
+void PianoView::drawGrid(QPainter* p, const QRectF& r)
+{
+    Score* _score = _staff->score();
+    const PianoGridColors colors = pianoGridColors();
 
-    const QPen penLineMajor = QPen(colGridLine, 2.0, Qt::SolidLine);
-    const QPen penLineMinor = QPen(colGridLine, 1.0, Qt::SolidLine);
-    const QPen penLineSub = QPen(colGridLine, 1.0, Qt::DotLine);
+    const QPen penLineMajor = QPen(colors.gridLine, 2.0, Qt::SolidLine);
+    const QPen penLineMinor = QPen(colors.gridLine, 1.0, Qt::SolidLine);
+    const QPen penLineSub = QPen(colors.gridLine, 1.0, Qt::DotLine);
 
     QRectF r1;
     r1.setCoords(-1000000.0, 0.0, tickToPixelX(0), 1000000.0);
     QRectF r2;
     r2.setCoords(tickToPixelX(_ticks), 0.0, 1000000.0, 1000000.0);
 
-    p->fillRect(r, colWhiteKeyBg);
+    p->fillRect(r, colors.whiteKeyBg);
     if (r.intersects(r1)) {
-        p->fillRect(r.intersected(r1), colGutter);
+        p->fillRect(r.intersected(r1), colors.gutter);
     }
     if (r.intersects(r2)) {
-        p->fillRect(r.intersected(r2), colGutter);
+        p->fillRect(r.intersected(r2), colors.gutter);
     }
 
+    // include lines just outside of r, they are wider than one pixel
+    const QRectF lr = r.adjusted(-2.0, -2.0, 2.0, 2.0);
+
     //
     // draw horizontal grid lines
     //
-    qreal y1 = r.y();
-    qreal y2 = y1 + r.height();
-    qreal x1 = qMax(r.x(), (qreal)tickToPixelX(0));
-    qreal x2 = qMin(x1 + r.width(), (qreal)tickToPixelX(_ticks));
+    qreal y1 = lr.y();
+    qreal y2 = y1 + lr.height();
+    qreal x1 = qMax(lr.x(), (qreal)tickToPixelX(0));
+    qreal x2 = qMin(x1 + lr.width(), (qreal)tickToPixelX(_ticks));
 
     int topPitch = ceil((_noteHeight * 128 - y1) / _noteHeight);
     int bmPitch = floor((_noteHeight * 128 - y2) / _noteHeight);
@@ -398,20 +470,20 @@ void PianoView::drawBackground(QPainter* p, const QRectF& r)
     Interval transp = part->instrument()->transpose();
 
     //MIDI notes span [0, 127] and map to pitches starting at C-1
-    for (int pitch = bmPitch; pitch <= topPitch; ++pitch) {
+    for (int pitch = qMax(bmPitch, 0); pitch <= qMin(topPitch, 127); ++pitch) {
         int y = (127 - pitch) * _noteHeight;
 
         int degree = (pitch - transp.chromatic + 60) % 12;
         const BarPattern& pat = barPatterns[_barPattern];
 
         if (!pat.isWhiteKey[degree] || _pitchHighlight[pitch]) {
-            qreal px0 = qMax(r.x(), (qreal)tickToPixelX(0));
-            qreal px1 = qMin(r.x() + r.width(), (qreal)tickToPixelX(_ticks));
+            qreal px0 = qMax(lr.x(), (qreal)tickToPixelX(0));
+            qreal px1 = qMin(lr.x() + lr.width(), (qreal)tickToPixelX(_ticks));
             QRectF hbar;
 
             hbar.setCoords(px0, y, px1, y + _noteHeight);
             p->fillRect(hbar,
-                        _pitchHighlight[pitch] ? colHilightKeyBg : colBlackKeyBg);
+                        _pitchHighlight[pitch] ? colors.highlightKeyBg : colors.blackKeyBg);
         }
 
         //Lines between rows
@@ -419,6 +491,10 @@ void PianoView::drawBackground(QPainter* p, const QRectF& r)
         p->drawLine(QLineF(x1, y + _noteHeight, x2, y + _noteHeight));
     }
 
+    if (x2 < x1) {
+        return;
+    }
+
     //
     // draw vertical grid lines
     //
@@ -466,10 +542,61 @@ void PianoView::drawBackground(QPainter* p, const QRectF& r)
         p->setPen(x > 0 ? penLineMajor : QPen(Qt::black, 2.0));
         p->drawLine(x, y1, x, y2);
     }
+}
 
-    //Draw notes
-    for (int i = 0; i < _noteList.size(); ++i) {
-        _noteList[i]->paint(p);
+//---------------------------------------------------------
+//   drawBackground
+//---------------------------------------------------------
+
+void PianoView::drawBackground(QPainter* p, const QRectF& r)
+{
+    if (_staff == 0) {
+        return;
+    }
+    setFrameShape(QFrame::NoFrame);
+
+    QColor colSelectionBox;
+
+    switch (preferences.globalStyle()) {
+    case MuseScoreStyleType::DARK_FUSION:
+        colSelectionBox = QColor(preferences.getColor(PREF_UI_PIANOROLL_DARK_SELECTION_BOX_COLOR));
+        break;
+    default:
+        colSelectionBox = QColor(preferences.getColor(PREF_UI_PIANOROLL_LIGHT_SELECTION_BOX_COLOR));
+        break;
+    }
+
+    const QColor colSelectionBoxFill = QColor(
+        colSelectionBox.red(), colSelectionBox.green(), colSelectionBox.blue(),
+        128);
+
+    //
+    // draw the grid from cached tiles
+    //
+    const qreal dpr = p->device()->devicePixelRatioF();
+    const uint key = qHash(dpr, gridKey());
+    if (key != _gridTilesKey) {
+        _gridTiles.clear();
+        _gridTilesKey = key;
+    }
+    const int col1 = floor(r.left() / GRID_TILE_SIZE);
+    const int col2 = floor(r.right() / GRID_TILE_SIZE);
+    const int row1 = floor(r.top() / GRID_TILE_SIZE);
+    const int row2 = floor(r.bottom() / GRID_TILE_SIZE);
+    for (int row = row1; row <= row2; ++row) {
+        for (int col = col1; col <= col2; ++col) {
+            p->drawPixmap(QPointF(col * GRID_TILE_SIZE, row * GRID_TILE_SIZE), gridTile(col, row, dpr));
+        }
+    }
+
+    qreal y1 = r.y();
+    qreal y2 = y1 + r.height();
+
+    //Draw notes, only the ones in the exposed area
+    int topPitch = ceil((_noteHeight * 128 - y1) / _noteHeight);
+    int bmPitch = floor((_noteHeight * 128 - y2) / _noteHeight);
+    for (PianoItem* item : itemsIn(pixelXToTick(r.left()) - 1, pixelXToTick(r.right()) + 1, topPitch, bmPitch)) {
+        item->paint(p);
     }
 
     if (_dragStyle == DragStyle::NOTES) {
@@ -542,7 +669,6 @@ void PianoView::zoomView(int step, bool horizontal, int centerX, int centerY)
         emit xZoomChanged(_xZoom);
 
         updateBoundingSize();
-        updateNotes();
 
         int mousePixX = tickToPixelX(mouseXTick);
         horizontalScrollBar()->setValue(mousePixX - centerX);
@@ -557,7 +683,6 @@ void PianoView::zoomView(int step, bool horizontal, int centerX, int centerY)
         emit noteHeightChanged(_noteHeight);
 
         updateBoundingSize();
-        updateNotes();
 
         int mousePixY = static_cast<int>(mouseYNote * _noteHeight);
         verticalScrollBar()->setValue(mousePixY - centerY);
@@ -1434,9 +1559,7 @@ bool PianoView::cutChordRest(ChordRest* targetCr, int track, Fraction cutTick, C
 
 PianoItem* PianoView::pickNote(int tick, int pitch)
 {
-    for (int i = 0; i < _noteList.size(); ++i) {
-        PianoItem* pi = _noteList[i];
-
+    for (PianoItem* pi : itemsIn(tick, tick, pitch, pitch)) {
         if (pi->intersects(tick, tick, pitch, pitch)) {
             return pi;
         }
@@ -1445,6 +1568,25 @@ PianoItem* PianoView::pickNote(int tick, int pitch)
     return 0;
 }
 
+//---------------------------------------------------------
+//   itemsIn
+//    returns the items whose extent intersects the
+//    given area, in _noteList order
+//---------------------------------------------------------
+
+QList<PianoItem*> PianoView::itemsIn(int startTick, int endTick, int highPitch, int lowPitch) const
+{
+    QList<PianoItem*> list;
+    auto i = std::lower_bound(_noteList.begin(), _noteList.end(), startTick - _maxItemTicks,
+                              [](const PianoItem* pi, int tick) { return pi->startTick() < tick; });
+    for (; i != _noteList.end() && (*i)->startTick() <= endTick; ++i) {
+        if ((*i)->extentIntersects(startTick, endTick, highPitch, lowPitch)) {
+            list.append(*i);
+        }
+    }
+    return list;
+}
+
 //---------------------------------------------------------
 //   selectNotes
 //---------------------------------------------------------
@@ -1455,19 +1597,20 @@ void PianoView::selectNotes(int startTick, int endTick, int lowPitch, int highPi
     //score->masterScore()->cmdState().reset();      // DEBUG: should not be necessary
     score->startCmd();
 
-    QList<PianoItem*> oldSel;
-    for (int i = 0; i < _noteList.size(); ++i) {
-        PianoItem* pi = _noteList[i];
-        if (pi->note()->selected()) {
-            oldSel.append(pi);
-        }
-    }
+    QList<PianoItem*> oldSel = getSelectedItems();
 
     Selection& selection = score->selection();
     selection.deselectAll();
 
-    for (int i = 0; i < _noteList.size(); ++i) {
-        PianoItem* pi = _noteList[i];
+    // only items in the area or selected before can end up selected
+    QList<PianoItem*> items = itemsIn(startTick, endTick, highPitch, lowPitch);
+    for (PianoItem* pi : oldSel) {
+        if (!items.contains(pi)) {
+            items.append(pi);
+        }
+    }
+
+    for (PianoItem* pi : qAsConst(items)) {
         bool inBounds = pi->intersects(startTick, endTick, highPitch, lowPitch);
 
         bool sel;
@@ -1618,45 +1761,77 @@ void PianoView::setStaff(Staff* s, Pos* l)
 //   addChord
 //---------------------------------------------------------
 
-void PianoView::addChord(Chord* chrd, int voice)
+void PianoView::addChord(Chord* chrd, QList<PianoItem*>& items)
 {
     for (Chord* c : chrd->graceNotes()) {
-        addChord(c, voice);
+        addChord(c, items);
     }
     for (Note* note : chrd->notes()) {
         if (note->tieBack()) {
             continue;
         }
-        _noteList.append(new PianoItem(note, this));
+        PianoItem*& item = _noteItems[note];
+        if (!item) {
+            item = new PianoItem(note, this);
+        }
+        item->setGeneration(_itemGeneration);
+        item->updateExtent();
+        items.append(item);
     }
 }
 
 //---------------------------------------------------------
 //   updateNotes
+//    Items of notes which are still in the staff are
+//    kept, only items of removed notes are deleted.
 //---------------------------------------------------------
 
 void PianoView::updateNotes()
 {
     scene()->blockSignals(true);    // block changeSelection()
     scene()->clearFocus();
-    scene()->clear();
-    clearNoteData();
+    _gridTiles.clear();             // time signatures may have changed
 
     int staffIdx = _staff->idx();
     if (staffIdx == -1) {
+        clearNoteData();
+        scene()->blockSignals(false);
         return;
     }
 
+    ++_itemGeneration;
+    QList<PianoItem*> items;
+    items.reserve(_noteList.size());
+
     SegmentType st = SegmentType::ChordRest;
     for (Segment* s = _staff->score()->firstSegment(st); s; s = s->next1(st)) {
         for (int voice = 0; voice < VOICES; ++voice) {
             int track = voice + staffIdx * VOICES;
             Element* e = s->element(track);
             if (e && e->isChord()) {
-                addChord(toChord(e), voice);
+                addChord(toChord(e), items);
             }
         }
     }
+
+    for (auto i = _noteItems.begin(); i != _noteItems.end();) {
+        if (i.value()->generation() != _itemGeneration) {
+            delete i.value();
+            i = _noteItems.erase(i);
+        } else {
+            ++i;
+        }
+    }
+
+    std::stable_sort(items.begin(), items.end(), [](const PianoItem* a, const PianoItem* b) {
+        return a->startTick() < b->startTick();
+    });
+    _maxItemTicks = 0;
+    for (const PianoItem* item : qAsConst(items)) {
+        _maxItemTicks = qMax(_maxItemTicks, item->endTick() - item->startTick());
+    }
+    _noteList = std::move(items);
+
     for (int i = 0; i < 3; ++i) {
         moveLocator(i);
     }
@@ -1676,6 +1851,8 @@ void PianoView::clearNoteData()
     }
 
     _noteList.clear();
+    _noteItems.clear();
+    _maxItemTicks = 0;
 }
 
 //---------------------------------------------------------
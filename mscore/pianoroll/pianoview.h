@@ -42,6 +42,10 @@ enum class DragStyle {
     NOTES
 };
 
+// the grid background is cached in tiles of GRID_TILE_SIZE pixels
+const int GRID_TILE_SIZE = 256;
+const int GRID_TILE_CACHE_SIZE = 96;
+
 struct BarPattern {
     QString name;
     char isWhiteKey[12];    //Set to 1 for white keys, 0 for black
@@ -56,6 +60,13 @@ class PianoItem
     Note* _note;
     PianoView* _pianoView;
 
+    // extent of all note blocks, in ticks and pitches
+    int _startTick { 0 };
+    int _endTick { 0 };
+    int _lowPitch { 0 };
+    int _highPitch { 0 };
+    int _generation { 0 };      // last PianoView::updateNotes() which found the note
+
     void paintNoteBlock(QPainter* painter, NoteEvent* evt);
     QRect boundingRectTicks(NoteEvent* evt);
     QRect boundingRectPixels(NoteEvent* evt);
@@ -70,6 +81,16 @@ public:
     void paint(QPainter* painter);
     bool intersects(int startTick, int endTick, int highPitch, int lowPitch);
 
+    void updateExtent();
+    int generation() const { return _generation; }
+    void setGeneration(int val) { _generation = val; }
+    int startTick() const { return _startTick; }
+    int endTick() const { return _endTick; }
+    bool extentIntersects(int startTick, int endTick, int highPitch, int lowPitch) const
+    {
+        return _endTick >= startTick && _startTick <= endTick && _highPitch >= lowPitch && _lowPitch <= highPitch;
+    }
+
     QRect boundingRect();
 
     NoteEvent* getTweakNoteEvent();
@@ -118,12 +139,22 @@ private:
     int _editNoteVoice = 0;
     PianoRollEditTool _editNoteTool = PianoRollEditTool::SELECT;
 
-    QList<PianoItem*> _noteList;
+    QList<PianoItem*> _noteList;          // sorted by PianoItem::startTick()
+    QHash<Note*, PianoItem*> _noteItems;
+    int _maxItemTicks = 0;                // longest PianoItem extent
+    int _itemGeneration = 0;
     quint8 _pitchHighlight[128];
 
+    QCache<quint64, QPixmap> _gridTiles;
+    uint _gridTilesKey = 0;
+
     virtual void drawBackground(QPainter* painter, const QRectF& rect);
+    void drawGrid(QPainter* painter, const QRectF& rect);
+    uint gridKey() const;
+    QPixmap gridTile(int col, int row, qreal dpr);
 
-    void addChord(Chord* _chord, int voice);
+    void addChord(Chord* _chord, QList<PianoItem*>& items);
+    QList<PianoItem*> itemsIn(int startTick, int endTick, int highPitch, int lowPitch) const;
     QVector<Note*> getSegmentNotes(Segment* seg, int track);
     void updateBoundingSize();
     void clearNoteData();
@@ -13,7 +13,9 @@
 #include "score.h"
 #include "cursor.h"
 #include "elements.h"
+#include "libmscore/chord.h"
 #include "libmscore/measure.h"
+#include "libmscore/note.h"
 #include "libmscore/score.h"
 #include "libmscore/segment.h"
 #include "libmscore/text.h"
@@ -32,6 +34,73 @@ Cursor* Score::newCursor()
     return new Cursor(score());
 }
 
+//---------------------------------------------------------
+//   Score::noteData
+///   Returns data about all notes in a range in one call,
+///   without creating an object for each note. Useful for
+///   plugins which analyze large scores.
+///   \param startTick first tick of the range
+///   \param endTick end of the range (exclusive), -1 for the
+///   end of the score
+///   \param startTrack first track of the range
+///   \param endTrack end track (exclusive), -1 for all tracks
+///   \returns an object with the number of notes in \p count
+///   and arrays of that length named \p tick, \p duration
+///   (actual duration of the chord in ticks), \p pitch,
+///   \p tpc, \p track, \p veloType and \p veloOffset.
+///   Notes are ordered by tick, then track, then by chord
+///   order. Grace notes are not included, like in Cursor
+///   iteration.
+//---------------------------------------------------------
+
+QVariantMap Score::noteData(int startTick, int endTick, int startTrack, int endTrack)
+{
+    if (endTrack < 0 || endTrack > score()->ntracks()) {
+        endTrack = score()->ntracks();
+    }
+    startTrack = qMax(startTrack, 0);
+
+    QVariantList tick, duration, pitch, tpc, track, veloType, veloOffset;
+    Ms::Measure* m = score()->tick2measure(Ms::Fraction::fromTicks(qMax(startTick, 0)));
+    for (Ms::Segment* s = m ? m->first(Ms::SegmentType::ChordRest) : nullptr; s; s = s->next1(Ms::SegmentType::ChordRest)) {
+        const int t = s->tick().ticks();
+        if (t < startTick) {
+            continue;
+        }
+        if (endTick >= 0 && t >= endTick) {
+            break;
+        }
+        for (int tr = startTrack; tr < endTrack; ++tr) {
+            Ms::Element* e = s->element(tr);
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            Ms::Chord* c = toChord(e);
+            const int d = c->actualTicks().ticks();
+            for (Ms::Note* n : c->notes()) {
+                tick.append(t);
+                duration.append(d);
+                pitch.append(n->pitch());
+                tpc.append(n->tpc());
+                track.append(tr);
+                veloType.append(int(n->veloType()));
+                veloOffset.append(n->veloOffset());
+            }
+        }
+    }
+
+    QVariantMap m;
+    m["count"]      = tick.size();
+    m["tick"]       = tick;
+    m["duration"]   = duration;
+    m["pitch"]      = pitch;
+    m["tpc"]        = tpc;
+    m["track"]      = track;
+    m["veloType"]   = veloType;
+    m["veloOffset"] = veloOffset;
+    return m;
+}
+
 //---------------------------------------------------------
 //   Score::addText
 ///   \brief Adds a header text to the score.
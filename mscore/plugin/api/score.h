@@ -152,6 +152,8 @@ public:
 
     Q_INVOKABLE QString extractLyrics() { return score()->extractLyrics(); }
 
+    Q_INVOKABLE QVariantMap noteData(int startTick = 0, int endTick = -1, int startTrack = 0, int endTrack = -1);
+
 //      //@ ??
 //      Q_INVOKABLE void updateRepeatList(bool expandRepeats) { score()->updateRepeatList(); } // TODO: needed?
 
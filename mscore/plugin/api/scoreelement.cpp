@@ -122,6 +122,77 @@ void ScoreElement::set(Ms::Pid pid, QVariant val)
     }
 }
 
+//---------------------------------------------------------
+//   wrapper cache
+//    Maps a score owned object and wrapper type to its
+//    wrapper. Wrappers are owned by the JavaScript engine;
+//    the cache keeps a JS reference to each of them so a
+//    cached wrapper cannot be collected while it may still
+//    be handed out. Dropping the cache only drops these
+//    references, wrappers still used by a plugin survive.
+//---------------------------------------------------------
+
+typedef QPair<const Ms::ScoreElement*, const QMetaObject*> WrapperKey;
+
+struct CachedWrapper {
+    ScoreElement* wrapper;
+    QJSValue value;
+};
+
+static QJSEngine* wrapperEngine = nullptr;
+static QHash<WrapperKey, CachedWrapper> wrapperCache;
+static const int wrapperCacheLimit = 16384;
+
+//---------------------------------------------------------
+//   setWrapperCacheEngine
+///   \cond PLUGIN_API \private \endcond
+///   Enables the wrapper cache for wrappers used with
+///   \p engine, nullptr disables it.
+//---------------------------------------------------------
+
+void setWrapperCacheEngine(QJSEngine* engine)
+{
+    wrapperCache.clear();
+    wrapperEngine = engine;
+}
+
+//---------------------------------------------------------
+//   clearWrapperCache
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+void clearWrapperCache()
+{
+    wrapperCache.clear();
+}
+
+//---------------------------------------------------------
+//   cachedWrapper
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+ScoreElement* cachedWrapper(const Ms::ScoreElement* se, const QMetaObject* type)
+{
+    auto i = wrapperCache.constFind(WrapperKey(se, type));
+    return i == wrapperCache.constEnd() ? nullptr : i.value().wrapper;
+}
+
+//---------------------------------------------------------
+//   cacheWrapper
+///   \cond PLUGIN_API \private \endcond
+//---------------------------------------------------------
+
+void cacheWrapper(const Ms::ScoreElement* se, const QMetaObject* type, ScoreElement* w)
+{
+    if (!wrapperEngine) {
+        return;
+    }
+    if (wrapperCache.size() >= wrapperCacheLimit) {
+        wrapperCache.clear();
+    }
+    wrapperCache.insert(WrapperKey(se, type), { w, wrapperEngine->newQObject(w) });
+}
+
 //---------------------------------------------------------
 //   wrap
 ///   \cond PLUGIN_API \private \endcond
@@ -92,12 +92,30 @@ public:
 ///   \relates ScoreElement
 //---------------------------------------------------------
 
+extern void setWrapperCacheEngine(QJSEngine* engine);
+extern void clearWrapperCache();
+extern ScoreElement* cachedWrapper(const Ms::ScoreElement* se, const QMetaObject* type);
+extern void cacheWrapper(const Ms::ScoreElement* se, const QMetaObject* type, ScoreElement* w);
+
 template<class Wrapper, class T>
 Wrapper* wrap(T* t, Ownership own = Ownership::SCORE)
 {
-    Wrapper* w = t ? new Wrapper(t, own) : nullptr;
+    if (!t) {
+        return nullptr;
+    }
+    // Wrappers of score owned objects are shared, so walking
+    // the same elements again does not allocate new wrappers.
+    if (own == Ownership::SCORE) {
+        if (ScoreElement* w = cachedWrapper(t, &Wrapper::staticMetaObject)) {
+            return static_cast<Wrapper*>(w);
+        }
+    }
+    Wrapper* w = new Wrapper(t, own);
     // All wrapper objects should belong to JavaScript code.
     QQmlEngine::setObjectOwnership(w, QQmlEngine::JavaScriptOwnership);
+    if (own == Ownership::SCORE) {
+        cacheWrapper(t, &Wrapper::staticMetaObject, w);
+    }
     return w;
 }
 
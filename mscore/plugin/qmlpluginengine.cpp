@@ -19,6 +19,7 @@
 
 #include "qmlpluginengine.h"
 #include "api/qmlpluginapi.h"
+#include "api/scoreelement.h"
 #include "libmscore/score.h"
 #include "musescore.h"
 
@@ -33,6 +34,16 @@ QmlPluginEngine::QmlPluginEngine(QObject* parent)
     : MsQmlEngine(parent)
 {
     PluginAPI::PluginAPI::registerQmlTypes();
+    PluginAPI::setWrapperCacheEngine(this);
+}
+
+//---------------------------------------------------------
+//   ~QmlPluginEngine
+//---------------------------------------------------------
+
+QmlPluginEngine::~QmlPluginEngine()
+{
+    PluginAPI::setWrapperCacheEngine(nullptr);
 }
 
 //---------------------------------------------------------
@@ -42,6 +53,8 @@ QmlPluginEngine::QmlPluginEngine(QObject* parent)
 void QmlPluginEngine::beginEndCmd(MuseScore* ms, bool inUndoRedo)
 {
     ++cmdCount;
+    // the command may have deleted elements whose wrappers are cached
+    PluginAPI::clearWrapperCache();
 
     if (inUndoRedo) {
         undoRedo = true;
@@ -46,6 +46,7 @@ signals:
     void endCmd(const QMap<QString, QVariant>& changes);
 public:
     QmlPluginEngine(QObject* parent = nullptr);
+    ~QmlPluginEngine();
 
     void beginEndCmd(MuseScore*, bool undoRedo);
     void endEndCmd(MuseScore*);
@@ -152,6 +152,9 @@ void Preferences::init(bool storeInMemoryOnly)
             { PREF_APP_STARTUP_TELEMETRY_ACCESS_REQUESTED,          new StringPreference("", false) },
             { PREF_APP_BACKUP_GENERATE_BACKUP,                      new BoolPreference(true) },
             { PREF_APP_BACKUP_SUBFOLDER,                            new StringPreference(".mscbackup") },
+            { PREF_APP_SAVE_COMPRESSIONLEVEL,                       new IntPreference(-1 /* zlib default, 1 is fastest */) },
+            { PREF_APP_UNDO_LIMIT,                                  new IntPreference(0 /* steps, 0 is unlimited */) },
+            { PREF_APP_UNDO_MEMORYLIMIT,                            new IntPreference(512 /* MB, 0 is unlimited */) },
             { PREF_EXPORT_AUDIO_NORMALIZE,                          new BoolPreference(true) },
             { PREF_EXPORT_AUDIO_SAMPLERATE,                         new IntPreference(44100, false) },
             { PREF_EXPORT_AUDIO_PCMRATE,                            new IntPreference(16) },
@@ -187,6 +190,8 @@ void Preferences::init(bool storeInMemoryOnly)
             { PREF_IO_MIDI_SHORTESTNOTE,                            new IntPreference(MScore::division / 4, false) },
             { PREF_IO_MIDI_SHOWCONTROLSINMIXER,                     new BoolPreference(false, false) },
             { PREF_IO_MIDI_USEREMOTECONTROL,                        new BoolPreference(false, false) },
+            { PREF_IO_NULLAUDIO_REPORTFILE,                         new StringPreference("", false) },
+            { PREF_IO_NULLAUDIO_WAVFILE,                            new StringPreference("", false) },
             { PREF_IO_OSC_PORTNUMBER,                               new IntPreference(5282, false) },
             { PREF_IO_OSC_USEREMOTECONTROL,                         new BoolPreference(false, false) },
             { PREF_IO_PORTAUDIO_DEVICE,                             new IntPreference(-1, false) },
@@ -785,6 +785,7 @@ Timeline::Timeline(TDockWidget* dockWidget, QWidget* parent)
 
     connect(verticalScrollBar(),SIGNAL(valueChanged(int)),_rowNames->verticalScrollBar(),SLOT(setValue(int)));
     connect(verticalScrollBar(),SIGNAL(valueChanged(int)),this,SLOT(handleScroll(int)));
+    connect(horizontalScrollBar(),SIGNAL(valueChanged(int)),this,SLOT(handleHorizontalScroll(int)));
     connect(_rowNames, SIGNAL(swapMeta(uint,bool)), this, SLOT(swapMeta(uint,bool)));
     connect(this, SIGNAL(moved(QPointF)), _rowNames, SLOT(mouseOver(QPointF)));
 
@@ -979,49 +980,29 @@ void Timeline::drawGrid(int globalRows, int globalCols)
 {
     scene()->clear();
     _metaRows.clear();
+    _columns.clear();
+    _measureColumns.clear();
+    _selectionPathItem = nullptr;
+    std::get<0>(_oldHoverInfo) = nullptr;
+    std::get<1>(_oldHoverInfo) = -1;
 
     if (globalRows == 0 || globalCols == 0) {
         return;
     }
-    int stagger = 0;
     unsigned numMetas = nmetas();
     setMinimumHeight(_gridHeight * (numMetas + 1) + 5 + horizontalScrollBar()->height());
     setMinimumWidth(_gridWidth * 3);
     _globalZValue = 1;
 
-    // Draw grid
-    Measure* currMeasure = _score->firstMeasure();
-    QList<Part*> partList = getParts();
-    for (int col = 0; col < globalCols; col++) {
-        for (int row = 0; row < globalRows; row++) {
-            QGraphicsRectItem* graphicsRectItem = new QGraphicsRectItem(col * _gridWidth,
-                                                                        _gridHeight * (row + numMetas) + 3,
-                                                                        _gridWidth,
-                                                                        _gridHeight);
-
-            setMetaData(graphicsRectItem, row, ElementType::INVALID, currMeasure, false, 0);
-
-            QString translateMeasure = tr("Measure");
-            QChar initialLetter = translateMeasure[0];
-            QTextDocument doc;
-            QString partName = "";
-            if (partList.size() > row) {
-                doc.setHtml(partList.at(row)->longName());
-                partName = doc.toPlainText();
-            }
-            if (partName.isEmpty() && partList.size() > row) {
-                partName = partList.at(row)->instrumentName();
-            }
-
-            graphicsRectItem->setToolTip(initialLetter + QString(" ") + QString::number(currMeasure->no() + 1) + QString(
-                                             ", ") + partName);
-            graphicsRectItem->setPen(QPen(activeTheme().backgroundColor));
-            graphicsRectItem->setBrush(QBrush(colorBox(graphicsRectItem)));
-            graphicsRectItem->setZValue(-3);
-            scene()->addItem(graphicsRectItem);
-        }
-
-        currMeasure = currMeasure->nextMeasure();
+    // Grid cells are painted in drawBackground(), only remember
+    // what every cell has to look like
+    _columns.resize(globalCols);
+    int col = 0;
+    for (Measure* measure = _score->firstMeasure(); measure && col < globalCols; measure = measure->nextMeasure()) {
+        _columns[col].measure = measure;
+        _measureColumns.insert(measure, col);
+        updateColumnCells(col);
+        col++;
     }
     setSceneRect(0, 0, getWidth(), getHeight());
 
@@ -1052,89 +1033,374 @@ void Timeline::drawGrid(int globalRows, int globalCols)
         _metaRows.push_back(pairGraphicsIntMeta);
     }
 
-    int xPos = 0;
+    updateMetaColumns();
+    drawSelection();
 
-    // Create stagger array if _collapsedMeta is false
-#if (!defined (_MSCVER) && !defined (_MSC_VER))
-    int staggerArr[numMetas];
-    for (unsigned row = 0; row < numMetas; row++) {
-        staggerArr[row] = 0;
+    _gridKey = gridKey();
+    _gridDirty = false;
+}
+
+//---------------------------------------------------------
+//   Timeline::buildColumnMeta
+//    create the meta values of one measure
+//---------------------------------------------------------
+
+void Timeline::buildColumnMeta(int col)
+{
+    TimelineColumn& column = _columns[col];
+    if (column.metaBuilt) {
+        return;
     }
-#else
-    // MSVC does not support VLA. Replace with std::vector. If profiling determines that the
-    // heap allocation is slow, an optimization might be used.
-    std::vector<int> staggerArr(numMetas, 0);    // Default initialized, loop not required
-#endif
+    column.metaBuilt = true;
 
-    bool noKey = true;
+    unsigned numMetas = nmetas();
+    int xPos = col * _gridWidth;
+    int stagger = 0;
+    std::vector<int> staggerArr(numMetas, 0);
+
+    std::get<0>(_repeatInfo) = 0;
     std::get<4>(_repeatInfo) = false;
+    _globalMeasureNumber = -1;
 
-    for (Measure* cm = _score->firstMeasure(); cm; cm = cm->nextMeasure()) {
-        for (Segment* currSeg = cm->first(); currSeg; currSeg = currSeg->next()) {
-            // Toggle noKey if initial key signature is found
-            if (currSeg->isKeySigType() && cm == _score->firstMeasure()) {
-                if (noKey && currSeg->tick().isZero()) {
-                    noKey = false;
-                }
-            }
+    // The meta functions append to _metaRows, move the new items to the column
+    size_t firstItem = _metaRows.size();
 
-            // If no initial key signature is found, add key signature
-            if (cm == _score->firstMeasure() && noKey
-                && (currSeg->isTimeSigType() || currSeg->isChordRestType())) {
-                if (getMetaRow(tr("Key Signature")) != numMetas) {
-                    if (_collapsedMeta) {
-                        keyMeta(0, &stagger, xPos);
-                    } else {
-                        keyMeta(0, &staggerArr[getMetaRow(tr("Key Signature"))], xPos);
-                    }
-                }
-                noKey = false;
-            }
-            int row = 0;
-            for (auto it = _metas.begin(); it != _metas.end(); ++it) {
-                std::tuple<QString, void (Timeline::*)(Segment*, int*, int), bool> meta = *it;
-                if (!std::get<2>(meta)) {
-                    continue;
-                }
-                void (Timeline::* func)(Segment*, int*, int) = std::get<1>(meta);
+    Measure* cm = column.measure;
+    bool noKey = cm == _score->firstMeasure();
+    for (Segment* currSeg = cm->first(); currSeg; currSeg = currSeg->next()) {
+        // Toggle noKey if initial key signature is found
+        if (currSeg->isKeySigType() && noKey && currSeg->tick().isZero()) {
+            noKey = false;
+        }
+
+        // If no initial key signature is found, add key signature
+        if (noKey && (currSeg->isTimeSigType() || currSeg->isChordRestType())) {
+            if (getMetaRow(tr("Key Signature")) != numMetas) {
                 if (_collapsedMeta) {
-                    (this->*func)(currSeg, &stagger, xPos);
+                    keyMeta(0, &stagger, xPos);
                 } else {
-                    (this->*func)(currSeg, &staggerArr[row], xPos);
+                    keyMeta(0, &staggerArr[getMetaRow(tr("Key Signature"))], xPos);
                 }
-                row++;
             }
+            noKey = false;
         }
-        // Handle all jumps here
-        if (getMetaRow(tr("Jumps and Markers")) != numMetas) {
-            ElementList measureElementsList = cm->el();
-            for (Element* element : measureElementsList) {
-                std::get<3>(_repeatInfo) = element;
-                if (element->isMarker()) {
-                    jumpMarkerMeta(0, &stagger, xPos);
-                }
+        int row = 0;
+        for (auto it = _metas.begin(); it != _metas.end(); ++it) {
+            std::tuple<QString, void (Timeline::*)(Segment*, int*, int), bool> meta = *it;
+            if (!std::get<2>(meta)) {
+                continue;
             }
-            for (Element* element : measureElementsList) {
-                if (element->isJump()) {
-                    std::get<2>(_repeatInfo) = element;
-                    if (_collapsedMeta) {
-                        jumpMarkerMeta(0, &stagger, xPos);
-                    } else {
-                        jumpMarkerMeta(0, &std::get<0>(_repeatInfo), xPos);
-                    }
+            void (Timeline::* func)(Segment*, int*, int) = std::get<1>(meta);
+            if (_collapsedMeta) {
+                (this->*func)(currSeg, &stagger, xPos);
+            } else {
+                (this->*func)(currSeg, &staggerArr[row], xPos);
+            }
+            row++;
+        }
+    }
+    // Handle all jumps here
+    if (getMetaRow(tr("Jumps and Markers")) != numMetas) {
+        ElementList measureElementsList = cm->el();
+        for (Element* element : measureElementsList) {
+            std::get<3>(_repeatInfo) = element;
+            if (element->isMarker()) {
+                jumpMarkerMeta(0, &stagger, xPos);
+            }
+        }
+        for (Element* element : measureElementsList) {
+            if (element->isJump()) {
+                std::get<2>(_repeatInfo) = element;
+                if (_collapsedMeta) {
+                    jumpMarkerMeta(0, &stagger, xPos);
+                } else {
+                    jumpMarkerMeta(0, &std::get<0>(_repeatInfo), xPos);
                 }
             }
         }
-        stagger = 0;
-        std::get<0>(_repeatInfo) = 0;
+    }
+    std::get<0>(_repeatInfo) = 0;
+    std::get<4>(_repeatInfo) = false;
+
+    column.metaItems.assign(_metaRows.begin() + firstItem, _metaRows.end());
+    _metaRows.erase(_metaRows.begin() + firstItem, _metaRows.end());
+}
 
-        for (unsigned row = 0; row < numMetas; row++) {
-            staggerArr[row] = 0;
+//---------------------------------------------------------
+//   Timeline::removeColumnMeta
+//---------------------------------------------------------
+
+void Timeline::removeColumnMeta(int col)
+{
+    TimelineColumn& column = _columns[col];
+    for (auto& metaItem : column.metaItems) {
+        if (std::get<0>(_oldHoverInfo) == metaItem.first) {
+            std::get<0>(_oldHoverInfo) = nullptr;
+            std::get<1>(_oldHoverInfo) = -1;
+        }
+        scene()->removeItem(metaItem.first);
+        delete metaItem.first;
+    }
+    column.metaItems.clear();
+    column.metaBuilt = false;
+}
+
+//---------------------------------------------------------
+//   Timeline::updateMetaColumns
+//    keep meta values only for the columns around the
+//    viewport; returns true if any column changed
+//---------------------------------------------------------
+
+bool Timeline::updateMetaColumns()
+{
+    if (_columns.empty()) {
+        return false;
+    }
+
+    // One viewport width on either side, texts may reach into neighbouring columns
+    int margin = viewport()->width();
+    int left = horizontalScrollBar()->value() - margin;
+    int right = horizontalScrollBar()->value() + viewport()->width() + margin;
+    int firstCol = qMax(0, left / _gridWidth);
+    int lastCol = qMin(int(_columns.size()) - 1, right / _gridWidth);
+
+    bool changed = false;
+    for (int col = 0; col < int(_columns.size()); col++) {
+        bool visible = col >= firstCol && col <= lastCol;
+        if (visible == _columns[col].metaBuilt) {
+            continue;
+        }
+        if (!changed) {
+            restoreHoveredItem();
+            changed = true;
+        }
+        if (visible) {
+            buildColumnMeta(col);
+        } else {
+            removeColumnMeta(col);
+        }
+    }
+    return changed;
+}
+
+//---------------------------------------------------------
+//   Timeline::updateColumnCells
+//---------------------------------------------------------
+
+void Timeline::updateColumnCells(int col)
+{
+    TimelineColumn& column = _columns[col];
+    int rows = nstaves();
+    column.cells.resize(rows, 0);
+    for (int stave = 0; stave < rows; stave++) {
+        if (hasChords(column.measure, stave)) {
+            column.cells[stave] |= TimelineColumn::CELL_CHORDS;
+        } else {
+            column.cells[stave] &= ~TimelineColumn::CELL_CHORDS;
         }
-        xPos += _gridWidth;
-        std::get<4>(_repeatInfo) = false;
     }
-    drawSelection();
+}
+
+//---------------------------------------------------------
+//   Timeline::updateChangedColumns
+//    refresh the columns of the measures laid out by the
+//    last command
+//---------------------------------------------------------
+
+void Timeline::updateChangedColumns()
+{
+    const CmdState& cmdState = _score->cmdState();
+    if (!cmdState.layoutRange()) {
+        return;
+    }
+
+    int firstCol = 0;
+    int lastCol = int(_columns.size()) - 1;
+    if (cmdState.startTick() >= Fraction(0,1) && cmdState.endTick() >= cmdState.startTick()) {
+        Measure* firstMeasure = _score->tick2measure(cmdState.startTick());
+        Measure* lastMeasure = _score->tick2measure(cmdState.endTick());
+        if (firstMeasure && lastMeasure) {
+            // Neighbouring measures may show barlines and repeats of the changed ones
+            firstCol = qMax(firstCol, _measureColumns.value(firstMeasure, 0) - 1);
+            lastCol = qMin(lastCol, _measureColumns.value(lastMeasure, lastCol) + 1);
+        }
+    }
+
+    restoreHoveredItem();
+    for (int col = firstCol; col <= lastCol; col++) {
+        updateColumnCells(col);
+        if (_columns[col].metaBuilt) {
+            removeColumnMeta(col);
+            buildColumnMeta(col);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   Timeline::gridKey
+//    everything that requires a full redraw when changed
+//---------------------------------------------------------
+
+QString Timeline::gridKey() const
+{
+    QString key = QString("%1 %2 %3 %4 %5 %6 %7")
+                  .arg(quintptr(_score))
+                  .arg(_gridWidth)
+                  .arg(_gridHeight)
+                  .arg(nstaves())
+                  .arg(_score->nmeasures())
+                  .arg(_collapsedMeta)
+                  .arg(preferences.isThemeDark());
+    for (auto it = _metas.begin(); it != _metas.end(); ++it) {
+        key += QString(" %1:%2").arg(std::get<0>(*it)).arg(std::get<2>(*it));
+    }
+    return key;
+}
+
+//---------------------------------------------------------
+//   Timeline::sameMeasures
+//---------------------------------------------------------
+
+bool Timeline::sameMeasures() const
+{
+    size_t col = 0;
+    for (Measure* measure = _score->firstMeasure(); measure; measure = measure->nextMeasure()) {
+        if (col >= _columns.size() || _columns[col].measure != measure) {
+            return false;
+        }
+        col++;
+    }
+    return col == _columns.size();
+}
+
+//---------------------------------------------------------
+//   Timeline::cellRect
+//---------------------------------------------------------
+
+QRectF Timeline::cellRect(int col, int row) const
+{
+    return QRectF(col * _gridWidth, _gridHeight * (row + nmetas()) + 3, _gridWidth, _gridHeight);
+}
+
+//---------------------------------------------------------
+//   Timeline::cellAt
+//    find the cell under scenePt; cells covered by the
+//    meta rows don't count
+//---------------------------------------------------------
+
+bool Timeline::cellAt(const QPointF& scenePt, int& col, int& row) const
+{
+    if (_columns.empty() || scenePt.x() < 0) {
+        return false;
+    }
+    int numMetas = nmetas();
+    if (scenePt.y() < verticalScrollBar()->value() + numMetas * _gridHeight) {
+        return false;
+    }
+    qreal y = scenePt.y() - (_gridHeight * numMetas + 3);
+    if (y < 0) {
+        return false;
+    }
+    col = int(scenePt.x()) / _gridWidth;
+    row = int(y) / _gridHeight;
+    return col < int(_columns.size()) && row < int(_columns[col].cells.size());
+}
+
+//---------------------------------------------------------
+//   Timeline::cellToolTip
+//---------------------------------------------------------
+
+QString Timeline::cellToolTip(int col, int row)
+{
+    QList<Part*> partList = getParts();
+    QString translateMeasure = tr("Measure");
+    QChar initialLetter = translateMeasure[0];
+    QTextDocument doc;
+    QString partName = "";
+    if (partList.size() > row) {
+        doc.setHtml(partList.at(row)->longName());
+        partName = doc.toPlainText();
+    }
+    if (partName.isEmpty() && partList.size() > row) {
+        partName = partList.at(row)->instrumentName();
+    }
+    return initialLetter + QString(" ") + QString::number(_columns[col].measure->no() + 1) + QString(", ") + partName;
+}
+
+//---------------------------------------------------------
+//   Timeline::cellColor
+//---------------------------------------------------------
+
+QColor Timeline::cellColor(char cellFlags) const
+{
+    QColor color = (cellFlags & TimelineColumn::CELL_CHORDS) ? activeTheme().colorBoxColor : QColor(224, 224, 224);
+    if (cellFlags & TimelineColumn::CELL_SELECTED) {
+        // Change color from gray to only blue
+        color = QColor(color.red(), color.green(), 255);
+    }
+    return color;
+}
+
+//---------------------------------------------------------
+//   Timeline::drawBackground
+//    paint the cells intersecting rect
+//---------------------------------------------------------
+
+void Timeline::drawBackground(QPainter* painter, const QRectF& rect)
+{
+    QGraphicsView::drawBackground(painter, rect);
+    if (!_score || _columns.empty()) {
+        return;
+    }
+
+    int top = _gridHeight * nmetas() + 3;
+    if (rect.bottom() < top) {
+        return;
+    }
+    // Cell outlines reach half a pixel into the neighbours
+    int firstCol = qMax(0, int(rect.left() - 1) / _gridWidth);
+    int lastCol = qMin(int(_columns.size()) - 1, int(rect.right() + 1) / _gridWidth);
+    int firstRow = qMax(0, int(rect.top() - 1 - top) / _gridHeight);
+    int lastRow = int(rect.bottom() + 1 - top) / _gridHeight;
+
+    painter->setPen(QPen(activeTheme().backgroundColor));
+    for (int col = firstCol; col <= lastCol; col++) {
+        const std::vector<char>& cells = _columns[col].cells;
+        int rows = qMin(lastRow, int(cells.size()) - 1);
+        for (int row = firstRow; row <= rows; row++) {
+            painter->setBrush(cellColor(cells[row]));
+            painter->drawRect(QRectF(col * _gridWidth, _gridHeight * row + top, _gridWidth, _gridHeight));
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   Timeline::viewportEvent
+//    cells are not scene items, show their tooltips here
+//---------------------------------------------------------
+
+bool Timeline::viewportEvent(QEvent* event)
+{
+    if (event->type() == QEvent::ToolTip && _score) {
+        QHelpEvent* helpEvent = static_cast<QHelpEvent*>(event);
+        int col;
+        int row;
+        if (cellAt(mapToScene(helpEvent->pos()), col, row)) {
+            QToolTip::showText(helpEvent->globalPos(), cellToolTip(col, row), viewport());
+            return true;
+        }
+    }
+    return QGraphicsView::viewportEvent(event);
+}
+
+//---------------------------------------------------------
+//   Timeline::resizeEvent
+//---------------------------------------------------------
+
+void Timeline::resizeEvent(QResizeEvent* event)
+{
+    QGraphicsView::resizeEvent(event);
+    handleHorizontalScroll(horizontalScrollBar()->value());
 }
 
 //---------------------------------------------------------
@@ -1478,11 +1744,10 @@ void Timeline::measureMeta(Segment*, int*, int pos)
     // Find position of measureMeta in metas
     int row = getMetaRow(tr("Measures"));
 
-    // Adjust number
-    Measure* currMeasure;
-    for (currMeasure = _score->firstMeasure(); currMeasureNumber != 0;
-         currMeasureNumber--, currMeasure = currMeasure->nextMeasure()) {
+    if (currMeasureNumber < 0 || currMeasureNumber >= int(_columns.size())) {
+        return;
     }
+    Measure* currMeasure = _columns[currMeasureNumber].measure;
 
     // Add measure number
     QString measureNumber = (currMeasure->irregular()) ? "( )" : QString::number(currMeasure->no() + 1);
@@ -1882,6 +2147,8 @@ void Timeline::drawSelection()
         return;
     }
 
+    restoreHoveredItem();
+
     _selectionPath = QPainterPath();
     _selectionPath.setFillRule(Qt::WindingFill);
 
@@ -1964,74 +2231,85 @@ void Timeline::drawSelection()
         }
     }
 
-    QList<QGraphicsItem*> graphicsItemList = scene()->items();
-    for (QGraphicsItem* graphicsItem : graphicsItemList) {
-        int stave = graphicsItem->data(0).value<int>();
-        ElementType elementType = graphicsItem->data(1).value<ElementType>();
-        Measure* measure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
+    // Reset what the previous selection has colored
+    for (TimelineColumn& column : _columns) {
+        for (char& cell : column.cells) {
+            cell &= ~TimelineColumn::CELL_SELECTED;
+        }
+        for (auto& metaItem : column.metaItems) {
+            QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(metaItem.first);
+            if (graphicsRectItem) {
+                graphicsRectItem->setBrush(QBrush(activeTheme().metaValueBrushColor));
+            }
+        }
+    }
+
+    for (const std::tuple<Measure*, int, ElementType>& selected : metaLabelsSet) {
+        int stave = std::get<1>(selected);
+        int col = _measureColumns.value(std::get<0>(selected), -1);
+        if (stave == -1 || col == -1 || stave >= int(_columns[col].cells.size())) {
+            continue;
+        }
+        _columns[col].cells[stave] |= TimelineColumn::CELL_SELECTED;
+        _selectionPath.addRect(cellRect(col, stave));
+    }
 
-        std::tuple<Measure*, int, ElementType> targetTuple(measure, stave, elementType);
-        std::set<std::tuple<Measure*, int, ElementType> >::iterator it;
-        it = metaLabelsSet.find(targetTuple);
+    for (const TimelineColumn& column : _columns) {
+        for (const auto& metaItem : column.metaItems) {
+            QGraphicsItem* graphicsItem = metaItem.first;
+            int stave = graphicsItem->data(0).value<int>();
+            ElementType elementType = graphicsItem->data(1).value<ElementType>();
+            Measure* measure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
+
+            std::tuple<Measure*, int, ElementType> targetTuple(measure, stave, elementType);
+            if (stave != -1 || metaLabelsSet.find(targetTuple) == metaLabelsSet.end()) {
+                continue;
+            }
+            QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
+            if (!graphicsRectItem) {
+                continue;
+            }
 
-        if (stave == -1 && it != metaLabelsSet.end()) {
             //Make sure the element is correct
-            QList<Element*> elementList = _score->selection().elements();
+            const QList<Element*>& elementList = _score->selection().elements();
             Element* targetElement = static_cast<Element*>(graphicsItem->data(4).value<void*>());
             Segment* seg = static_cast<Segment*>(graphicsItem->data(6).value<void*>());
 
             if (targetElement) {
                 for (Element* element : elementList) {
                     if (element == targetElement) {
-                        QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
-                        if (graphicsRectItem) {
-                            graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
-                        }
+                        graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
                     }
                 }
             } else if (seg) {
                 for (Element* element : elementList) {
-                    QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
-                    if (graphicsRectItem) {
-                        for (int track = 0; track < _score->nstaves() * VOICES; track++) {
-                            if (element == seg->element(track)) {
-                                graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
-                            }
+                    for (int track = 0; track < _score->nstaves() * VOICES; track++) {
+                        if (element == seg->element(track)) {
+                            graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
                         }
                     }
                 }
             } else {
-                QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
-                if (graphicsRectItem) {
-                    graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
-                }
+                graphicsRectItem->setBrush(QBrush(activeTheme().selectionColor));
             }
         }
-        // Change color from gray to only blue
-        else if (it != metaLabelsSet.end()) {
-            QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
-            graphicsRectItem->setBrush(QBrush(QColor(graphicsRectItem->brush().color().red(),
-                                                     graphicsRectItem->brush().color().green(),
-                                                     255)));
-            _selectionPath.addRect(graphicsRectItem->rect());
-        }
     }
 
-    QGraphicsPathItem* graphicsPathItem = new QGraphicsPathItem(_selectionPath.simplified());
+    if (_selectionPathItem) {
+        scene()->removeItem(_selectionPathItem);
+        delete _selectionPathItem;
+    }
+    _selectionPathItem = new QGraphicsPathItem(_selectionPath.simplified());
     if (selection.isRange()) {
-        graphicsPathItem->setPen(QPen(QColor(0, 0, 255), 3));
+        _selectionPathItem->setPen(QPen(QColor(0, 0, 255), 3));
     } else {
-        graphicsPathItem->setPen(QPen(QColor(0, 0, 0), 1));
+        _selectionPathItem->setPen(QPen(QColor(0, 0, 0), 1));
     }
 
-    graphicsPathItem->setBrush(Qt::NoBrush);
-    graphicsPathItem->setZValue(-1);
-    scene()->addItem(graphicsPathItem);
-
-    if (std::get<0>(_oldHoverInfo)) {
-        std::get<0>(_oldHoverInfo) = nullptr;
-        std::get<1>(_oldHoverInfo) = -1;
-    }
+    _selectionPathItem->setBrush(Qt::NoBrush);
+    _selectionPathItem->setZValue(-1);
+    scene()->addItem(_selectionPathItem);
+    viewport()->update();
 }
 
 //---------------------------------------------------------
@@ -2066,9 +2344,18 @@ void Timeline::mousePressEvent(QMouseEvent* event)
             maxZValue = graphicsItem->zValue();
         }
     }
+    int stave = -1;
+    Measure* currMeasure = nullptr;
+    int col;
+    int row;
     if (currGraphicsItem) {
-        int stave = currGraphicsItem->data(0).value<int>();
-        Measure* currMeasure = static_cast<Measure*>(currGraphicsItem->data(2).value<void*>());
+        stave = currGraphicsItem->data(0).value<int>();
+        currMeasure = static_cast<Measure*>(currGraphicsItem->data(2).value<void*>());
+    } else if (cellAt(scenePt, col, row)) {
+        stave = row;
+        currMeasure = _columns[col].measure;
+    }
+    if (currGraphicsItem || currMeasure) {
         if (numToStaff(stave) && !numToStaff(stave)->show()) {
             return;
         }
@@ -2080,40 +2367,24 @@ void Timeline::mousePressEvent(QMouseEvent* event)
             // Handle measure box clicks
             if (scenePt.y() > (nmeta - 1) * _gridHeight + verticalScrollBar()->value()
                 && scenePt.y() < bottomOfMeta) {
-                QRectF tmp(scenePt.x(), 0, 3, nmeta * _gridHeight + nstaves() * _gridHeight);
-                QList<QGraphicsItem*> gl = scene()->items(tmp);
-                Measure* measure = nullptr;
-
-                for (QGraphicsItem* graphicsItem : gl) {
-                    measure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
-                    //-3 z value is the grid square values
-                    if (graphicsItem->zValue() == -3 && measure) {
-                        break;
-                    }
-                }
-                if (measure) {
-                    _cv->adjustCanvasPosition(measure, false);
+                int measureCol = int(scenePt.x()) / _gridWidth;
+                if (scenePt.x() >= 0 && measureCol < int(_columns.size())) {
+                    _cv->adjustCanvasPosition(_columns[measureCol].measure, false);
                 }
             }
             if (scenePt.y() < bottomOfMeta) {
                 return;
             }
 
-            QList<QGraphicsItem*> gl = items(event->pos());
-            for (QGraphicsItem* graphicsItem : gl) {
-                currMeasure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
-                stave = graphicsItem->data(0).value<int>();
-                if (currMeasure) {
-                    break;
-                }
-            }
-            if (!currMeasure) {
+            if (!cellAt(scenePt, col, row)) {
                 _score->select(0, SelectType::SINGLE, 0);
                 return;
             }
+            currMeasure = _columns[col].measure;
+            stave = row;
         }
 
-        bool metaValueClicked = currGraphicsItem->data(3).value<bool>();
+        bool metaValueClicked = currGraphicsItem && currGraphicsItem->data(3).value<bool>();
 
         scene()->clearSelection();
         if (metaValueClicked) {
@@ -2273,55 +2544,25 @@ void Timeline::mouseReleaseEvent(QMouseEvent*)
 {
     _mousePressed = false;
     if (state == ViewState::LASSO) {
+        QRectF lasso = _selectionBox->rect();
         scene()->removeItem(_selectionBox);
+        delete _selectionBox;
+        _selectionBox = nullptr;
         _score->deselectAll();
 
-        int width, height;
-        QPoint loc = mapFromScene(_selectionBox->rect().topLeft());
-        width = int(_selectionBox->rect().width());
-        height = int(_selectionBox->rect().height());
-
-        QList<QGraphicsItem*> graphicsItemList = items(QRect(loc.x(), loc.y(), width, height));
-        // Find top left and bottom right to create selection
-        QGraphicsItem* tlGraphicsItem = nullptr;
-        QGraphicsItem* brGraphicsItem = nullptr;
-        for (QGraphicsItem* graphicsItem : graphicsItemList) {
-            Measure* currMeasure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
-            if (!currMeasure) {
-                continue;
-            }
-            int stave = graphicsItem->data(0).value<int>();
-            if (stave == -1) {
-                continue;
-            }
-
-            if (!tlGraphicsItem && !brGraphicsItem) {
-                tlGraphicsItem = graphicsItem;
-                brGraphicsItem = graphicsItem;
-                continue;
-            }
-
-            if (graphicsItem->boundingRect().top() < tlGraphicsItem->boundingRect().top()) {
-                tlGraphicsItem = graphicsItem;
-            }
-            if (graphicsItem->boundingRect().left() < tlGraphicsItem->boundingRect().left()) {
-                tlGraphicsItem = graphicsItem;
-            }
-
-            if (graphicsItem->boundingRect().bottom() > brGraphicsItem->boundingRect().bottom()) {
-                brGraphicsItem = graphicsItem;
-            }
-            if (graphicsItem->boundingRect().right() > brGraphicsItem->boundingRect().right()) {
-                brGraphicsItem = graphicsItem;
-            }
-        }
-
-        // Select single tlGraphicsItem and then range brGraphicsItem
-        if (tlGraphicsItem && brGraphicsItem) {
-            Measure* tlMeasure = static_cast<Measure*>(tlGraphicsItem->data(2).value<void*>());
-            int tlStave = tlGraphicsItem->data(0).value<int>();
-            Measure* brMeasure = static_cast<Measure*>(brGraphicsItem->data(2).value<void*>());
-            int brStave = brGraphicsItem->data(0).value<int>();
+        // Find the cells at the corners of the lasso
+        int top = nmetas() * _gridHeight + 3;
+        int firstCol = qMax(0, int(lasso.left()) / _gridWidth);
+        int lastCol = qMin(int(_columns.size()) - 1, int(lasso.right()) / _gridWidth);
+        int firstRow = qMax(0, int(lasso.top() - top) / _gridHeight);
+        int lastRow = qMin(nstaves() - 1, int(lasso.bottom() - top) / _gridHeight);
+
+        // Select single top left cell and then range bottom right cell
+        if (lasso.bottom() >= top && lasso.right() >= 0 && firstCol <= lastCol && firstRow <= lastRow) {
+            Measure* tlMeasure = _columns[firstCol].measure;
+            int tlStave = firstRow;
+            Measure* brMeasure = _columns[lastCol].measure;
+            int brStave = lastRow;
             if (tlMeasure && brMeasure) {
                 // Focus selection of mmRests here
                 if (tlMeasure->mmRest()) {
@@ -2400,11 +2641,17 @@ void Timeline::wheelEvent(QWheelEvent* event)
 void Timeline::updateGrid()
 {
     if (!isVisible()) {
+        // Changes are not tracked while hidden
+        _gridDirty = true;
         return;
     }
 
     if (_score && _score->firstMeasure()) {
-        drawGrid(nstaves(), _score->nmeasures());
+        if (_gridDirty || _gridKey != gridKey() || !sameMeasures()) {
+            drawGrid(nstaves(), _score->nmeasures());
+        } else {
+            updateChangedColumns();
+        }
         updateView();
         drawSelection();
         mouseOver(mapToScene(mapFromGlobal(QCursor::pos())));
@@ -2436,6 +2683,11 @@ void Timeline::setScore(Score* s)
             tRowLabels->updateLabels(noLabels, 0);
         }
         _metaRows.clear();
+        _columns.clear();
+        _measureColumns.clear();
+        _selectionPathItem = nullptr;
+        std::get<0>(_oldHoverInfo) = nullptr;
+        _gridDirty = true;
         setSceneRect(0, 0, 0, 0);
     }
 
@@ -2559,18 +2811,10 @@ void Timeline::updateView()
         // Find respective visible elements in timeline
         QPainterPath visiblePainterPath = QPainterPath();
         visiblePainterPath.setFillRule(Qt::WindingFill);
-        for (QGraphicsItem* graphicsItem : scene()->items()) {
-            int stave = graphicsItem->data(0).value<int>();
-            Measure* measure = static_cast<Measure*>(graphicsItem->data(2).value<void*>());
-            if (numToStaff(stave) && !numToStaff(stave)->show()) {
-                continue;
-            }
-
-            std::pair<Measure*, int> tmp = std::make_pair(measure, stave);
-            std::set<std::pair<Measure*, int> >::iterator it;
-            it = visibleItemsSet.find(tmp);
-            if (it != visibleItemsSet.end()) {
-                visiblePainterPath.addRect(graphicsItem->boundingRect());
+        for (const std::pair<Measure*, int>& visibleItem : visibleItemsSet) {
+            int col = _measureColumns.value(visibleItem.first, -1);
+            if (col != -1) {
+                visiblePainterPath.addRect(cellRect(col, visibleItem.second));
             }
         }
 
@@ -2622,13 +2866,11 @@ int Timeline::nstaves() const
 }
 
 //---------------------------------------------------------
-//   Timeline::colorBox
+//   Timeline::hasChords
 //---------------------------------------------------------
 
-QColor Timeline::colorBox(QGraphicsRectItem* item)
+bool Timeline::hasChords(Measure* measure, int stave) const
 {
-    Measure* measure = static_cast<Measure*>(item->data(2).value<void*>());
-    int stave = item->data(0).value<int>();
     for (Segment* seg = measure->first(); seg; seg = seg->next()) {
         if (!seg->isChordRestType()) {
             continue;
@@ -2638,12 +2880,12 @@ QColor Timeline::colorBox(QGraphicsRectItem* item)
             if (chordRest) {
                 ElementType crt = chordRest->type();
                 if (crt == ElementType::CHORD || crt == ElementType::REPEAT_MEASURE) {
-                    return activeTheme().colorBoxColor;
+                    return true;
                 }
             }
         }
     }
-    return QColor(224, 224, 224);
+    return false;
 }
 
 //---------------------------------------------------------
@@ -2700,32 +2942,79 @@ void Timeline::handleScroll(int value)
         return;
     }
     for (auto it = _metaRows.begin(); it != _metaRows.end(); ++it) {
-        std::pair<QGraphicsItem*, int> pairGraphicsInt = *it;
+        moveMetaItem(it->first, it->second, value);
+    }
+    for (const TimelineColumn& column : _columns) {
+        for (const auto& metaItem : column.metaItems) {
+            moveMetaItem(metaItem.first, metaItem.second, value);
+        }
+    }
+    viewport()->update();
+}
 
-        QGraphicsItem* graphicsItem = pairGraphicsInt.first;
-        QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
-        QGraphicsLineItem* graphicsLineItem = qgraphicsitem_cast<QGraphicsLineItem*>(graphicsItem);
-        QGraphicsPixmapItem* graphicsPixmapItem = qgraphicsitem_cast<QGraphicsPixmapItem*>(graphicsItem);
+//---------------------------------------------------------
+//   Timeline::handleHorizontalScroll
+//---------------------------------------------------------
 
-        int rowY = pairGraphicsInt.second * _gridHeight;
-        int scrollbarValue = value;
+void Timeline::handleHorizontalScroll(int)
+{
+    if (!_score) {
+        return;
+    }
+    // Newly created meta values need the selection colors
+    if (updateMetaColumns()) {
+        drawSelection();
+    }
+}
 
-        if (graphicsRectItem) {
-            QRectF rectf = graphicsRectItem->rect();
-            rectf.setY(qreal(scrollbarValue + rowY));
-            rectf.setHeight(_gridHeight);
-            graphicsRectItem->setRect(rectf);
-        } else if (graphicsLineItem) {
-            QLineF linef = graphicsLineItem->line();
-            linef.setLine(linef.x1(), rowY + scrollbarValue + 1, linef.x2(), rowY + scrollbarValue + 1);
-            graphicsLineItem->setLine(linef);
-        } else if (graphicsPixmapItem) {
-            graphicsPixmapItem->setY(qreal(scrollbarValue + rowY + 3));
-        } else {
-            graphicsItem->setY(qreal(scrollbarValue + rowY));
+//---------------------------------------------------------
+//   Timeline::moveMetaItem
+//    keep meta row items at the top of the viewport
+//---------------------------------------------------------
+
+void Timeline::moveMetaItem(QGraphicsItem* graphicsItem, int row, int scrollValue)
+{
+    QGraphicsRectItem* graphicsRectItem = qgraphicsitem_cast<QGraphicsRectItem*>(graphicsItem);
+    QGraphicsLineItem* graphicsLineItem = qgraphicsitem_cast<QGraphicsLineItem*>(graphicsItem);
+    QGraphicsPixmapItem* graphicsPixmapItem = qgraphicsitem_cast<QGraphicsPixmapItem*>(graphicsItem);
+
+    int rowY = row * _gridHeight;
+
+    if (graphicsRectItem) {
+        QRectF rectf = graphicsRectItem->rect();
+        rectf.setY(qreal(scrollValue + rowY));
+        rectf.setHeight(_gridHeight);
+        graphicsRectItem->setRect(rectf);
+    } else if (graphicsLineItem) {
+        QLineF linef = graphicsLineItem->line();
+        linef.setLine(linef.x1(), rowY + scrollValue + 1, linef.x2(), rowY + scrollValue + 1);
+        graphicsLineItem->setLine(linef);
+    } else if (graphicsPixmapItem) {
+        graphicsPixmapItem->setY(qreal(scrollValue + rowY + 3));
+    } else {
+        graphicsItem->setY(qreal(scrollValue + rowY));
+    }
+}
+
+//---------------------------------------------------------
+//   Timeline::isMetaRowItem
+//---------------------------------------------------------
+
+bool Timeline::isMetaRowItem(QGraphicsItem* graphicsItem) const
+{
+    for (const auto& metaRow : _metaRows) {
+        if (metaRow.first == graphicsItem) {
+            return true;
         }
     }
-    viewport()->update();
+    for (const TimelineColumn& column : _columns) {
+        for (const auto& metaItem : column.metaItems) {
+            if (metaItem.first == graphicsItem) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
 //---------------------------------------------------------
@@ -2752,44 +3041,12 @@ void Timeline::mouseOver(QPointF pos)
     }
 
     if (!hoveredGraphicsItem) {
-        if (std::get<0>(_oldHoverInfo)) {
-            std::get<0>(_oldHoverInfo)->setZValue(std::get<1>(_oldHoverInfo));
-            static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5).value<void*>())->setZValue(std::get<1>(
-                                                                                                           _oldHoverInfo));
-            QGraphicsRectItem* graphicsRectItem1 = qgraphicsitem_cast<QGraphicsRectItem*>(std::get<0>(_oldHoverInfo));
-            QGraphicsRectItem* graphicsRectItem2
-                = qgraphicsitem_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5)
-                                                                                     .value<void*>()));
-            if (graphicsRectItem1) {
-                graphicsRectItem1->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-            }
-            if (graphicsRectItem2) {
-                graphicsRectItem2->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-            }
-            std::get<0>(_oldHoverInfo) = nullptr;
-            std::get<1>(_oldHoverInfo) = -1;
-        }
+        restoreHoveredItem();
         return;
     }
     QGraphicsItem* pairItem = static_cast<QGraphicsItem*>(hoveredGraphicsItem->data(5).value<void*>());
     if (!pairItem) {
-        if (std::get<0>(_oldHoverInfo)) {
-            std::get<0>(_oldHoverInfo)->setZValue(std::get<1>(_oldHoverInfo));
-            static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5).value<void*>())->setZValue(std::get<1>(
-                                                                                                           _oldHoverInfo));
-            QGraphicsRectItem* graphicsRectItem1 = qgraphicsitem_cast<QGraphicsRectItem*>(std::get<0>(_oldHoverInfo));
-            QGraphicsRectItem* graphicsRectItem2
-                = qgraphicsitem_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5)
-                                                                                     .value<void*>()));
-            if (graphicsRectItem1) {
-                graphicsRectItem1->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-            }
-            if (graphicsRectItem2) {
-                graphicsRectItem2->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-            }
-            std::get<0>(_oldHoverInfo) = nullptr;
-            std::get<1>(_oldHoverInfo) = -1;
-        }
+        restoreHoveredItem();
         return;
     }
 
@@ -2797,24 +3054,7 @@ void Timeline::mouseOver(QPointF pos)
         return;
     }
 
-    if (std::get<0>(_oldHoverInfo)) {
-        std::get<0>(_oldHoverInfo)->setZValue(std::get<1>(_oldHoverInfo));
-        static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5).value<void*>())->setZValue(std::get<1>(
-                                                                                                       _oldHoverInfo));
-        QGraphicsRectItem* graphicsRectItem1 = qgraphicsitem_cast<QGraphicsRectItem*>(std::get<0>(_oldHoverInfo));
-        QGraphicsRectItem* graphicsRectItem2
-            = qgraphicsitem_cast<QGraphicsRectItem*>(static_cast<QGraphicsItem*>(std::get<0>(_oldHoverInfo)->data(5).
-                                                                                 value<void*>()));
-        if (graphicsRectItem1) {
-            graphicsRectItem1->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-        }
-        if (graphicsRectItem2) {
-            graphicsRectItem2->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
-        }
-
-        std::get<0>(_oldHoverInfo) = nullptr;
-        std::get<1>(_oldHoverInfo) = -1;
-    }
+    restoreHoveredItem();
 
     std::get<1>(_oldHoverInfo) = hoveredGraphicsItem->zValue();
     std::get<0>(_oldHoverInfo) = hoveredGraphicsItem;
@@ -2839,6 +3079,31 @@ void Timeline::mouseOver(QPointF pos)
     }
 }
 
+//---------------------------------------------------------
+//   Timeline::restoreHoveredItem
+//---------------------------------------------------------
+
+void Timeline::restoreHoveredItem()
+{
+    QGraphicsItem* hoveredItem = std::get<0>(_oldHoverInfo);
+    if (!hoveredItem) {
+        return;
+    }
+    QGraphicsItem* pairItem = static_cast<QGraphicsItem*>(hoveredItem->data(5).value<void*>());
+    hoveredItem->setZValue(std::get<1>(_oldHoverInfo));
+    pairItem->setZValue(std::get<1>(_oldHoverInfo));
+    QGraphicsRectItem* graphicsRectItem1 = qgraphicsitem_cast<QGraphicsRectItem*>(hoveredItem);
+    QGraphicsRectItem* graphicsRectItem2 = qgraphicsitem_cast<QGraphicsRectItem*>(pairItem);
+    if (graphicsRectItem1) {
+        graphicsRectItem1->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
+    }
+    if (graphicsRectItem2) {
+        graphicsRectItem2->setBrush(QBrush(std::get<2>(_oldHoverInfo)));
+    }
+    std::get<0>(_oldHoverInfo) = nullptr;
+    std::get<1>(_oldHoverInfo) = -1;
+}
+
 //---------------------------------------------------------
 //   Timeline::swapMeta
 //---------------------------------------------------------
@@ -3021,29 +3286,18 @@ QString Timeline::cursorIsOn()
 {
     QPointF scenePos = mapToScene(mapFromGlobal(QCursor::pos()));
     QGraphicsItem* graphicsItem = scene()->itemAt(scenePos, transform());
-    if (graphicsItem) {
-        auto it = _metaRows.begin();
-        for (; it != _metaRows.end(); ++it) {
-            if ((*it).first == graphicsItem) {
-                break;
-            }
-        }
-        if (it != _metaRows.end()) {
-            return "meta";
-        } else {
-            QList<QGraphicsItem*> graphicsItemList = scene()->items(scenePos);
-            for (QGraphicsItem* currGraphicsItem : graphicsItemList) {
-                Measure* currMeasure = static_cast<Measure*>(currGraphicsItem->data(2).value<void*>());
-                int stave = currGraphicsItem->data(0).value<int>();
-                if (currMeasure && !numToStaff(stave)->show()) {
-                    return "invalid";
-                }
-            }
-            return "instrument";
+    if (graphicsItem && isMetaRowItem(graphicsItem)) {
+        return "meta";
+    }
+    int col;
+    int row;
+    if (cellAt(scenePos, col, row)) {
+        if (!numToStaff(row)->show()) {
+            return "invalid";
         }
-    } else {
-        return "";
+        return "instrument";
     }
+    return graphicsItem ? "instrument" : "";
 }
 
 //---------------------------------------------------------
@@ -118,6 +118,25 @@ struct TimelineTheme {
     QColor metaValuePenColor, metaValueBrushColor;
 };
 
+//---------------------------------------------------------
+//   TimelineColumn
+//    One measure of the grid. The cells are painted in
+//    Timeline::drawBackground(), meta row items exist only
+//    for columns near the viewport.
+//---------------------------------------------------------
+
+struct TimelineColumn {
+    enum CellFlag : char {
+        CELL_CHORDS   = 1,
+        CELL_SELECTED = 2
+    };
+
+    Measure* measure { nullptr };
+    std::vector<char> cells;                                  // CellFlags, one per staff
+    std::vector<std::pair<QGraphicsItem*, int> > metaItems;   // item, meta row
+    bool metaBuilt { false };
+};
+
 //---------------------------------------------------------
 //   Timeline
 //---------------------------------------------------------
@@ -147,8 +166,14 @@ class Timeline : public QGraphicsView
     ScoreView* _cv { nullptr };
 
     QGraphicsRectItem* _selectionBox { nullptr };
+    QGraphicsPathItem* _selectionPathItem { nullptr };
     std::vector<std::pair<QGraphicsItem*, int> > _metaRows;
 
+    std::vector<TimelineColumn> _columns;
+    QHash<Measure*, int> _measureColumns;
+    QString _gridKey;
+    bool _gridDirty { true };
+
     QPainterPath _selectionPath;
     QRectF _oldSelectionRect;
     bool _mousePressed { false };
@@ -183,14 +208,35 @@ class Timeline : public QGraphicsView
     virtual void mouseReleaseEvent(QMouseEvent*);
     virtual void wheelEvent(QWheelEvent* event);
     virtual void leaveEvent(QEvent*);
+    virtual void resizeEvent(QResizeEvent* event) override;
 
     unsigned correctMetaRow(unsigned row);
     int correctStave(int stave);
 
     QList<Part*> getParts();
 
+    virtual void drawBackground(QPainter* painter, const QRectF& rect) override;
+    virtual bool viewportEvent(QEvent* event) override;
+
+    QString gridKey() const;
+    bool sameMeasures() const;
+    void updateChangedColumns();
+    void updateColumnCells(int col);
+    bool updateMetaColumns();
+    void buildColumnMeta(int col);
+    void removeColumnMeta(int col);
+    void moveMetaItem(QGraphicsItem* item, int row, int scrollValue);
+    bool isMetaRowItem(QGraphicsItem* item) const;
+    void restoreHoveredItem();
+    QRectF cellRect(int col, int row) const;
+    bool cellAt(const QPointF& scenePt, int& col, int& row) const;
+    QString cellToolTip(int col, int row);
+    bool hasChords(Measure* measure, int stave) const;
+    QColor cellColor(char cellFlags) const;
+
 private slots:
     void handleScroll(int value);
+    void handleHorizontalScroll(int value);
     void updateView();
     void objectDestroyed(QObject*);
 
@@ -224,8 +270,6 @@ public:
 
     void updateGrid();
 
-    QColor colorBox(QGraphicsRectItem* item);
-
     std::vector<std::pair<QString, bool> > getLabels();
 
     unsigned nmetas() const;
@@ -0,0 +1,123 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+#include "mtest/testutils.h"
+#include "audio/drivers/nullaudio.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestNullAudio
+//---------------------------------------------------------
+
+class TestNullAudio : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void histogramBuckets();
+    void deadlineMisses();
+    void json();
+};
+
+//---------------------------------------------------------
+///   histogramBuckets
+///     bucket i counts callbacks of [2^i, 2^(i+1))
+///     microseconds, bucket 0 everything below 2, the
+///     last one everything longer
+//---------------------------------------------------------
+
+void TestNullAudio::histogramBuckets()
+{
+    NullAudioStats stats;
+    const qint64 period = 10000000;     // 10 ms
+    stats.add(500, period);             // 0 us
+    stats.add(1999, period);            // 1 us
+    stats.add(2000, period);            // 2 us
+    stats.add(3999, period);            // 3 us
+    stats.add(1000000, period);         // 1000 us
+    stats.add(qint64(1) << 50, period);
+
+    QCOMPARE(stats.histogram[0], quint64(2));
+    QCOMPARE(stats.histogram[1], quint64(2));
+    QCOMPARE(stats.histogram[9], quint64(1));
+    QCOMPARE(stats.histogram[NullAudioStats::HISTOGRAM_BUCKETS - 1], quint64(1));
+
+    quint64 sum = 0;
+    for (quint64 n : stats.histogram) {
+        sum += n;
+    }
+    QCOMPARE(sum, stats.callbacks);
+    QCOMPARE(stats.callbacks, quint64(6));
+}
+
+//---------------------------------------------------------
+///   deadlineMisses
+///     a callback longer than one period misses its
+///     deadline, one of exactly one period does not
+//---------------------------------------------------------
+
+void TestNullAudio::deadlineMisses()
+{
+    NullAudioStats stats;
+    const qint64 period = 5333333;      // 256 frames at 48 kHz
+    stats.add(1000000, period);
+    stats.add(period, period);
+    stats.add(period + 1, period);
+    stats.add(3 * period, period);
+
+    QCOMPARE(stats.callbacks, quint64(4));
+    QCOMPARE(stats.deadlineMisses, quint64(2));
+    QCOMPARE(stats.maxNs, 3 * period);
+    QCOMPARE(stats.totalNs, 1000000 + 5 * period + 1);
+    QCOMPARE(stats.xruns, quint64(0));      // counted by the driver loop
+}
+
+//---------------------------------------------------------
+///   json
+//---------------------------------------------------------
+
+void TestNullAudio::json()
+{
+    NullAudioStats stats;
+    const qint64 period = 5333333;
+    stats.add(1000000, period);
+    stats.add(3000000, period);
+    stats.add(8000000, period);
+    stats.frames = 3 * 256;
+    stats.xruns  = 1;
+
+    QJsonObject o = stats.toJson(48000, 256);
+    QCOMPARE(o["sampleRate"].toInt(), 48000);
+    QCOMPARE(o["periodFrames"].toInt(), 256);
+    QCOMPARE(o["periodUs"].toDouble(), 256 * 1e6 / 48000);
+    QCOMPARE(o["callbacks"].toDouble(), 3.0);
+    QCOMPARE(o["frames"].toDouble(), 768.0);
+    QCOMPARE(o["deadlineMisses"].toDouble(), 1.0);
+    QCOMPARE(o["xruns"].toDouble(), 1.0);
+    QCOMPARE(o["meanUs"].toDouble(), 4000.0);
+    QCOMPARE(o["maxUs"].toDouble(), 8000.0);
+
+    QJsonArray h = o["histogramLog2Us"].toArray();
+    QCOMPARE(h.size(), NullAudioStats::HISTOGRAM_BUCKETS);
+    QCOMPARE(h[9].toDouble(), 1.0);         // 1000 us
+    QCOMPARE(h[11].toDouble(), 1.0);        // 3000 us
+    QCOMPARE(h[12].toDouble(), 1.0);        // 8000 us
+
+    // no callbacks, no division by zero
+    QCOMPARE(NullAudioStats().toJson(48000, 256)["meanUs"].toDouble(), 0.0);
+}
+
+QTEST_MAIN(TestNullAudio)
+
+#include "tst_nullaudio.moc"
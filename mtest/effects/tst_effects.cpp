@@ -0,0 +1,498 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "mtest/testutils.h"
+#include "effects/compressor/compressor.h"
+#include "effects/zita1/zita.h"
+
+using namespace Ms;
+
+static const float SAMPLERATE = 48000.0f;
+static const int BLOCK        = 256;       // frames per process() call
+static const int FRAMES       = 2 * 48000;
+
+//---------------------------------------------------------
+//   RefZitaReverb
+//    the scalar, sample by sample reverb the vectorized
+//    ZitaReverb has to match, with the default parameters
+//---------------------------------------------------------
+
+class RefZitaReverb
+{
+    struct Line {
+        std::vector<float> data;
+        int i { 0 };
+        void init(int size) { data.assign(size, 0.0f); i = 0; }
+        float read() const { return data[i]; }
+        void write(float x) { data[i] = x; if (++i == int(data.size())) { i = 0; } }
+    };
+    struct Diff {
+        Line line;
+        float c;
+        float process(float x)
+        {
+            float z = line.read();
+            x -= c * z;
+            line.write(x);
+            return z + c * x;
+        }
+    };
+    struct Filt {
+        float gmf, glo, wlo, whi, slo { 0 }, shi { 0 };
+        float process(float x)
+        {
+            slo += wlo * (x - slo) + 1e-10f;
+            x += glo * slo;
+            shi += whi * (x - shi);
+            return gmf * shi;
+        }
+    };
+
+    std::vector<float> _vdelay[2];
+    int _ir { 0 };
+    int _iw { 0 };
+    Diff _diff[8];
+    Filt _filt[8];
+    Line _delay[8];
+    float _g0 { 0 }, _d0 { 0 }, _g1 { 0 }, _d1 { 0 };
+    Pareq _pareq1, _pareq2;
+    int _nsamp { 0 };
+    bool _first { true };
+
+    void prepare(int nfram)
+    {
+        static const float tdelay[8] = { 153129e-6f, 210389e-6f, 127837e-6f, 256891e-6f,
+                                         174713e-6f, 192303e-6f, 125000e-6f, 219991e-6f };
+        const float rtlow = 1.4f, rtmid = 2.0f, xover = 200.0f, fdamp = 3e3f, opmix = 0.33f;
+        _d0 = _d1 = 0;
+        if (_first) {
+            int k = (int)(floorf((0.04f - 0.020f) * SAMPLERATE + 0.5f));
+            _ir = _iw - k;
+            if (_ir < 0) {
+                _ir += int(_vdelay[0].size());
+            }
+            float wlo = 6.2832f * xover / SAMPLERATE;
+            float chi = 1 - cosf(6.2832f * fdamp / SAMPLERATE);
+            for (int i = 0; i < 8; i++) {
+                Filt& f = _filt[i];
+                f.gmf = powf(0.001f, tdelay[i] / rtmid);
+                f.glo = powf(0.001f, tdelay[i] / rtlow) / f.gmf - 1.0f;
+                f.wlo = wlo;
+                float g = powf(0.001f, tdelay[i] / (0.5f * rtmid)) / f.gmf;
+                float t = (1 - g * g) / (2 * g * g * chi);
+                f.whi = (sqrtf(1 + 4 * t) - 1) / (2 * t);
+            }
+            float t0 = (1 - opmix) * (1 + opmix);
+            float t1 = 0.7f * opmix * (2 - opmix) / sqrtf(rtmid);
+            _d0 = (t0 - _g0) / nfram;
+            _d1 = (t1 - _g1) / nfram;
+            _first = false;
+        }
+        _pareq1.prepare(nfram);
+        _pareq2.prepare(nfram);
+    }
+
+public:
+    RefZitaReverb()
+    {
+        static const float tdiff1[8] = { 20346e-6f, 24421e-6f, 31604e-6f, 27333e-6f,
+                                         22904e-6f, 29291e-6f, 13458e-6f, 19123e-6f };
+        static const float tdelay[8] = { 153129e-6f, 210389e-6f, 127837e-6f, 256891e-6f,
+                                         174713e-6f, 192303e-6f, 125000e-6f, 219991e-6f };
+        _vdelay[0].assign((int)(0.1f * SAMPLERATE), 0.0f);
+        _vdelay[1].assign((int)(0.1f * SAMPLERATE), 0.0f);
+        for (int i = 0; i < 8; i++) {
+            int k1 = (int)(floorf(tdiff1[i] * SAMPLERATE + 0.5f));
+            int k2 = (int)(floorf(tdelay[i] * SAMPLERATE + 0.5f));
+            _diff[i].line.init(k1);
+            _diff[i].c = (i & 1) ? -0.6f : 0.6f;
+            _delay[i].init(k2 - k1);
+        }
+        _pareq1.setfsamp(SAMPLERATE);
+        _pareq2.setfsamp(SAMPLERATE);
+        _pareq1.setparam(160.0, 0.0);
+        _pareq2.setparam(2.5e3, 0.0);
+    }
+
+    void process(int nfram, float* inp, float* out)
+    {
+        const int fragm = 1024;
+        const float g = sqrtf(0.125f);
+        const int size = int(_vdelay[0].size());
+        while (nfram) {
+            if (!_nsamp) {
+                prepare(fragm);
+                _nsamp = fragm;
+            }
+            int k = _nsamp < nfram ? _nsamp : nfram;
+            for (int i = 0; i < k * 2; i += 2) {
+                _vdelay[0][_iw] = inp[i];
+                _vdelay[1][_iw] = inp[i + 1];
+                if (++_iw == size) {
+                    _iw = 0;
+                }
+                float t0 = 0.3f * _vdelay[0][_ir];
+                float t1 = 0.3f * _vdelay[1][_ir];
+                if (++_ir == size) {
+                    _ir = 0;
+                }
+                float x[8];
+                for (int j = 0; j < 8; j++) {
+                    float t = j < 4 ? t0 : t1;
+                    x[j] = _diff[j].process(_delay[j].read() + ((j & 2) ? -t : t));
+                }
+                for (int step = 1; step < 8; step *= 2) {
+                    for (int j = 0; j < 8; j++) {
+                        if (!(j & step)) {
+                            float t = x[j] - x[j + step];
+                            x[j] += x[j + step];
+                            x[j + step] = t;
+                        }
+                    }
+                }
+                _g1 += _d1;
+                out[i]     = _g1 * (x[1] + x[2]);
+                out[i + 1] = _g1 * (x[1] - x[2]);
+                for (int j = 0; j < 8; j++) {
+                    _delay[j].write(_filt[j].process(g * x[j]));
+                }
+            }
+            _pareq1.process(k, out);
+            _pareq2.process(k, out);
+            for (int i = 0; i < k; i++) {
+                *out++ += _g0 * *inp++;
+                *out++ += _g0 * *inp++;
+                _g0 += _d0;
+            }
+            nfram  -= k;
+            _nsamp -= k;
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   RefCompressor
+//    the scalar, sample by sample compressor the blocked
+//    Compressor has to match, with its own lookup tables
+//---------------------------------------------------------
+
+class RefCompressor
+{
+    static const int RMS_SIZE = 64;
+    static const int TABLE_SIZE = 1024;
+    const float DB_MIN = -60.0f, DB_MAX = 24.0f, LIN_MIN = 0.0000000002f, LIN_MAX = 9.0f;
+
+    float _dbData[TABLE_SIZE];
+    float _linData[TABLE_SIZE];
+    float _as[A_TBL];
+    float _rmsBuffer[RMS_SIZE] = {};
+    unsigned _rmsPos { 0 };
+    float _rmsSum { 0 };
+
+    float sum { 0 }, amp { 0 }, gain { 0 }, gain_t { 0 }, env { 0 }, env_rms { 0 }, env_peak { 0 };
+    unsigned count { 0 };
+    const float rms_peak = 0.5f, _attack = 1.5f, _release = 400.0f, _ratio = 5.0f, _knee = 1.0f;
+    const float _makeupGain = 1.0f;
+
+    float rms(float x)
+    {
+        _rmsSum -= _rmsBuffer[_rmsPos];
+        _rmsSum += x;
+        if (_rmsSum < 1.0e-6) {
+            _rmsSum = 0.0f;
+        }
+        _rmsBuffer[_rmsPos] = x;
+        _rmsPos = (_rmsPos + 1) & (RMS_SIZE - 1);
+        return sqrt(_rmsSum / (float)RMS_SIZE);
+    }
+    static float fmax(float x, float a)
+    {
+        x -= a;
+        x += fabs(x);
+        x *= 0.5;
+        return x + a;
+    }
+    static void roundToZero(volatile float* f)
+    {
+        *f += 1e-18f;
+        *f -= 1e-18f;
+    }
+    float db2lin(float db) const
+    {
+        float scale = (db - DB_MIN) * (float)TABLE_SIZE / (DB_MAX - DB_MIN);
+        int base = lrintf(scale - 0.5f);
+        float ofs = scale - base;
+        if (base < 1) {
+            return 0.0f;
+        } else if (base > TABLE_SIZE - 3) {
+            return _linData[TABLE_SIZE - 2];
+        }
+        return (1.0f - ofs) * _linData[base] + ofs * _linData[base + 1];
+    }
+    float lin2db(float lin) const
+    {
+        float scale = (lin - LIN_MIN) * (float)TABLE_SIZE / (LIN_MAX - LIN_MIN);
+        int base = lrintf(scale - 0.5f);
+        float ofs = scale - base;
+        if (base < 2) {
+            return _dbData[2] * scale * 0.5f - 23.0f * (2.0f - scale);
+        } else if (base > TABLE_SIZE - 2) {
+            return _dbData[TABLE_SIZE - 1];
+        }
+        return (1.0f - ofs) * _dbData[base] + ofs * _dbData[base + 1];
+    }
+
+public:
+    float _threshold = -10.0f;
+
+    RefCompressor()
+    {
+        for (int i = 0; i < A_TBL; ++i) {
+            _as[i] = expf(-1.0f / (SAMPLERATE * (float)i / (float)A_TBL));
+        }
+        for (int i = 0; i < TABLE_SIZE; i++) {
+            _linData[i] = powf(10.0f, ((DB_MAX - DB_MIN) * (float)i / (float)TABLE_SIZE + DB_MIN) / 20.0f);
+            _dbData[i]  = 20.0f * log10f((LIN_MAX - LIN_MIN) * (float)i / (float)TABLE_SIZE + LIN_MIN);
+        }
+    }
+
+    void process(int frames, float* ip, float* op)
+    {
+        const float ga       = _attack < 2.0f ? 0.0f : _as[lrintf(_attack * 0.001f * (float)(A_TBL - 1))];
+        const float gr       = _as[lrintf(_release * 0.001f * (float)(A_TBL - 1))];
+        const float rs       = (_ratio - 1.0f) / _ratio;
+        const float mug      = db2lin(_makeupGain);
+        const float knee_min = db2lin(_threshold - _knee);
+        const float knee_max = db2lin(_threshold + _knee);
+        const float ef_a     = ga * 0.25f;
+        const float ef_ai    = 1.0f - ef_a;
+
+        for (int pos = 0; pos < frames; pos++) {
+            const float lev_in = fmax(fabs(ip[pos * 2]), fabs(ip[pos * 2 + 1]));
+
+            sum += lev_in * lev_in;
+            if (amp > env_rms) {
+                env_rms = env_rms * ga + amp * (1.0f - ga);
+            } else {
+                env_rms = env_rms * gr + amp * (1.0f - gr);
+            }
+            roundToZero(&env_rms);
+            if (lev_in > env_peak) {
+                env_peak = env_peak * ga + lev_in * (1.0f - ga);
+            } else {
+                env_peak = env_peak * gr + lev_in * (1.0f - gr);
+            }
+            roundToZero(&env_peak);
+            if ((count++ & 3) == 3) {
+                amp = rms(sum * 0.25f);
+                sum = 0.0f;
+                if (qIsNaN(env_rms)) {
+                    env_rms = 0.0f;
+                }
+                env = env_rms + rms_peak * (env_peak - env_rms);
+                if (env <= knee_min) {
+                    gain_t = 1.0f;
+                } else if (env < knee_max) {
+                    const float x = -(_threshold - _knee - lin2db(env)) / _knee;
+                    gain_t = db2lin(-_knee * rs * x * x * 0.25f);
+                } else {
+                    gain_t = db2lin((_threshold - lin2db(env)) * rs);
+                }
+            }
+            gain            = gain * ef_a + gain_t * ef_ai;
+            op[pos * 2]     = ip[pos * 2] * gain * mug;
+            op[pos * 2 + 1] = ip[pos * 2 + 1] * gain * mug;
+        }
+    }
+};
+
+//---------------------------------------------------------
+//   TestEffects
+//    checks the vectorized master effects against the
+//    scalar versions, benchmarks with -tickcounter or
+//    -iterations
+//---------------------------------------------------------
+
+class TestEffects : public QObject, public MTest
+{
+    Q_OBJECT
+
+    std::vector<float> _input;
+
+    template<class E>
+    static std::vector<float> run(E& e, const std::vector<float>& in);
+    static float maxDiff(const std::vector<float>& a, const std::vector<float>& b);
+    static void setThreshold(Compressor& c, float db);
+
+private slots:
+    void initTestCase();
+    void zitaMatchesReference();
+    void compressorMatchesReference();
+    void benchmarkZita();
+    void benchmarkZitaScalar();
+    void benchmarkCompressor();
+    void benchmarkCompressorScalar();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    a decaying chord with noise bursts, loud enough to
+//    make the compressor work
+//---------------------------------------------------------
+
+void TestEffects::initTestCase()
+{
+    initMTest();
+    _input.resize(FRAMES * 2);
+    quint32 seed = 12345;
+    for (int i = 0; i < FRAMES; i++) {
+        float t   = i / SAMPLERATE;
+        float env = expf(-2.0f * fmodf(t, 0.5f));
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (i % 12000) < 600 ? (int(seed >> 8) / float(1 << 24) - 0.5f) : 0.0f;
+        float s = env * (0.5f * sinf(2 * float(M_PI) * 220.0f * t) + 0.3f * sinf(2 * float(M_PI) * 277.2f * t));
+        _input[i * 2]     = s + noise;
+        _input[i * 2 + 1] = 0.8f * s - noise;
+    }
+}
+
+//---------------------------------------------------------
+//   run
+//---------------------------------------------------------
+
+template<class E>
+std::vector<float> TestEffects::run(E& e, const std::vector<float>& in)
+{
+    std::vector<float> inp(in);
+    std::vector<float> out(in.size());
+    for (int i = 0; i < FRAMES; i += BLOCK) {
+        e.process(qMin(BLOCK, FRAMES - i), inp.data() + i * 2, out.data() + i * 2);
+    }
+    return out;
+}
+
+//---------------------------------------------------------
+//   maxDiff
+//---------------------------------------------------------
+
+float TestEffects::maxDiff(const std::vector<float>& a, const std::vector<float>& b)
+{
+    float d = 0.0f;
+    for (size_t i = 0; i < a.size(); i++) {
+        d = qMax(d, std::fabs(a[i] - b[i]));
+    }
+    return d;
+}
+
+//---------------------------------------------------------
+//   setThreshold
+//---------------------------------------------------------
+
+void TestEffects::setThreshold(Compressor& c, float db)
+{
+    for (const ParDescr& d : c.parDescr()) {
+        if (!strcmp(d.name, "threshold")) {
+            c.setNValue(d.id, db);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   zitaMatchesReference
+//---------------------------------------------------------
+
+void TestEffects::zitaMatchesReference()
+{
+    ZitaReverb zita;
+    zita.init(SAMPLERATE);
+    RefZitaReverb ref;
+    std::vector<float> a = run(zita, _input);
+    std::vector<float> b = run(ref, _input);
+    QVERIFY(maxDiff(a, b) < 1e-5f);
+}
+
+//---------------------------------------------------------
+//   compressorMatchesReference
+//    also with block sizes which leave a single frame
+//    for the scalar tail
+//---------------------------------------------------------
+
+void TestEffects::compressorMatchesReference()
+{
+    Compressor comp;
+    comp.init(SAMPLERATE);
+    setThreshold(comp, -20.0f);
+    RefCompressor ref;
+    ref._threshold = -20.0f;
+
+    std::vector<float> a = run(comp, _input);
+    std::vector<float> b = run(ref, _input);
+    QVERIFY(maxDiff(a, b) < 1e-5f);
+    QVERIFY(maxDiff(b, _input) > 1e-2f);      // it did compress
+
+    Compressor comp1;
+    comp1.init(SAMPLERATE);
+    setThreshold(comp1, -20.0f);
+    std::vector<float> in(_input);
+    std::vector<float> c(_input.size());
+    for (int i = 0; i < FRAMES;) {
+        int n = qMin(1 + i % 7, FRAMES - i);
+        comp1.process(n, in.data() + i * 2, c.data() + i * 2);
+        i += n;
+    }
+    QVERIFY(maxDiff(c, b) < 1e-5f);
+}
+
+//---------------------------------------------------------
+//   benchmarks
+//---------------------------------------------------------
+
+void TestEffects::benchmarkZita()
+{
+    ZitaReverb zita;
+    zita.init(SAMPLERATE);
+    QBENCHMARK {
+        run(zita, _input);
+    }
+}
+
+void TestEffects::benchmarkZitaScalar()
+{
+    RefZitaReverb ref;
+    QBENCHMARK {
+        run(ref, _input);
+    }
+}
+
+void TestEffects::benchmarkCompressor()
+{
+    Compressor comp;
+    comp.init(SAMPLERATE);
+    QBENCHMARK {
+        run(comp, _input);
+    }
+}
+
+void TestEffects::benchmarkCompressorScalar()
+{
+    RefCompressor ref;
+    QBENCHMARK {
+        run(ref, _input);
+    }
+}
+
+QTEST_MAIN(TestEffects)
+#include "tst_effects.moc"
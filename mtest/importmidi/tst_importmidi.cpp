@@ -124,6 +124,41 @@ class TestImportMidi : public QObject, public MTest
         mf(file);
     }
 
+    // import with the current operations, the file stays opened for reimport
+    void importSave(const char* file, const QString& saveName) const
+    {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        score->setName(file);
+        QCOMPARE(importMidi(score, midiFilePath(file)), Score::FileError::FILE_NO_ERROR);
+        QVERIFY(saveScore(score, saveName));
+        delete score;
+    }
+
+    // drops the data of the previous imports of the file
+    void reopen(const char* file)
+    {
+        auto& opers = midiImportOperations;
+        opers.excludeMidiFile(midiFilePath(file));
+        opers.addNewMidiFile(midiFilePath(file));
+        MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, midiFilePath(file));
+        auto& data = *opers.data();
+
+        data.trackOpers.doStaffSplit.setDefaultValue(false, false);
+        data.trackOpers.showTempoText.setDefaultValue(false);
+    }
+
+    void setReimportOperations(const char* file, bool simplify, MidiOperations::VoiceCount voiceCount)
+    {
+        auto& opers = midiImportOperations;
+        MidiOperations::CurrentMidiFileSetter setCurrentMidiFile(opers, midiFilePath(file));
+        auto& data = *opers.data();
+
+        data.trackOpers.simplifyDurations.setValue(0, simplify);
+        data.trackOpers.maxVoiceCount.setValue(0, voiceCount);
+    }
+
+    void reimport(const char* file);
+
 private slots:
     void initTestCase();
     void im1() { dontSimplify("m1"); }
@@ -400,6 +435,10 @@ private slots:
     void voiceSeparationTuplet() { voiceSeparation("voice_tuplet", true); }
     void voiceSeparationCentral() { voiceSeparation("voice_central"); }
 
+    // reimport with changed operations reuses the unchanged track stages
+    void reimportVoiceTuplet() { reimport("voice_tuplet"); }
+    void reimportSplitTuplet() { reimport("split_tuplet"); }
+
     // division (fps and ticks per frame case)
     void division() { mf("division"); }
 
@@ -441,6 +480,33 @@ void TestImportMidi::mf(const char* name) const
     delete score;
 }
 
+//---------------------------------------------------------
+//   reimport
+//    imports with other operations for the opened file must
+//    give the same scores as fresh imports with them
+//---------------------------------------------------------
+
+void TestImportMidi::reimport(const char* file)
+{
+    const QString name(file);
+
+    reopen(file);
+    setReimportOperations(file, true, MidiOperations::VoiceCount::V_4);
+    importSave(file, name + "-1.mscx");
+    setReimportOperations(file, false, MidiOperations::VoiceCount::V_1);
+    importSave(file, name + "-2.mscx");
+    setReimportOperations(file, true, MidiOperations::VoiceCount::V_4);
+    importSave(file, name + "-3.mscx");
+
+    reopen(file);
+    setReimportOperations(file, false, MidiOperations::VoiceCount::V_1);
+    importSave(file, name + "-fresh.mscx");
+    midiImportOperations.excludeMidiFile(midiFilePath(file));
+
+    QVERIFY(compareFilesFromPaths(name + "-3.mscx", name + "-1.mscx"));
+    QVERIFY(compareFilesFromPaths(name + "-2.mscx", name + "-fresh.mscx"));
+}
+
 QString TestImportMidi::midiFilePath(const QString& fileName) const
 {
     const QString nameWithExtention = fileName + ".mid";
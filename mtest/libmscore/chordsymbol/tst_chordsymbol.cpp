@@ -22,6 +22,7 @@
 #include "libmscore/harmony.h"
 #include "libmscore/duration.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/chordlist.h"
 
 #define DIR QString("libmscore/chordsymbol/")
 
@@ -61,6 +62,7 @@ private slots:
     void testRealizeTriplet();
     void testRealizeDuration();
     void testRealizeJazz();
+    void testChordListLookup();
 };
 
 //---------------------------------------------------------
@@ -410,5 +412,45 @@ void TestChordSymbol::testRealizeJazz()
     test_post(score, "realize-jazz");
 }
 
+//---------------------------------------------------------
+//   testChordListLookup
+///   Check that the hashed chord list lookup finds the same
+///   descriptions as a linear scan, also after generated
+///   descriptions have been added
+//---------------------------------------------------------
+void TestChordSymbol::testChordListLookup()
+{
+    MasterScore* score = test_pre("extend");
+    ChordList* cl = score->style().chordList();
+    QVERIFY(!cl->isEmpty());
+
+    for (const ChordDescription& cd : *cl) {
+        for (const QString& name : cd.names) {
+            const ChordDescription* first = 0;
+            for (const ChordDescription& c : *cl) {
+                if (c.names.contains(name)) {
+                    first = &c;
+                    break;
+                }
+            }
+            QCOMPARE(cl->description(name), first);
+        }
+    }
+
+    ParsedChord pc;
+    QVERIFY(pc.parse("7b9#11", cl));
+    ParsedChord cachedPc;
+    QVERIFY(cachedPc.parse("7b9#11", cl));
+    QVERIFY(pc == cachedPc);
+
+    ChordDescription cd("7b9#11xyz");
+    cd.complete(0, cl);
+    cl->insert(cd.id, cd);
+    const ChordDescription* found = cl->description("7b9#11xyz");
+    QVERIFY(found);
+    QCOMPARE(found->id, cd.id);
+    delete score;
+}
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
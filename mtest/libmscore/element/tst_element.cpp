@@ -14,6 +14,11 @@
 
 #include "libmscore/score.h"
 #include "libmscore/element.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/staff.h"
+#include "libmscore/stafftype.h"
+#include "libmscore/stafftext.h"
 #include "mtest/testutils.h"
 
 using namespace Ms;
@@ -29,6 +34,8 @@ class TestElement : public QObject, public MTest
 private slots:
     void initTestCase() { initMTest(); }
     void testIds();
+    void testElementIndex();
+    void testElementIndexEdits();
 };
 
 //---------------------------------------------------------
@@ -104,6 +111,152 @@ void TestElement::testIds()
     }
 }
 
+//---------------------------------------------------------
+//   testElementIndex
+//    Score::elements() must agree with scanElements()
+//    and follow undoable changes
+//---------------------------------------------------------
+
+static void collectElements(void* data, Element* e)
+{
+    static_cast<std::vector<Element*>*>(data)->push_back(e);
+}
+
+static std::set<Element*> elementSet(Score* score, ElementType t)
+{
+    const std::vector<Element*>& el = score->elements(t);
+    return std::set<Element*>(el.begin(), el.end());
+}
+
+void TestElement::testElementIndex()
+{
+    score->doLayout();
+    std::vector<Element*> all;
+    score->scanElements(&all, collectElements);
+
+    std::map<ElementType, std::set<Element*> > byType;
+    for (Element* e : all) {
+        byType[e->type()].insert(e);
+    }
+    for (const auto& i : byType) {
+        QVERIFY(elementSet(score, i.first) == i.second);
+        QCOMPARE(score->elements(i.first).size(), i.second.size());
+    }
+    QCOMPARE(score->elementCount(ElementType::OSSIA), 0);
+
+    int n = score->elementCount(ElementType::STAFF_TEXT);
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    StaffText* st = new StaffText(score);
+    st->setParent(s);
+    st->setTrack(0);
+    st->setXmlText("index");
+    score->startCmd();
+    score->undoAddElement(st);
+    score->endCmd();
+    QCOMPARE(score->elementCount(ElementType::STAFF_TEXT), n + 1);
+    std::vector<Element*> staff0 = score->elements(ElementType::STAFF_TEXT, 0);
+    QVERIFY(std::find(staff0.begin(), staff0.end(), st) != staff0.end());
+
+    score->undoRedo(true, 0);
+    QCOMPARE(score->elementCount(ElementType::STAFF_TEXT), n);
+    score->undoRedo(false, 0);
+    QCOMPARE(score->elementCount(ElementType::STAFF_TEXT), n + 1);
+    score->undoRedo(true, 0);
+}
+
+//---------------------------------------------------------
+//   testElementIndexEdits
+//    the index kept up to date by edits, undo and redo
+//    must match an index built from scratch
+//---------------------------------------------------------
+
+static bool elementIndexIsExact(Score* score)
+{
+    std::map<ElementType, std::set<Element*> > updated;
+    for (int t = 0; t < int(ElementType::MAXTYPE); ++t) {
+        updated[ElementType(t)] = elementSet(score, ElementType(t));
+    }
+    score->invalidateElementIndex();
+    for (const auto& i : updated) {
+        if (elementSet(score, i.first) != i.second) {
+            qDebug("element index differs for %s", Element::name(i.first));
+            return false;
+        }
+    }
+    return true;
+}
+
+void TestElement::testElementIndexEdits()
+{
+    MasterScore* score = readScore("test.mscx");
+    QVERIFY(score->elementCount(ElementType::NOTE) > 0);
+
+    // delete everything
+    score->startCmd();
+    score->cmdSelectAll();
+    score->cmdDeleteSelection();
+    score->endCmd();
+    QVERIFY(elementIndexIsExact(score));
+    QCOMPARE(score->elementCount(ElementType::NOTE), 0);
+
+    score->undoRedo(true, 0);
+    QVERIFY(elementIndexIsExact(score));
+    QVERIFY(score->elementCount(ElementType::NOTE) > 0);
+
+    score->undoRedo(false, 0);
+    QVERIFY(elementIndexIsExact(score));
+    score->undoRedo(true, 0);
+
+    // insert and remove measures
+    int rests = score->elementCount(ElementType::REST);
+    score->startCmd();
+    score->insertMeasure(ElementType::MEASURE, score->firstMeasure());
+    score->endCmd();
+    QVERIFY(elementIndexIsExact(score));
+
+    score->undoRedo(true, 0);
+    QVERIFY(elementIndexIsExact(score));
+    QCOMPARE(score->elementCount(ElementType::REST), rests);
+
+    score->startCmd();
+    score->deleteMeasures(score->firstMeasure(), score->firstMeasure());
+    score->endCmd();
+    QVERIFY(elementIndexIsExact(score));
+
+    score->undoRedo(true, 0);
+    QVERIFY(elementIndexIsExact(score));
+
+    // layout replaces stems, beams and bar lines
+    score->doLayout();
+    QVERIFY(elementIndexIsExact(score));
+
+    delete score;
+
+    // layout creates and deletes tablature duration symbols
+    score = readScore("libmscore/all_elements/layout_elements_tab.mscx");
+    auto setGenDurations = [score](bool val) {
+                               for (Staff* staff : score->staves()) {
+                                   if (staff->isTabStaff(Fraction(0, 1))) {
+                                       staff->staffType(Fraction(0, 1))->setGenDurations(val);
+                                   }
+                               }
+                               score->doLayout();
+                           };
+    setGenDurations(true);
+    QVERIFY(score->elementCount(ElementType::TAB_DURATION_SYMBOL) > 0);
+    QVERIFY(elementIndexIsExact(score));
+
+    setGenDurations(false);
+    QCOMPARE(score->elementCount(ElementType::TAB_DURATION_SYMBOL), 0);
+    QVERIFY(elementIndexIsExact(score));
+
+    setGenDurations(true);
+    QVERIFY(score->elementCount(ElementType::TAB_DURATION_SYMBOL) > 0);
+    QVERIFY(elementIndexIsExact(score));
+
+    delete score;
+}
+
 QTEST_MAIN(TestElement)
 
 #include "tst_element.moc"
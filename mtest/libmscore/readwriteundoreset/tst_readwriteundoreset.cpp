@@ -14,6 +14,10 @@
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
 #include "libmscore/undo.h"
+#include "libmscore/mscore.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/part.h"
 
 #define DIR QString("libmscore/readwriteundoreset/")
 
@@ -34,6 +38,16 @@ private slots:
     void testReadWriteResetPositions();
 
     void testMMRestLinksRecreateMMRest();
+
+    void testReadMscz();
+
+    void testReadMetadata_data();
+    void testReadMetadata();
+
+    void testUndoCompaction();
+    void testUndoLimits();
+    void testUndoMemoryUsage();
+    void testUndoMergeDroppedSteps();
 };
 
 //---------------------------------------------------------
@@ -118,5 +132,226 @@ void TestReadWrite::testMMRestLinksRecreateMMRest()
     delete score;
 }
 
+//---------------------------------------------------------
+//   testReadMscz
+///   Reading an mscz, which reads only the zip entries
+///   the score needs, has to give the same score as the
+///   mscx it was saved from.
+//---------------------------------------------------------
+
+void TestReadWrite::testReadMscz()
+{
+    const QString file("barlines");
+
+    QString readFile(DIR + file + ".mscx");
+    QString msczFile(file + "-mscz-test.mscz");
+    QString writeFile(file + "-mscz-test.mscx");
+
+    MasterScore* score = readScore(readFile);
+    QVERIFY(score);
+    QVERIFY(saveScore(score, msczFile));
+    delete score;
+
+    score = readCreatedScore(msczFile);
+    QVERIFY(score);
+    QVERIFY(saveCompareScore(score, writeFile, readFile));
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testReadMetadata
+///   Reading an mscz for metadata only must give the same
+///   metadata as a full read and layout, with the page
+///   count taken from the cache stored in the mscz.
+//---------------------------------------------------------
+
+void TestReadWrite::testReadMetadata_data()
+{
+    QTest::addColumn<QString>("file");
+
+    QTest::newRow("barlines") << DIR + "barlines.mscx";
+    QTest::newRow("repeats") << "libmscore/repeat/repeat24.mscx";
+    QTest::newRow("atonal key") << "libmscore/keysig/concert-pitch.mscx";
+    QTest::newRow("lyrics") << "libmscore/copypastesymbollist/copypastesymbollist-lyrics.mscx";
+}
+
+void TestReadWrite::testReadMetadata()
+{
+    QFETCH(QString, file);
+    QString msczFile(QFileInfo(file).completeBaseName() + "-metadata-test.mscz");
+
+    MasterScore* score = readScore(file);
+    QVERIFY(score);
+    QVERIFY(score->npages() > 0);
+    QVERIFY(saveScore(score, msczFile));
+
+    MasterScore* meta = new MasterScore(mscore->baseStyle());
+    QCOMPARE(meta->loadMscMetadata(msczFile), Score::FileError::FILE_NO_ERROR);
+    QCOMPARE(meta->npages(), 0);
+    QCOMPARE(meta->cachedPageCount(), score->npages());
+    QVERIFY(meta->excerpts().isEmpty());
+
+    QCOMPARE(meta->nmeasures(), score->nmeasures());
+    QCOMPARE(meta->keysig(), score->keysig());
+    QCOMPARE(meta->duration(), score->duration());
+    QCOMPARE(meta->hasLyrics(), score->hasLyrics());
+    QCOMPARE(meta->hasHarmonies(), score->hasHarmonies());
+    QCOMPARE(meta->extractLyrics(), score->extractLyrics());
+    QCOMPARE(meta->parts().size(), score->parts().size());
+    for (int i = 0; i < score->parts().size(); ++i) {
+        QCOMPARE(meta->parts().at(i)->instrumentId(), score->parts().at(i)->instrumentId());
+        QCOMPARE(meta->parts().at(i)->lyricCount(), score->parts().at(i)->lyricCount());
+        QCOMPARE(meta->parts().at(i)->harmonyCount(), score->parts().at(i)->harmonyCount());
+    }
+    delete meta;
+
+    // an uncompressed file has no page count
+    meta = new MasterScore(mscore->baseStyle());
+    QCOMPARE(meta->loadMscMetadata(root + "/" + file), Score::FileError::FILE_NO_ERROR);
+    QCOMPARE(meta->cachedPageCount(), -1);
+    delete meta;
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testUndoCompaction
+///   Repeated changes of the same property within one
+///   command are kept as a single undo step child.
+//---------------------------------------------------------
+
+void TestReadWrite::testUndoCompaction()
+{
+    MasterScore* score = readScore(DIR + "barlines.mscx");
+    QVERIFY(score);
+    Measure* m = score->firstMeasure();
+    const qreal stretch = m->userStretch();
+
+    score->startCmd();
+    for (int i = 1; i <= 10; ++i) {
+        score->undo(new ChangeProperty(m, Pid::USER_STRETCH, stretch + i * 0.1));
+    }
+    score->endCmd();
+
+    UndoStackStats stats = score->undoStack()->stats();
+    QCOMPARE(stats.undoSteps, 1);
+    QVERIFY(stats.commands < 10);
+    QVERIFY(stats.compactedCommands >= 9);
+    QVERIFY(stats.memoryUsage > 0);
+    QCOMPARE(m->userStretch(), stretch + 1.0);
+
+    score->undoRedo(/* undo */ true, nullptr);
+    QCOMPARE(m->userStretch(), stretch);
+    score->undoRedo(/* undo */ false, nullptr);
+    QCOMPARE(m->userStretch(), stretch + 1.0);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testUndoLimits
+///   The oldest steps are dropped once MScore::undoLimit
+///   is exceeded, the remaining ones still undo properly.
+//---------------------------------------------------------
+
+void TestReadWrite::testUndoLimits()
+{
+    MasterScore* score = readScore(DIR + "barlines.mscx");
+    QVERIFY(score);
+    Measure* m = score->firstMeasure();
+    const qreal stretch = m->userStretch();
+
+    MScore::undoLimit = 3;
+    for (int i = 1; i <= 5; ++i) {
+        score->startCmd();
+        score->undo(new ChangeProperty(m, Pid::USER_STRETCH, stretch + i * 0.1));
+        score->endCmd();
+    }
+    MScore::undoLimit = 0;
+
+    UndoStack* undo = score->undoStack();
+    UndoStackStats stats = undo->stats();
+    QCOMPARE(stats.undoSteps, 3);
+    QCOMPARE(stats.droppedSteps, 2);
+    QCOMPARE(undo->getCurIdx(), 5);
+
+    while (undo->canUndo()) {
+        score->undoRedo(/* undo */ true, nullptr);
+    }
+    QCOMPARE(m->userStretch(), stretch + 0.2);
+    QCOMPARE(undo->stats().redoSteps, 3);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testUndoMemoryUsage
+///   A step removing measures holds them, its estimate
+///   has to include their elements.
+//---------------------------------------------------------
+
+void TestReadWrite::testUndoMemoryUsage()
+{
+    MasterScore* score = readScore(DIR + "barlines.mscx");
+    QVERIFY(score);
+    Measure* m = score->firstMeasure();
+
+    score->startCmd();
+    score->undo(new ChangeProperty(m, Pid::USER_STRETCH, m->userStretch() + 0.5));
+    score->endCmd();
+    const size_t propertySize = score->undoStack()->stats().memoryUsage;
+    QVERIFY(propertySize > 0);
+
+    Measure* m2 = m->nextMeasure();
+    score->startCmd();
+    score->deleteMeasures(m, m2);
+    score->endCmd();
+    const size_t removeSize = score->undoStack()->stats().memoryUsage - propertySize;
+    QVERIFY(removeSize > 2 * (sizeof(Measure) + sizeof(Segment)));
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testUndoMergeDroppedSteps
+///   Merging the steps of a text edit whose first steps
+///   have been dropped by MScore::undoLimit merges the
+///   ones left into a single step.
+//---------------------------------------------------------
+
+void TestReadWrite::testUndoMergeDroppedSteps()
+{
+    MasterScore* score = readScore(DIR + "barlines.mscx");
+    QVERIFY(score);
+    Measure* m = score->firstMeasure();
+    const qreal stretch = m->userStretch();
+    UndoStack* undo = score->undoStack();
+    const int startIdx = undo->getCurIdx();
+
+    MScore::undoLimit = 2;
+    for (int i = 1; i <= 4; ++i) {
+        score->startCmd();
+        score->undo(new ChangeProperty(m, Pid::USER_STRETCH, stretch + i * 0.1));
+        score->endCmd();
+    }
+    MScore::undoLimit = 0;
+    QCOMPARE(undo->stats().droppedSteps, 2);
+
+    undo->mergeCommands(startIdx);
+    UndoStackStats stats = undo->stats();
+    QCOMPARE(stats.undoSteps, 1);
+    QCOMPARE(stats.redoSteps, 0);
+    QCOMPARE(undo->getCurIdx(), 3);
+    QCOMPARE(m->userStretch(), stretch + 0.4);
+
+    score->undoRedo(/* undo */ true, nullptr);
+    QVERIFY(!undo->canUndo());
+    QCOMPARE(m->userStretch(), stretch + 0.2);
+    score->undoRedo(/* undo */ false, nullptr);
+    QCOMPARE(m->userStretch(), stretch + 0.4);
+
+    delete score;
+}
+
 QTEST_MAIN(TestReadWrite)
 #include "tst_readwriteundoreset.moc"
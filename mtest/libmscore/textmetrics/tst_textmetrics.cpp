@@ -0,0 +1,196 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include <QtTest/QtTest>
+
+#include "libmscore/mscore.h"
+#include "libmscore/score.h"
+#include "libmscore/text.h"
+#include "libmscore/textmetrics.h"
+#include "mtest/testutils.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestTextMetrics
+//---------------------------------------------------------
+
+class TestTextMetrics : public QObject, public MTest
+{
+    Q_OBJECT
+
+    Text* createText(Tid tid, const QString& s);
+
+private slots:
+    void initTestCase();
+    void init();
+    void cachedValuesMatch();
+    void layoutHitsCache();
+    void fontChange();
+    void styleChange();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestTextMetrics::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   init
+//    every test starts with an empty cache
+//---------------------------------------------------------
+
+void TestTextMetrics::init()
+{
+    TextMetrics::clear();
+}
+
+//---------------------------------------------------------
+//   createText
+//---------------------------------------------------------
+
+Text* TestTextMetrics::createText(Tid tid, const QString& s)
+{
+    Text* text = new Text(score, tid);
+    text->setPlainText(s);
+    text->layout();
+    return text;
+}
+
+//---------------------------------------------------------
+///   cachedValuesMatch
+///     the first lookup misses, the second hits, both
+///     must match uncached measurement
+//---------------------------------------------------------
+
+void TestTextMetrics::cachedValuesMatch()
+{
+    QFont font("FreeSerif");
+    font.setPointSizeF(12.0);
+    QFontMetricsF fm(font, MScore::paintDevice());
+    const QString s("Allegro ma non troppo");
+
+    for (int i = 0; i < 2; ++i) {
+        QCOMPARE(TextMetrics::fontMetrics(font).ascent(), fm.ascent());
+        QCOMPARE(TextMetrics::fontMetrics(font).lineSpacing(), fm.lineSpacing());
+        TextRun run = TextMetrics::run(font, s);
+        QCOMPARE(run.width, fm.width(s));
+        QCOMPARE(run.tightBoundingRect, fm.tightBoundingRect(s));
+    }
+    TextMetrics::Stats st = TextMetrics::stats();
+    QCOMPARE(st.runMisses, 1);
+    QCOMPARE(st.runHits, 1);
+    QCOMPARE(st.metricsMisses, 1);
+
+    // screen metrics are a separate entry
+    QCOMPARE(TextMetrics::fontMetrics(font, false).height(), QFontMetricsF(font).height());
+    QCOMPARE(TextMetrics::stats().metricsMisses, 2);
+}
+
+//---------------------------------------------------------
+///   layoutHitsCache
+///     a second layout of unchanged text is served from
+///     the cache and gives the same result
+//---------------------------------------------------------
+
+void TestTextMetrics::layoutHitsCache()
+{
+    Text* text = createText(Tid::STAFF, "Allegro ma non troppo");
+    QRectF bb = text->bbox();
+    TextMetrics::Stats st1 = TextMetrics::stats();
+    QVERIFY(st1.runMisses > 0);
+
+    text->setLayoutInvalid();
+    text->layout();
+    TextMetrics::Stats st2 = TextMetrics::stats();
+    QCOMPARE(st2.runMisses, st1.runMisses);
+    QVERIFY(st2.runHits > st1.runHits);
+    QCOMPARE(text->bbox(), bb);
+
+    // the same text in another element shares the entries
+    Text* other = createText(Tid::STAFF, "Allegro ma non troppo");
+    QCOMPARE(TextMetrics::stats().runMisses, st1.runMisses);
+    QCOMPARE(other->bbox(), bb);
+
+    // dropping the cache gives the same layout
+    TextMetrics::clear();
+    text->setLayoutInvalid();
+    text->layout();
+    QVERIFY(TextMetrics::stats().runMisses > 0);
+    QCOMPARE(text->bbox(), bb);
+
+    delete other;
+    delete text;
+}
+
+//---------------------------------------------------------
+///   fontChange
+///     changing the font of a text must not reuse the
+///     runs measured in the old font
+//---------------------------------------------------------
+
+void TestTextMetrics::fontChange()
+{
+    Text* text = createText(Tid::STAFF, "Allegro ma non troppo");
+    qreal w = text->bbox().width();
+    qreal size = score->styleD(Sid::staffTextFontSize);
+    TextMetrics::Stats st1 = TextMetrics::stats();
+
+    text->setProperty(Pid::FONT_SIZE, size * 2.0);
+    text->layout();
+    TextMetrics::Stats st2 = TextMetrics::stats();
+    QVERIFY(st2.runMisses > st1.runMisses);
+    QVERIFY(text->bbox().width() > w * 1.5);
+
+    // back to the old size, the old runs are still cached
+    text->setProperty(Pid::FONT_SIZE, size);
+    text->layout();
+    QCOMPARE(TextMetrics::stats().runMisses, st2.runMisses);
+    QCOMPARE(text->bbox().width(), w);
+
+    delete text;
+}
+
+//---------------------------------------------------------
+///   styleChange
+///     a text style change reaches the text through its
+///     styled properties and is measured in the new font
+//---------------------------------------------------------
+
+void TestTextMetrics::styleChange()
+{
+    Text* text = createText(Tid::STAFF, "Allegro ma non troppo");
+    qreal w = text->bbox().width();
+    TextMetrics::Stats st1 = TextMetrics::stats();
+
+    QVariant oldSize = score->styleV(Sid::staffTextFontSize);
+    score->style().set(Sid::staffTextFontSize, oldSize.toReal() * 2.0);
+    text->styleChanged();
+    text->layout();
+    QVERIFY(TextMetrics::stats().runMisses > st1.runMisses);
+    QVERIFY(text->bbox().width() > w * 1.5);
+
+    score->style().set(Sid::staffTextFontSize, oldSize);
+    text->styleChanged();
+    text->layout();
+    QCOMPARE(text->bbox().width(), w);
+
+    delete text;
+}
+
+QTEST_MAIN(TestTextMetrics)
+
+#include "tst_textmetrics.moc"
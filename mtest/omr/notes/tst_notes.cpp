@@ -13,11 +13,35 @@
 #include <QtTest/QtTest>
 #include "mtest/testutils.h"
 #include "libmscore/score.h"
+#include "libmscore/page.h"
+#include "omr/image.h"
+#include "omr/pattern.h"
 
 #define DIR QString("omr/notes/")
 
 using namespace Ms;
 
+//---------------------------------------------------------
+//   RowPattern
+//    a one row pattern with the given model
+//---------------------------------------------------------
+
+class RowPattern : public Pattern
+{
+    std::vector<float> _row;
+    float* _rows[1];
+
+public:
+    RowPattern(std::initializer_list<float> m)
+        : _row(m)
+    {
+        rows     = 1;
+        cols     = int(_row.size());
+        _rows[0] = _row.data();
+        model    = _rows;
+    }
+};
+
 //---------------------------------------------------------
 //   TestNotes
 //---------------------------------------------------------
@@ -27,9 +51,13 @@ class TestNotes : public QObject, public MTest
     Q_OBJECT
 
     void omrFileTest(QString file);
+    static QImage renderPage(Score* score);
 
 private slots:
     void initTestCase();
+    void patternMatch();
+    void patternSearch();
+    void patternSearchOddPeak();
     //void notes2() { omrFileTest("notes2"); }
     //void notes1() { omrFileTest("notes1"); }
 };
@@ -63,5 +91,142 @@ void TestNotes::omrFileTest(QString file)
     QVERIFY(saveCompareScore(score1, file + ".mscx", DIR + file + "-ref.mscx"));
 }
 
+//---------------------------------------------------------
+//   renderPage
+//    first page at half size
+//---------------------------------------------------------
+
+QImage TestNotes::renderPage(Score* score)
+{
+    QRectF r = score->pages().front()->abbox();
+    QImage img(r.width() / 2, r.height() / 2, QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::white);
+    QPainter p(&img);
+    p.scale(0.5, 0.5);
+    score->print(&p, 0);
+    p.end();
+    return img;
+}
+
+//---------------------------------------------------------
+//   patternMatch
+//    check the packed pattern matcher against the pixel
+//    based one on a rendered page and benchmark it
+//---------------------------------------------------------
+
+void TestNotes::patternMatch()
+{
+    MasterScore* score = readScore(DIR + "notes1.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    QImage img = renderPage(score);
+
+    Pattern pattern(score, "solid_note_head");
+    QVERIFY(pattern.w() > 0 && pattern.h() > 0);
+
+    const double ratio = 0.1;
+    BitImage bitImage(img, 125);
+    PatternWeights pw = pattern.weights(ratio);
+
+    for (int y = 0; y < img.height() - pattern.h() / 2; y += 7) {
+        for (int x = 0; x < img.width(); x += 5) {
+            double ref = pattern.match(&img, x, y, ratio);
+            double val = pattern.match(bitImage, x, y, pw);
+            QVERIFY(qAbs(ref - val) <= 1e-6 * qMax(1.0, qAbs(ref)));
+        }
+    }
+
+    QBENCHMARK {
+        for (int y = 0; y < img.height() - pattern.h(); y += 4) {
+            for (int x = 0; x < img.width() - pattern.w(); x += 2) {
+                pattern.match(bitImage, x, y, pw);
+            }
+        }
+    }
+    delete score;
+}
+
+//---------------------------------------------------------
+//   patternSearch
+//    the coarse to fine Pattern::bestMatch() has to find
+//    the same hits as matching every column
+//---------------------------------------------------------
+
+void TestNotes::patternSearch()
+{
+    MasterScore* score = readScore(DIR + "notes1.mscx");
+    QVERIFY(score);
+    score->doLayout();
+
+    QImage img = renderPage(score);
+    Pattern pattern(score, "solid_note_head");
+    QVERIFY(pattern.w() > 0 && pattern.h() > 0);
+
+    BitImage bitImage(img, 125);
+    PatternWeights pw = pattern.weights(0.1);
+    const int x1 = 0;
+    const int x2 = img.width() - pattern.w();
+
+    int hits = 0;
+    for (int y = 0; y < img.height() - pattern.h(); ++y) {
+        double val = 0.0;
+        int xx = -1;
+        for (int x = x1; x < x2; ++x) {
+            double val1 = pattern.match(bitImage, x, y, pw);
+            if (val1 > val) {
+                val = val1;
+                xx  = x;
+            }
+        }
+
+        int col = -1;
+        double colVal = 0.0;
+        bool found = pattern.bestMatch(bitImage, x1, x2, y, pw, 0.0, &col, &colVal);
+        QCOMPARE(found, xx != -1);
+        if (found) {
+            QCOMPARE(col, xx);
+            QCOMPARE(colVal, val);
+            ++hits;
+        }
+    }
+    QVERIFY(hits > 0);
+    delete score;
+}
+
+//---------------------------------------------------------
+//   patternSearchOddPeak
+//    the best match at an odd column between two even
+//    columns which are no local maxima of the coarse pass
+//---------------------------------------------------------
+
+void TestNotes::patternSearchOddPeak()
+{
+    RowPattern pattern({ 0.3f, 0.6f, 0.9f, 0.9f });
+    const char* row = "..##.##.#";
+    QImage img(int(strlen(row)), 1, QImage::Format_ARGB32_Premultiplied);
+    for (int x = 0; x < img.width(); ++x) {
+        img.setPixel(x, 0, row[x] == '#' ? qRgb(0, 0, 0) : qRgb(255, 255, 255));
+    }
+    BitImage bitImage(img, 125);
+    PatternWeights pw = pattern.weights(0.1);
+    const int x2 = img.width() - pattern.w() + 1;
+
+    std::vector<double> val;
+    for (int x = 0; x < x2; ++x) {
+        val.push_back(pattern.match(bitImage, x, 0, pw));
+    }
+    // coarse scores fall, the peak is at column 3
+    QVERIFY(val[0] > val[2] && val[2] > val[4]);
+    QVERIFY(val[3] == *std::max_element(val.begin(), val.end()));
+    QVERIFY(val[3] > val[0]);
+
+    int col = -1;
+    double colVal = 0.0;
+    QVERIFY(pattern.bestMatch(bitImage, 0, x2, 0, pw, 0.0, &col, &colVal));
+    QCOMPARE(col, 3);
+    QCOMPARE(colVal, val[3]);
+}
+
 QTEST_MAIN(TestNotes)
 #include "tst_notes.moc"
@@ -0,0 +1,45 @@
+import QtQuick 2.0
+import MuseScore 3.0
+
+MuseScore {
+      menuPath: "Plugins.p3"
+      onRun: {
+            openLog("p3.log");
+            logn("test script p3: bulk note data and wrapper identity")
+
+            var data = curScore.noteData();
+            log2("notes:", data.count);
+
+            var bulk = [];
+            for (var i = 0; i < data.count; ++i)
+                  bulk.push([data.tick[i], data.track[i], data.pitch[i], data.tpc[i], data.duration[i]].join(":"));
+
+            var cursor    = curScore.newCursor();
+            cursor.filter = -1;
+            var walked    = [];
+            for (var track = 0; track < curScore.ntracks; ++track) {
+                  cursor.track = track;
+                  cursor.rewind(0);
+                  while (cursor.segment) {
+                        var e = cursor.element;
+                        if (e && e.type == Element.CHORD) {
+                              var notes = e.notes;
+                              for (var j = 0; j < notes.length; ++j)
+                                    walked.push([cursor.tick, track, notes[j].pitch, notes[j].tpc, e.actualDuration.ticks].join(":"));
+                              }
+                        cursor.next();
+                        }
+                  }
+            log2("noteData matches cursor:", bulk.sort().join(",") == walked.sort().join(","));
+
+            cursor.track = 0;
+            cursor.rewind(0);
+            var first = cursor.element;
+            cursor.next();
+            cursor.rewind(0);
+            log2("same wrapper:", cursor.element === first);
+
+            closeLog();
+            Qt.quit()
+            }
+      }
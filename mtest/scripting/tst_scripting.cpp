@@ -156,6 +156,7 @@ void TestScripting::processFileWithPlugin_data()
 
     QTest::newRow("p1") << "s1" << "p1";   // scan note rest
     QTest::newRow("p2") << "s2" << "p2";   // scan segment attributes
+    QTest::newRow("p3") << "s1" << "p3";   // bulk note data, wrapper identity
 }
 
 void TestScripting::processFileWithPlugin()
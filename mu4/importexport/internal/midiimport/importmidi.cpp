@@ -63,8 +63,12 @@
 #include "importmidi_instrument.h"
 #include "importmidi_chordname.h"
 
+#include <list>
 #include <set>
 
+#include <QCryptographicHash>
+#include <QtConcurrent>
+
 namespace Ms {
 extern void updateNoteLines(Segment*, int track);
 
@@ -125,15 +129,12 @@ bool doNotesOverlap(const std::multimap<int, MTrack>& tracks)
     return result;
 }
 
-bool noTooShortNotes(const std::multimap<int, MTrack>& tracks)
+bool noTooShortNotes(const MTrack& track)
 {
-    for (const auto& track: tracks) {
-        const auto& chords = track.second.chords;
-        for (const auto& chord: chords) {
-            for (const auto& note: chord.second.notes) {
-                if (note.offTime - chord.first < MChord::minAllowedDuration()) {
-                    return false;
-                }
+    for (const auto& chord: track.chords) {
+        for (const auto& note: chord.second.notes) {
+            if (note.offTime - chord.first < MChord::minAllowedDuration()) {
+                return false;
             }
         }
     }
@@ -171,7 +172,7 @@ void setChordVoice(MidiChord& chord, int voice)
 
 void findAllTupletsForDrums(
     MTrack& mtrack,
-    TimeSigMap* sigmap,
+    const TimeSigMap* sigmap,
     const ReducedFraction& basicQuant)
 {
     const size_t drumVoiceCount = 2;
@@ -210,57 +211,69 @@ void findAllTupletsForDrums(
     // note: temporary local tuplets and chords are deleted here
 }
 
-void quantizeAllTracks(std::multimap<int, MTrack>& tracks,
-                       TimeSigMap* sigmap,
-                       const ReducedFraction& lastTick)
+// on the first processing of the file the drum track operations
+// take their values from the MIDI file
+
+void setDrumTrackOperations(const std::multimap<int, MTrack>& tracks)
 {
     auto& opers = midiImportOperations;
-
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
+    if (opers.data()->processingsOfOpenedFile != 0) {
+        return;
+    }
+    for (const auto& track: tracks) {
+        const MTrack& mtrack = track.second;
         if (mtrack.chords.empty()) {
             continue;
         }
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
-        if (opers.data()->processingsOfOpenedFile == 0) {
-            opers.data()->trackOpers.isDrumTrack.setValue(
-                opers.currentTrack(), mtrack.mtrack->drumTrack());
-            if (mtrack.mtrack->drumTrack()) {
-                opers.data()->trackOpers.maxVoiceCount.setValue(
-                    opers.currentTrack(), MidiOperations::VoiceCount::V_1);
-            }
+        opers.data()->trackOpers.isDrumTrack.setValue(
+            mtrack.indexOfOperation, mtrack.mtrack->drumTrack());
+        if (mtrack.mtrack->drumTrack()) {
+            opers.data()->trackOpers.maxVoiceCount.setValue(
+                mtrack.indexOfOperation, MidiOperations::VoiceCount::V_1);
         }
-        const auto basicQuant = Quantize::quantValueToFraction(
-            opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
+    }
+}
 
-        Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
-                   "quantizeAllTracks", "Last tick is less than max note off time");
+void quantizeTrack(MTrack& mtrack,
+                   const TimeSigMap* sigmap,
+                   const ReducedFraction& lastTick)
+{
+    auto& opers = midiImportOperations;
 
-        MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
+    if (mtrack.chords.empty()) {
+        return;
+    }
+    // pass current track index through MidiImportOperations
+    // for further usage
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
 
-        if (mtrack.mtrack->drumTrack()) {
-            findAllTupletsForDrums(mtrack, sigmap, basicQuant);
-        } else {
-            MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
-        }
+    const auto basicQuant = Quantize::quantValueToFraction(
+        opers.data()->trackOpers.quantValue.value(mtrack.indexOfOperation));
 
-        Q_ASSERT_X(!doNotesOverlap(track.second),
-                   "quantizeAllTracks",
-                   "There are overlapping notes of the same voice that is incorrect");
+    Q_ASSERT_X(MChord::isLastTickValid(lastTick, mtrack.chords),
+               "quantizeTrack", "Last tick is less than max note off time");
 
-        // (4/3 of the smallest duration) tol is less sensitive
-        // to on time inaccuracies than 1/2 earlier
-        MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
-        Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
-        MidiTuplet::removeEmptyTuplets(mtrack);
+    MChord::setBarIndexes(mtrack.chords, basicQuant, lastTick, sigmap);
 
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
-                   "quantizeAllTracks", "Tuplet chord/note is outside tuplet "
-                                        "or non-tuplet chord/note is inside tuplet");
+    if (mtrack.mtrack->drumTrack()) {
+        findAllTupletsForDrums(mtrack, sigmap, basicQuant);
+    } else {
+        MidiTuplet::findAllTuplets(mtrack.tuplets, mtrack.chords, sigmap, basicQuant);
     }
+
+    Q_ASSERT_X(!doNotesOverlap(mtrack),
+               "quantizeTrack",
+               "There are overlapping notes of the same voice that is incorrect");
+
+    // (4/3 of the smallest duration) tol is less sensitive
+    // to on time inaccuracies than 1/2 earlier
+    MChord::collectChords(mtrack, { 2, 1 }, { 4, 3 });
+    Quantize::quantizeChords(mtrack.chords, sigmap, basicQuant);
+    MidiTuplet::removeEmptyTuplets(mtrack);
+
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(mtrack.chords, mtrack.tuplets),
+               "quantizeTrack", "Tuplet chord/note is outside tuplet "
+                                "or non-tuplet chord/note is inside tuplet");
 }
 
 //---------------------------------------------------------
@@ -1091,6 +1104,212 @@ ReducedFraction findLastChordTick(const std::multimap<int, MTrack>& tracks)
     return lastTick;
 }
 
+//---------------------------------------------------------
+//   track stages
+//    Quantization, voice separation and simplification look
+//    at one track only, so when the user changes options in
+//    the import panel their results can be taken from
+//    the previous processing for every track whose input and
+//    options are the same.
+//---------------------------------------------------------
+
+template<typename T>
+void addToHash(QCryptographicHash& hash, T value)
+{
+    hash.addData(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void addToHash(QCryptographicHash& hash, const ReducedFraction& value)
+{
+    addToHash(hash, value.numerator());
+    addToHash(hash, value.denominator());
+}
+
+// returns empty key if the track results should not be cached
+
+QByteArray trackStagesKey(int trackKey,
+                          const MTrack& mtrack,
+                          const TimeSigMap* sigmap,
+                          const ReducedFraction& lastTick)
+{
+    if (!mtrack.tuplets.empty()) {
+        return QByteArray();
+    }
+    const auto& opers = midiImportOperations.data()->trackOpers;
+    const int i = mtrack.indexOfOperation;
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    addToHash(hash, lastTick);
+    for (const auto& sig: *sigmap) {
+        addToHash(hash, sig.first);
+        addToHash(hash, sig.second.timesig().numerator());
+        addToHash(hash, sig.second.timesig().denominator());
+    }
+    addToHash(hash, opers.isHumanPerformance.value());
+    addToHash(hash, opers.measureCount2xLess.value());
+    addToHash(hash, int(opers.timeSigNumerator.value()));
+    addToHash(hash, int(opers.timeSigDenominator.value()));
+
+    addToHash(hash, opers.isDrumTrack.value(i));
+    addToHash(hash, int(opers.quantValue.value(i)));
+    addToHash(hash, opers.searchTuplets.value(i));
+    addToHash(hash, opers.search2plets.value(i));
+    addToHash(hash, opers.search3plets.value(i));
+    addToHash(hash, opers.search4plets.value(i));
+    addToHash(hash, opers.search5plets.value(i));
+    addToHash(hash, opers.search7plets.value(i));
+    addToHash(hash, opers.search9plets.value(i));
+    addToHash(hash, opers.useDots.value(i));
+    addToHash(hash, opers.simplifyDurations.value(i));
+    addToHash(hash, opers.showStaccato.value(i));
+    addToHash(hash, opers.doStaffSplit.value(i));
+    addToHash(hash, int(opers.maxVoiceCount.value(i)));
+    addToHash(hash, opers.removeDrumRests.value(i));
+
+    addToHash(hash, trackKey);
+    addToHash(hash, i);
+    addToHash(hash, mtrack.program);
+    addToHash(hash, mtrack.mtrack);
+    addToHash(hash, mtrack.mtrack->drumTrack());
+    for (const auto& chord: mtrack.chords) {
+        addToHash(hash, chord.first);
+        addToHash(hash, chord.second.voice);
+        addToHash(hash, chord.second.isInTuplet);
+        addToHash(hash, chord.second.barIndex);
+        addToHash(hash, chord.second.notes.size());
+        for (const auto& note: chord.second.notes) {
+            addToHash(hash, note.pitch);
+            addToHash(hash, note.velo);
+            addToHash(hash, note.offTime);
+            addToHash(hash, note.staccato);
+            addToHash(hash, note.isInTuplet);
+            addToHash(hash, note.offTimeQuant);
+            addToHash(hash, note.origOnTime);
+        }
+    }
+    return hash.result();
+}
+
+// returns true if voices of the track were separated
+
+bool separateTrackStages(MTrack& mtrack,
+                         const TimeSigMap* sigmap,
+                         const ReducedFraction& lastTick)
+{
+    quantizeTrack(mtrack, sigmap, lastTick);
+    MChord::removeOverlappingNotes(mtrack);
+
+    Q_ASSERT_X(!doNotesOverlap(mtrack),
+               "separateTrackStages", "There are overlapping notes of the same voice that is incorrect");
+    Q_ASSERT_X(noTooShortNotes(mtrack),
+               "separateTrackStages", "There are notes of length < min allowed duration");
+
+    MChord::mergeChordsWithEqualOnTimeAndVoice(mtrack);
+    Simplify::simplifyDurationsNotDrums(mtrack, sigmap);
+    return MidiVoice::separateVoices(mtrack, sigmap);
+}
+
+void finishTrackStages(MTrack& mtrack,
+                       const TimeSigMap* sigmap,
+                       bool anyVoicesSeparated)
+{
+    if (anyVoicesSeparated) {
+        Simplify::simplifyDurationsNotDrums(mtrack, sigmap);        // again
+    }
+    Simplify::simplifyDurationsForDrums(mtrack, sigmap);
+    MChord::splitUnequalChords(mtrack);
+}
+
+// tracks are processed in parallel, the results don't depend on the order
+
+void processTrackStages(std::multimap<int, MTrack>& tracks,
+                        const TimeSigMap* sigmap,
+                        const ReducedFraction& lastTick)
+{
+    struct TrackJob {
+        std::multimap<int, MTrack>::iterator track;
+        QByteArray key;
+        MidiOperations::TrackStages* stages = nullptr;
+    };
+    std::vector<TrackJob> jobs;
+    for (auto it = tracks.begin(); it != tracks.end(); ++it) {
+        TrackJob job;
+        job.track = it;
+        jobs.push_back(job);
+    }
+    QtConcurrent::blockingMap(jobs, [sigmap, lastTick](TrackJob& job) {
+        job.key = trackStagesKey(job.track->first, job.track->second, sigmap, lastTick);
+    });
+
+    auto& cache = midiImportOperations.data()->trackStages;
+    // entries of tracks that are gone are dropped with the old cache
+    std::map<QByteArray, MidiOperations::TrackStages> newCache;
+    std::list<MidiOperations::TrackStages> uncached;
+    // tracks with equal keys share their stages, each is computed once
+    std::vector<TrackJob> separateJobs;
+
+    for (auto& job: jobs) {
+        if (job.key.isEmpty()) {
+            uncached.emplace_back();
+            job.stages = &uncached.back();
+        } else {
+            auto it = newCache.find(job.key);
+            if (it != newCache.end()) {
+                job.stages = &it->second;
+                continue;
+            }
+            const auto oldIt = cache.find(job.key);
+            it = newCache.insert({ job.key, oldIt != cache.end()
+                                   ? std::move(oldIt->second) : MidiOperations::TrackStages() }).first;
+            job.stages = &it->second;
+        }
+        if (!job.stages->isSeparated) {
+            separateJobs.push_back(job);
+        }
+    }
+
+    QtConcurrent::blockingMap(separateJobs, [sigmap, lastTick](TrackJob& job) {
+        MidiOperations::TrackStages* s = job.stages;
+        s->separated = job.track->second;
+        s->voicesSeparated = separateTrackStages(s->separated, sigmap, lastTick);
+        s->isSeparated = true;
+    });
+
+    bool anyVoicesSeparated = false;
+    for (const auto& job: jobs) {
+        if (job.stages->voicesSeparated) {
+            anyVoicesSeparated = true;
+            break;
+        }
+    }
+
+    std::set<MidiOperations::TrackStages*> unfinished;
+    for (const auto& job: jobs) {
+        if (job.stages->finished.find(anyVoicesSeparated) == job.stages->finished.end()) {
+            unfinished.insert(job.stages);
+        }
+    }
+    std::vector<MidiOperations::TrackStages*> finishJobs(unfinished.begin(), unfinished.end());
+    QtConcurrent::blockingMap(finishJobs, [sigmap, anyVoicesSeparated](MidiOperations::TrackStages* s) {
+        MTrack finished = s->separated;
+        finishTrackStages(finished, sigmap, anyVoicesSeparated);
+        s->finished.insert({ anyVoicesSeparated, finished });
+    });
+
+    for (auto& job: jobs) {
+        // take only the processed chords, the rest of the track
+        // comes from this processing; the copy re-points the tuplet
+        // iterators of its chords and notes into its own tuplets
+        // (see MTrack::updateTupletsFromChords), so after the swap
+        // they refer to the tuplets of the track, not of the cache
+        MTrack result = job.stages->finished.find(anyVoicesSeparated)->second;
+        job.track->second.chords.swap(result.chords);
+        job.track->second.tuplets.swap(result.tuplets);
+    }
+
+    cache.swap(newCache);
+}
+
 QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
 {
     auto* sigmap = score->sigmap();
@@ -1146,21 +1365,8 @@ QList<MTrack> convertMidi(Score* score, const MidiFile* mf)
     MidiDrum::splitDrumVoices(tracks);
     MidiDrum::splitDrumTracks(tracks);
     ReducedFraction lastTick = findLastChordTick(tracks);
-    quantizeAllTracks(tracks, sigmap, lastTick);
-    MChord::removeOverlappingNotes(tracks);
-
-    Q_ASSERT_X(!doNotesOverlap(tracks),
-               "convertMidi", "There are overlapping notes of the same voice that is incorrect");
-    Q_ASSERT_X(noTooShortNotes(tracks),
-               "convertMidi", "There are notes of length < min allowed duration");
-
-    MChord::mergeChordsWithEqualOnTimeAndVoice(tracks);
-    Simplify::simplifyDurationsNotDrums(tracks, sigmap);
-    if (MidiVoice::separateVoices(tracks, sigmap)) {
-        Simplify::simplifyDurationsNotDrums(tracks, sigmap);        // again
-    }
-    Simplify::simplifyDurationsForDrums(tracks, sigmap);
-    MChord::splitUnequalChords(tracks);
+    setDrumTrackOperations(tracks);
+    processTrackStages(tracks, sigmap, lastTick);
     // no more track insertion/reordering/deletion from now
     QList<MTrack> trackList = prepareTrackList(tracks);
     MidiInstr::setGrandStaffProgram(trackList);
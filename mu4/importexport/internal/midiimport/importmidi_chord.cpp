@@ -135,73 +135,78 @@ void removeOverlappingNotes(QList<MidiNote>& notes)
 
 // remove overlapping notes with the same pitch
 
-void removeOverlappingNotes(std::multimap<int, MTrack>& tracks)
+void removeOverlappingNotes(MTrack& mtrack)
 {
-    for (auto& track: tracks) {
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
-        }
+    auto& chords = mtrack.chords;
+    if (chords.empty()) {
+        return;
+    }
 
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, track.second.tuplets),
-                   "MChord::removeOverlappingNotes", "Tuplet chord/note is outside tuplet "
-                                                     "or non-tuplet chord/note is inside tuplet before overlaps remove");
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
+               "MChord::removeOverlappingNotes", "Tuplet chord/note is outside tuplet "
+                                                 "or non-tuplet chord/note is inside tuplet before overlaps remove");
 
-        for (auto i1 = chords.begin(); i1 != chords.end();) {
-            const auto& onTime1 = i1->first;
-            auto& chord1 = i1->second;
-            removeOverlappingNotes(chord1.notes);
+    for (auto i1 = chords.begin(); i1 != chords.end();) {
+        const auto& onTime1 = i1->first;
+        auto& chord1 = i1->second;
+        removeOverlappingNotes(chord1.notes);
 
-            for (auto note1It = chord1.notes.begin(); note1It != chord1.notes.end();) {
-                auto& note1 = *note1It;
+        for (auto note1It = chord1.notes.begin(); note1It != chord1.notes.end();) {
+            auto& note1 = *note1It;
 
-                for (auto i2 = std::next(i1); i2 != chords.end(); ++i2) {
-                    const auto& onTime2 = i2->first;
-                    if (onTime2 >= note1.offTime) {
-                        break;
-                    }
-                    auto& chord2 = i2->second;
-                    if (chord1.voice != chord2.voice) {
+            for (auto i2 = std::next(i1); i2 != chords.end(); ++i2) {
+                const auto& onTime2 = i2->first;
+                if (onTime2 >= note1.offTime) {
+                    break;
+                }
+                auto& chord2 = i2->second;
+                if (chord1.voice != chord2.voice) {
+                    continue;
+                }
+                for (auto& note2: chord2.notes) {
+                    if (note2.pitch != note1.pitch) {
                         continue;
                     }
-                    for (auto& note2: chord2.notes) {
-                        if (note2.pitch != note1.pitch) {
-                            continue;
+                    // overlapping notes found
+                    note1.offTime = onTime2;
+                    if (!note1.isInTuplet && chord2.isInTuplet) {
+                        if (note1.offTime > chord2.tuplet->second.onTime) {
+                            note1.isInTuplet = true;
+                            note1.tuplet = chord2.tuplet;
                         }
-                        // overlapping notes found
-                        note1.offTime = onTime2;
-                        if (!note1.isInTuplet && chord2.isInTuplet) {
-                            if (note1.offTime > chord2.tuplet->second.onTime) {
-                                note1.isInTuplet = true;
-                                note1.tuplet = chord2.tuplet;
-                            }
-                        } else if (note1.isInTuplet && !chord2.isInTuplet) {
-                            note1.isInTuplet = false;
-                        }
-
-                        i2 = std::prev(chords.end());
-                        break;
+                    } else if (note1.isInTuplet && !chord2.isInTuplet) {
+                        note1.isInTuplet = false;
                     }
+
+                    i2 = std::prev(chords.end());
+                    break;
                 }
-                if (note1.offTime - onTime1 < MChord::minAllowedDuration()) {
-                    note1It = chord1.notes.erase(note1It);
-                    qDebug("Midi import: removeOverlappingNotes: note was removed");
-                    continue;
-                }
-                ++note1It;
             }
-            if (chord1.notes.isEmpty()) {
-                i1 = chords.erase(i1);
+            if (note1.offTime - onTime1 < MChord::minAllowedDuration()) {
+                note1It = chord1.notes.erase(note1It);
+                qDebug("Midi import: removeOverlappingNotes: note was removed");
                 continue;
             }
-            ++i1;
+            ++note1It;
         }
+        if (chord1.notes.isEmpty()) {
+            i1 = chords.erase(i1);
+            continue;
+        }
+        ++i1;
+    }
+
+    MidiTuplet::removeEmptyTuplets(mtrack);
 
-        MidiTuplet::removeEmptyTuplets(track.second);
+    Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
+               "MChord::removeOverlappingNotes", "Tuplet chord/note is outside tuplet "
+                                                 "or non-tuplet chord/note is inside tuplet after overlaps remove");
+}
 
-        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, track.second.tuplets),
-                   "MChord::removeOverlappingNotes", "Tuplet chord/note is outside tuplet "
-                                                     "or non-tuplet chord/note is inside tuplet after overlaps remove");
+void removeOverlappingNotes(std::multimap<int, MTrack>& tracks)
+{
+    for (auto& track: tracks) {
+        removeOverlappingNotes(track.second);
     }
 }
 
@@ -454,41 +459,46 @@ void sortNotesByLength(std::multimap<ReducedFraction, MidiChord>& chords)
 // and separate them into different chords
 // so all notes inside every chord will have equal lengths
 
-void splitUnequalChords(std::multimap<int, MTrack>& tracks)
+void splitUnequalChords(MTrack& mtrack)
 {
-    for (auto& track: tracks) {
-        std::vector<std::pair<ReducedFraction, MidiChord> > newChordEvents;
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
-        }
-        sortNotesByLength(chords);
-        for (auto& chordEvent: chords) {
-            auto& chord = chordEvent.second;
-            auto& notes = chord.notes;
-            ReducedFraction offTime;
-            for (auto it = notes.begin(); it != notes.end();) {
-                if (it == notes.begin()) {
-                    offTime = it->offTime;
-                } else {
-                    ReducedFraction newOffTime = it->offTime;
-                    if (newOffTime != offTime) {
-                        MidiChord newChord(chord);
-                        newChord.notes.clear();
-                        for (int j = it - notes.begin(); j > 0; --j) {
-                            newChord.notes.push_back(notes[j - 1]);
-                        }
-                        newChordEvents.push_back({ chordEvent.first, newChord });
-                        it = notes.erase(notes.begin(), it);
-                        continue;
+    std::vector<std::pair<ReducedFraction, MidiChord> > newChordEvents;
+    auto& chords = mtrack.chords;
+    if (chords.empty()) {
+        return;
+    }
+    sortNotesByLength(chords);
+    for (auto& chordEvent: chords) {
+        auto& chord = chordEvent.second;
+        auto& notes = chord.notes;
+        ReducedFraction offTime;
+        for (auto it = notes.begin(); it != notes.end();) {
+            if (it == notes.begin()) {
+                offTime = it->offTime;
+            } else {
+                ReducedFraction newOffTime = it->offTime;
+                if (newOffTime != offTime) {
+                    MidiChord newChord(chord);
+                    newChord.notes.clear();
+                    for (int j = it - notes.begin(); j > 0; --j) {
+                        newChord.notes.push_back(notes[j - 1]);
                     }
+                    newChordEvents.push_back({ chordEvent.first, newChord });
+                    it = notes.erase(notes.begin(), it);
+                    continue;
                 }
-                ++it;
             }
+            ++it;
         }
-        for (const auto& event: newChordEvents) {
-            chords.insert(event);
-        }
+    }
+    for (const auto& event: newChordEvents) {
+        chords.insert(event);
+    }
+}
+
+void splitUnequalChords(std::multimap<int, MTrack>& tracks)
+{
+    for (auto& track: tracks) {
+        splitUnequalChords(track.second);
     }
 }
 
@@ -508,32 +518,37 @@ ReducedFraction findMinDuration(const ReducedFraction& onTime,
     return len;
 }
 
-void mergeChordsWithEqualOnTimeAndVoice(std::multimap<int, MTrack>& tracks)
+void mergeChordsWithEqualOnTimeAndVoice(MTrack& mtrack)
 {
-    for (auto& track: tracks) {
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
+    auto& chords = mtrack.chords;
+    if (chords.empty()) {
+        return;
+    }
+    // the key is pair<onTime, voice>
+    std::map<std::pair<ReducedFraction, int>,
+             std::multimap<ReducedFraction, MidiChord>::iterator> onTimes;
+
+    for (auto it = chords.begin(); it != chords.end();) {
+        const auto& onTime = it->first;
+        const int voice = it->second.voice;
+        auto fit = onTimes.find({ onTime, voice });
+        if (fit == onTimes.end()) {
+            onTimes.insert({ { onTime, voice }, it });
+        } else {
+            auto& oldNotes = fit->second->second.notes;
+            auto& newNotes = it->second.notes;
+            oldNotes.append(newNotes);
+            it = chords.erase(it);
             continue;
         }
-        // the key is pair<onTime, voice>
-        std::map<std::pair<ReducedFraction, int>,
-                 std::multimap<ReducedFraction, MidiChord>::iterator> onTimes;
-
-        for (auto it = chords.begin(); it != chords.end();) {
-            const auto& onTime = it->first;
-            const int voice = it->second.voice;
-            auto fit = onTimes.find({ onTime, voice });
-            if (fit == onTimes.end()) {
-                onTimes.insert({ { onTime, voice }, it });
-            } else {
-                auto& oldNotes = fit->second->second.notes;
-                auto& newNotes = it->second.notes;
-                oldNotes.append(newNotes);
-                it = chords.erase(it);
-                continue;
-            }
-            ++it;
-        }
+        ++it;
+    }
+}
+
+void mergeChordsWithEqualOnTimeAndVoice(std::multimap<int, MTrack>& tracks)
+{
+    for (auto& track: tracks) {
+        mergeChordsWithEqualOnTimeAndVoice(track.second);
     }
 }
 
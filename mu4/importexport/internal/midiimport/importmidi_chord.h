@@ -109,8 +109,11 @@ void collectChords(
 void collectChords(
     MTrack& track,const ReducedFraction& humanTolCoeff,const ReducedFraction& nonHumanTolCoeff);
 
+void removeOverlappingNotes(MTrack& mtrack);
 void removeOverlappingNotes(std::multimap<int, MTrack>& tracks);
+void mergeChordsWithEqualOnTimeAndVoice(MTrack& mtrack);
 void mergeChordsWithEqualOnTimeAndVoice(std::multimap<int, MTrack>& tracks);
+void splitUnequalChords(MTrack& mtrack);
 void splitUnequalChords(std::multimap<int, MTrack>& tracks);
 int chordAveragePitch(const QList<MidiNote>& notes, int beg, int end);
 int chordAveragePitch(const QList<MidiNote>& notes);
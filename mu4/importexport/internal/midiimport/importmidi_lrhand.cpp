@@ -5,6 +5,8 @@
 #include "importmidi_operations.h"
 #include "mscore/preferences.h"
 
+#include <QtConcurrent>
+
 namespace Ms {
 namespace LRHand {
 bool needToSplit(const std::multimap<ReducedFraction, MidiChord>& chords,
@@ -366,19 +368,19 @@ std::vector<ChordSplitData> findSplits(std::multimap<ReducedFraction, MidiChord>
 
 void insertNewLeftHandTrack(std::multimap<int, MTrack>& tracks,
                             std::multimap<int, MTrack>::iterator& it,
-                            const std::multimap<ReducedFraction, MidiChord>& leftHandChords)
+                            std::multimap<ReducedFraction, MidiChord>& leftHandChords)
 {
     auto leftHandTrack = it->second;
-    leftHandTrack.chords = leftHandChords;
+    leftHandTrack.chords.swap(leftHandChords);
     it = tracks.insert({ it->first, leftHandTrack });
 }
 
 // maybe todo later: if range of right-hand chords > OCTAVE
 // => assign all bottom right-hand chords to another, third track
 
-void splitStaff(std::multimap<int, MTrack>& tracks, std::multimap<int, MTrack>::iterator& it)
+void splitStaff(std::multimap<ReducedFraction, MidiChord>& chords,
+                std::multimap<ReducedFraction, MidiChord>& leftHandChords)
 {
-    auto& chords = it->second.chords;
     if (chords.empty()) {
         return;
     }
@@ -387,12 +389,7 @@ void splitStaff(std::multimap<int, MTrack>& tracks, std::multimap<int, MTrack>::
 
     Q_ASSERT_X(!splits.empty(), "LRHand::splitStaff", "Empty splits array");
 
-    std::multimap<ReducedFraction, MidiChord> leftHandChords;
     splitChords(splits, leftHandChords, chords);
-
-    if (!leftHandChords.empty()) {
-        insertNewLeftHandTrack(tracks, it, leftHandChords);
-    }
 }
 
 void addNewLeftHandChord(std::multimap<ReducedFraction, MidiChord>& leftHandChords,
@@ -406,18 +403,34 @@ void addNewLeftHandChord(std::multimap<ReducedFraction, MidiChord>& leftHandChor
 
 void splitIntoLeftRightHands(std::multimap<int, MTrack>& tracks)
 {
+    struct TrackSplit {
+        std::multimap<int, MTrack>::iterator it;
+        std::multimap<ReducedFraction, MidiChord> leftHandChords;
+    };
+    std::vector<TrackSplit> trackSplits;
+
+    const auto& opers = midiImportOperations.data()->trackOpers;
     for (auto it = tracks.begin(); it != tracks.end(); ++it) {
         if (it->second.mtrack->drumTrack() || it->second.chords.empty()) {
             continue;
         }
-        const auto& opers = midiImportOperations.data()->trackOpers;
-        // iterator 'it' will change after track split to ++it
+        if (opers.doStaffSplit.value(it->second.indexOfOperation)) {
+            trackSplits.push_back({ it, {} });
+        }
+    }
+    // tracks are split independently of each other,
+    // only the insertion of the new left-hand tracks is serial
+    QtConcurrent::blockingMap(trackSplits, [](TrackSplit& split) {
+        splitStaff(split.it->second.chords, split.leftHandChords);
+    });
+
+    for (auto& split: trackSplits) {
         // C++11 guarantees that newely inserted item with equal key will go after:
         //    "The relative ordering of elements with equivalent keys is preserved,
         //     and newly inserted elements follow those with equivalent keys
         //     already in the container"
-        if (opers.doStaffSplit.value(it->second.indexOfOperation)) {
-            splitStaff(tracks, it);
+        if (!split.leftHandChords.empty()) {
+            insertNewLeftHandTrack(tracks, split.it, split.leftHandChords);
         }
     }
 }
@@ -193,6 +193,16 @@ struct HumanBeatData
     bool measureCount2xLess = false;
 };
 
+// per-track results of the import stages that depend only on the track,
+// kept between processings of the file, see processTrackStages()
+struct TrackStages
+{
+    bool isSeparated = false;
+    bool voicesSeparated = false;
+    MTrack separated;                           // after voice separation
+    std::map<bool, MTrack> finished;            // <voices of any track were separated, final track>
+};
+
 struct FileData
 {
     MidiFile midiFile;
@@ -212,6 +222,7 @@ struct FileData
     QList<std::multimap<ReducedFraction, std::string> > lyricTracks;
     std::multimap<ReducedFraction, QString> chordNames;
     HumanBeatData humanBeatData;
+    std::map<QByteArray, TrackStages> trackStages;     // <track input and operations digest, ...>
 };
 
 class Data
@@ -235,7 +246,8 @@ private:
 
     QString _currentMidiFile;
     QString _midiOperationsFile;
-    int _currentTrack = -1;
+    // per thread: per-track import stages of different tracks run in parallel
+    static thread_local int _currentTrack;
 
     std::map<QString, FileData> _data;      // <file name, tracks data>
 };
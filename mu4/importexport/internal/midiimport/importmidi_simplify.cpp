@@ -282,38 +282,42 @@ void minimizeNumberOfRests(
     }
 }
 
-void simplifyDurations(
-    std::multimap<int, MTrack>& tracks,
-    const TimeSigMap* sigmap,
-    bool simplifyDrumTracks)
+void simplifyDurations(MTrack& mtrack, const TimeSigMap* sigmap, bool simplifyDrumTracks)
 {
     auto& opers = midiImportOperations;
 
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
-        if (mtrack.mtrack->drumTrack() != simplifyDrumTracks) {
-            continue;
-        }
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
-        }
+    if (mtrack.mtrack->drumTrack() != simplifyDrumTracks) {
+        return;
+    }
+    auto& chords = mtrack.chords;
+    if (chords.empty()) {
+        return;
+    }
 
-        if (opers.data()->trackOpers.simplifyDurations.value(mtrack.indexOfOperation)) {
-            MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+    if (opers.data()->trackOpers.simplifyDurations.value(mtrack.indexOfOperation)) {
+        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
 
-            Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
-                       "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
-                                                      "or non-tuplet chord/note is inside tuplet before simplification");
+        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
+                   "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
+                                                  "or non-tuplet chord/note is inside tuplet before simplification");
 
-            minimizeNumberOfRests(chords, sigmap, mtrack.tuplets, mtrack.mtrack->drumTrack());
-            // empty tuplets may appear after simplification
-            MidiTuplet::removeEmptyTuplets(mtrack);
+        minimizeNumberOfRests(chords, sigmap, mtrack.tuplets, mtrack.mtrack->drumTrack());
+        // empty tuplets may appear after simplification
+        MidiTuplet::removeEmptyTuplets(mtrack);
 
-            Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
-                       "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
-                                                      "or non-tuplet chord/note is inside tuplet after simplification");
-        }
+        Q_ASSERT_X(MidiTuplet::areTupletRangesOk(chords, mtrack.tuplets),
+                   "Simplify::simplifyDurations", "Tuplet chord/note is outside tuplet "
+                                                  "or non-tuplet chord/note is inside tuplet after simplification");
+    }
+}
+
+void simplifyDurations(
+    std::multimap<int, MTrack>& tracks,
+    const TimeSigMap* sigmap,
+    bool simplifyDrumTracks)
+{
+    for (auto& track: tracks) {
+        simplifyDurations(track.second, sigmap, simplifyDrumTracks);
     }
 }
 
@@ -326,5 +330,15 @@ void simplifyDurationsNotDrums(std::multimap<int, MTrack>& tracks, const TimeSig
 {
     simplifyDurations(tracks, sigmap, false);
 }
+
+void simplifyDurationsForDrums(MTrack& mtrack, const TimeSigMap* sigmap)
+{
+    simplifyDurations(mtrack, sigmap, true);
+}
+
+void simplifyDurationsNotDrums(MTrack& mtrack, const TimeSigMap* sigmap)
+{
+    simplifyDurations(mtrack, sigmap, false);
+}
 } // Simplify
 } // Ms
@@ -8,6 +8,8 @@ class TimeSigMap;
 namespace Simplify {
 void simplifyDurationsForDrums(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap);
 void simplifyDurationsNotDrums(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap);
+void simplifyDurationsForDrums(MTrack& mtrack, const TimeSigMap* sigmap);
+void simplifyDurationsNotDrums(MTrack& mtrack, const TimeSigMap* sigmap);
 } // Simplify
 } // Ms
 
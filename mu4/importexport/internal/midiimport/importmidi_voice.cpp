@@ -1036,60 +1036,68 @@ void sortVoices(
     }
 }
 
-bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
+bool separateVoices(MTrack& mtrack, const TimeSigMap* sigmap)
 {
     auto& opers = midiImportOperations;
     bool changed = false;
 
-    for (auto& track: tracks) {
-        MTrack& mtrack = track.second;
-        if (mtrack.mtrack->drumTrack()) {
-            continue;
-        }
-        auto& chords = track.second.chords;
-        if (chords.empty()) {
-            continue;
+    if (mtrack.mtrack->drumTrack()) {
+        return false;
+    }
+    auto& chords = mtrack.chords;
+    if (chords.empty()) {
+        return false;
+    }
+    const int userVoiceCount = toIntVoiceCount(
+        opers.data()->trackOpers.maxVoiceCount.value(mtrack.indexOfOperation));
+    // pass current track index through MidiImportOperations
+    // for further usage
+    MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
+
+    if (userVoiceCount > 1 && userVoiceCount <= voiceLimit()) {
+        Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+                   "MidiVoice::separateVoices",
+                   "Not all tuplets are referenced in chords or notes "
+                   "before voice separation");
+        Q_ASSERT_X(areVoicesSame(mtrack.chords),
+                   "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                                "before voice separation");
+
+        if (doVoiceSeparation(mtrack.chords, sigmap, mtrack.tuplets)) {
+            changed = true;
         }
-        const int userVoiceCount = toIntVoiceCount(
-            opers.data()->trackOpers.maxVoiceCount.value(mtrack.indexOfOperation));
-        // pass current track index through MidiImportOperations
-        // for further usage
-        MidiOperations::CurrentTrackSetter setCurrentTrack{ opers, mtrack.indexOfOperation };
-
-        if (userVoiceCount > 1 && userVoiceCount <= voiceLimit()) {
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "before voice separation");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "before voice separation");
-
-            if (doVoiceSeparation(mtrack.chords, sigmap, mtrack.tuplets)) {
-                changed = true;
-            }
 
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "after voice separation, before voice sort");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "after voice separation, before voice sort");
-
-            sortVoices(mtrack.chords, sigmap);
-
-            Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
-                       "MidiVoice::separateVoices",
-                       "Not all tuplets are referenced in chords or notes "
-                       "after voice sort");
-            Q_ASSERT_X(areVoicesSame(mtrack.chords),
-                       "MidiVoice::separateVoices", "Different voices of chord and tuplet "
-                                                    "after voice sort");
-        }
+        Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+                   "MidiVoice::separateVoices",
+                   "Not all tuplets are referenced in chords or notes "
+                   "after voice separation, before voice sort");
+        Q_ASSERT_X(areVoicesSame(mtrack.chords),
+                   "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                                "after voice separation, before voice sort");
+
+        sortVoices(mtrack.chords, sigmap);
+
+        Q_ASSERT_X(MidiTuplet::areAllTupletsReferenced(mtrack.chords, mtrack.tuplets),
+                   "MidiVoice::separateVoices",
+                   "Not all tuplets are referenced in chords or notes "
+                   "after voice sort");
+        Q_ASSERT_X(areVoicesSame(mtrack.chords),
+                   "MidiVoice::separateVoices", "Different voices of chord and tuplet "
+                                                "after voice sort");
     }
 
     return changed;
 }
+
+bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap)
+{
+    bool changed = false;
+    for (auto& track: tracks) {
+        if (separateVoices(track.second, sigmap)) {
+            changed = true;
+        }
+    }
+    return changed;
+}
 } // namespace MidiVoice
 } // namespace Ms
@@ -15,6 +15,7 @@ struct TupletData;
 namespace MidiVoice {
 int toIntVoiceCount(MidiOperations::VoiceCount value);
 int voiceLimit();
+bool separateVoices(MTrack& mtrack, const TimeSigMap* sigmap);
 bool separateVoices(std::multimap<int, MTrack>& tracks, const TimeSigMap* sigmap);
 
 bool splitChordToVoice(
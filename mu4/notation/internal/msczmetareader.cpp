@@ -334,16 +334,17 @@ QString MsczMetaReader::readRootFile(MQZipReader* zipReader) const
     return rootfile;
 }
 
-QPixmap MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
+QImage MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
 {
     QByteArray thumbnailBuffer = zipReader->fileData("Thumbnails/thumbnail.png");
 
     if (thumbnailBuffer.isEmpty()) {
         LOGD() << "Can't find thumbnail";
-        return QPixmap();
+        return QImage();
     }
 
-    QPixmap thumbnail;
+    //! NOTE QImage, not QPixmap: meta is also read on worker threads
+    QImage thumbnail;
     thumbnail.loadFromData(thumbnailBuffer, "PNG");
 
     return thumbnail;
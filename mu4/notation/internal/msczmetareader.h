@@ -62,7 +62,7 @@ private:
     RawMeta doReadBox(QXmlStreamReader& xmlReader) const;
     RetVal<Meta> loadCompressedMsc(const mu::io::path& filePath) const;
     QString readRootFile(MQZipReader* zipReader) const;
-    QPixmap loadThumbnail(MQZipReader* zipReader) const;
+    QImage loadThumbnail(MQZipReader* zipReader) const;
     RawMeta doReadRawMeta(QXmlStreamReader& xmlReader) const;
     QString formatFromXml(const QString& xml) const;
 
@@ -134,14 +134,14 @@ void Notation::paint(QPainter* p, const QRect&)
 
     p->fillRect(page->bbox(), QColor("#ffffff"));
 
-    QList<Ms::Element*> ell = page->elements();
-    for (const Ms::Element* e : ell) {
+    for (const Ms::RenderItem& ri : page->renderList()) {
+        const Ms::Element* e = ri.element;
         if (!e->visible()) {
             continue;
         }
 
         e->itemDiscovered = false;
-        QPointF pos(e->pagePos());
+        QPointF pos(ri.pos);
 
         p->translate(pos);
 
@@ -18,6 +18,7 @@
 //=============================================================================
 #include "notationplayback.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "log.h"
@@ -37,6 +38,7 @@
 #include "libmscore/chordrest.h"
 #include "libmscore/chord.h"
 #include "libmscore/harmony.h"
+#include "libmscore/mscoreview.h"
 
 #include "audio/midi/event.h" //! TODO Remove me
 
@@ -46,6 +48,24 @@ using namespace mu::notation;
 using namespace mu::midi;
 
 static int MIN_CHUNK_SIZE(10); // measure
+static int PREFETCH_CHUNKS(2);
+
+//! NOTE Registered as a score viewer to learn about edits while the
+//! CmdState still holds the changed range
+class NotationPlayback::ScoreChangesListener : public Ms::MuseScoreView
+{
+public:
+    ScoreChangesListener(NotationPlayback* playback)
+        : m_playback(playback) {}
+
+    void dataChanged(const QRectF&) override {}
+    void updateAll() override { m_playback->onScoreChanged(); }
+    void drawBackground(QPainter*, const QRectF&) const override {}
+    const QRect geometry() const override { return QRect(); }
+
+private:
+    NotationPlayback* m_playback = nullptr;
+};
 
 NotationPlayback::NotationPlayback(IGetScore* getScore)
     : m_getScore(getScore)
@@ -53,10 +73,22 @@ NotationPlayback::NotationPlayback(IGetScore* getScore)
     m_midiStream = std::make_shared<MidiStream>();
     m_midiStream->isStreamingAllowed = true;
     m_midiStream->request.onReceive(this, [this](tick_t tick) { onChunkRequest(tick); });
+
+    m_scoreChangesListener = std::unique_ptr<ScoreChangesListener>(new ScoreChangesListener(this));
+
+    //! NOTE The score can only be read in the main thread, so chunks are
+    //! rendered ahead one per event loop iteration
+    m_prefetchTimer.setSingleShot(true);
+    m_prefetchTimer.setInterval(0);
+    QObject::connect(&m_prefetchTimer, &QTimer::timeout, [this]() { prefetchChunk(); });
 }
 
 NotationPlayback::~NotationPlayback()
 {
+    Ms::Score* score = m_getScore->score();
+    if (score) {
+        score->removeViewer(m_scoreChangesListener.get());
+    }
 }
 
 void NotationPlayback::init()
@@ -68,6 +100,10 @@ void NotationPlayback::init()
 
     m_midiRenderer = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score));
     m_midiRenderer->setMinChunkSize(MIN_CHUNK_SIZE);
+    m_chunks.clear();
+
+    score->removeViewer(m_scoreChangesListener.get());
+    score->addViewer(m_scoreChangesListener.get());
 
     QObject::connect(score, &Ms::Score::posChanged, [this](Ms::POS pos, int tick) {
         if (Ms::POS::CURRENT == pos) {
@@ -93,10 +129,13 @@ std::shared_ptr<MidiStream> NotationPlayback::midiStream() const
     makeInitData(m_midiStream->initData, score);
     midi::Chunk firstChunk;
     makeChunk(firstChunk, 0 /*fromTick*/);
+    const tick_t nextTick = firstChunk.endTick;
     m_midiStream->initData.chunks.insert({ firstChunk.beginTick, std::move(firstChunk) });
 
     m_midiStream->lastTick = score->lastMeasure()->endTick().ticks();
 
+    startPrefetch(nextTick);
+
     return m_midiStream;
 }
 
@@ -207,42 +246,130 @@ void NotationPlayback::onChunkRequest(tick_t tick)
 
     midi::Chunk chunk;
     makeChunk(chunk, tick);
+    const tick_t nextTick = chunk.endTick;
     m_midiStream->stream.send(chunk);
+
+    // the sequencer asks for the next chunk from where this one ends
+    startPrefetch(nextTick);
 }
 
 void NotationPlayback::makeChunk(midi::Chunk& chunk, tick_t fromTick) const
 {
-    Ms::EventMap msevents;
-
-    const Ms::MidiRenderer::Chunk mschunk = m_midiRenderer->chunkAt(fromTick);
-    if (!mschunk) {
-        return;
+    const midi::Chunk* cached = cachedChunk(fromTick);
+    if (cached) {
+        chunk = *cached;
     }
+}
 
+static void renderChunk(midi::Chunk& chunk, Ms::MidiRenderer* renderer, const Ms::MidiRenderer::Chunk& mschunk)
+{
     chunk.beginTick = mschunk.tick1();
     chunk.endTick = mschunk.tick2();
 
+    Ms::EventMap msevents;
     Ms::SynthesizerState synState;// = mscore->synthesizerState();
     Ms::MidiRenderer::Context ctx(synState);
     ctx.metronome = true;
     ctx.renderHarmony = true;
-    m_midiRenderer->renderChunk(mschunk, &msevents, ctx);
+    renderer->renderChunk(mschunk, &msevents, ctx);
 
+    //! NOTE The rendered events are already sorted, so each one goes to the end
     for (const auto& evp : msevents) {
-        tick_t tick = evp.first;
-        const Ms::NPlayEvent ev = evp.second;
+        const Ms::NPlayEvent& ev = evp.second;
 
         midi::EventType etype = static_cast<midi::EventType>(ev.type());
         if (midi::EventType::ME_INVALID == etype) {
             continue;
-        } else {
-            midi::Event e
-            { static_cast<channel_t>(ev.channel()),
-              etype,
-              ev.dataA(), ev.dataB()
-            };
+        }
+
+        chunk.events.emplace_hint(chunk.events.end(), evp.first,
+                                  Event(static_cast<channel_t>(ev.channel()), etype, ev.dataA(), ev.dataB()));
+    }
+}
+
+const midi::Chunk* NotationPlayback::cachedChunk(tick_t fromTick) const
+{
+    IF_ASSERT_FAILED(m_midiRenderer) {
+        return nullptr;
+    }
+
+    const Ms::MidiRenderer::Chunk mschunk = m_midiRenderer->chunkAt(fromTick);
+    if (!mschunk) {
+        return nullptr;
+    }
+
+    ChunkKey key;
+    key.tickOffset = mschunk.tickOffset();
+    key.tick1 = mschunk.tick1();
+    key.tick2 = mschunk.tick2();
+
+    auto it = m_chunks.find(key);
+    if (it == m_chunks.end()) {
+        midi::Chunk chunk;
+        renderChunk(chunk, m_midiRenderer.get(), mschunk);
+        it = m_chunks.insert({ key, std::move(chunk) }).first;
+    }
+
+    return &it->second;
+}
+
+void NotationPlayback::startPrefetch(tick_t fromTick) const
+{
+    m_prefetchTick = fromTick;
+    m_prefetchLeft = PREFETCH_CHUNKS;
+    m_prefetchTimer.start();
+}
 
-            chunk.events.insert({ tick, std::move(e) });
+void NotationPlayback::prefetchChunk()
+{
+    if (m_prefetchLeft <= 0 || m_prefetchTick >= m_midiStream->lastTick) {
+        return;
+    }
+
+    const midi::Chunk* chunk = cachedChunk(m_prefetchTick);
+    if (!chunk || chunk->endTick <= m_prefetchTick) {
+        return;
+    }
+
+    m_prefetchTick = chunk->endTick;
+    --m_prefetchLeft;
+    if (m_prefetchLeft > 0) {
+        m_prefetchTimer.start();
+    }
+}
+
+//! NOTE Called during Score::update(), before the CmdState is reset.
+//! Chunks from the edited range on are dropped: dynamics and spanners
+//! change the playback of the following measures, and notes tied into
+//! the range are rendered with the chunk before it.
+void NotationPlayback::onScoreChanged()
+{
+    Ms::Score* score = m_getScore->score();
+    if (!score || !m_midiRenderer) {
+        return;
+    }
+
+    m_midiRenderer->setScoreChanged();
+
+    const Ms::CmdState& cmdState = score->masterScore()->cmdState();
+    if (!cmdState.layoutRange() || cmdState.startTick() < Ms::Fraction(0, 1)) {
+        m_chunks.clear();
+        return;
+    }
+
+    const int editTick = cmdState.startTick().ticks();
+    int fromTick = editTick;
+    for (const auto& c : m_chunks) {
+        if (c.first.tick1 <= editTick && editTick < c.first.tick2) {
+            fromTick = std::min(fromTick, c.first.tick1);
+        }
+    }
+
+    for (auto it = m_chunks.begin(); it != m_chunks.end();) {
+        if (it->first.tick2 >= fromTick) {
+            it = m_chunks.erase(it);
+        } else {
+            ++it;
         }
     }
 }
@@ -19,7 +19,11 @@
 #ifndef MU_NOTATION_NOTATIONPLAYBACK_H
 #define MU_NOTATION_NOTATIONPLAYBACK_H
 
+#include <map>
 #include <memory>
+#include <tuple>
+
+#include <QTimer>
 
 #include "../inotationplayback.h"
 #include "igetscore.h"
@@ -63,8 +67,26 @@ private:
     void makeTempoMap(midi::TempoMap& tempos, const Ms::Score* score) const;
     void makeSynthMap(midi::SynthMap& synthMap, const Ms::Score* score) const;
 
+    class ScoreChangesListener;
+
+    // the MidiRenderer::Chunk a cached chunk was rendered from
+    struct ChunkKey {
+        int tickOffset = 0;
+        int tick1 = 0;
+        int tick2 = 0;
+
+        bool operator<(const ChunkKey& other) const
+        {
+            return std::tie(tickOffset, tick1, tick2) < std::tie(other.tickOffset, other.tick1, other.tick2);
+        }
+    };
+
     void onChunkRequest(midi::tick_t tick);
     void makeChunk(midi::Chunk& chunk, midi::tick_t fromTick) const;
+    const midi::Chunk* cachedChunk(midi::tick_t fromTick) const;
+    void startPrefetch(midi::tick_t fromTick) const;
+    void prefetchChunk();
+    void onScoreChanged();
 
     int instrumentBank(const Ms::Instrument* inst) const;
 
@@ -77,6 +99,12 @@ private:
     std::shared_ptr<midi::MidiStream> m_midiStream;
     std::unique_ptr<Ms::MidiRenderer> m_midiRenderer;
     async::Channel<int> m_playPositionTickChanged;
+
+    mutable std::map<ChunkKey, midi::Chunk> m_chunks;
+    std::unique_ptr<ScoreChangesListener> m_scoreChangesListener;
+    mutable QTimer m_prefetchTimer;
+    mutable midi::tick_t m_prefetchTick = 0;
+    mutable int m_prefetchLeft = 0;
 };
 }
 }
@@ -20,6 +20,8 @@ set(PALETTE_SRC
     ${CMAKE_CURRENT_LIST_DIR}/masterpalette.cpp
     ${CMAKE_CURRENT_LIST_DIR}/palettecreator.cpp
     ${CMAKE_CURRENT_LIST_DIR}/palettecreator.h
+    ${CMAKE_CURRENT_LIST_DIR}/paletteiconcache.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/paletteiconcache.h
     )
 
 set (PALETTE_UI
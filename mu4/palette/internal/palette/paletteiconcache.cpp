@@ -0,0 +1,148 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "paletteiconcache.h"
+
+#include <QtConcurrent>
+#include <QDir>
+#include <QSaveFile>
+
+#include "log.h"
+
+namespace Ms {
+static constexpr int MEMORY_CACHE_KB = 32 * 1024;
+static constexpr int MAX_DISK_ENTRIES = 4096;
+static const QString DPR_KEY("dpr");     // PNG does not store the device pixel ratio
+
+//---------------------------------------------------------
+//   pruneDiskCache
+///   Removes the least recently used icons once the disk
+///   cache holds more than MAX_DISK_ENTRIES of them.
+//---------------------------------------------------------
+
+static void pruneDiskCache(const QString& dirPath)
+{
+    QDir dir(dirPath);
+    const QFileInfoList files = dir.entryInfoList({ "*.png" }, QDir::Files, QDir::Time);
+    for (int i = MAX_DISK_ENTRIES; i < files.size(); ++i) {
+        QFile::remove(files[i].absoluteFilePath());
+    }
+}
+
+//---------------------------------------------------------
+//   writeDiskCache
+//---------------------------------------------------------
+
+static void writeDiskCache(const QString& path, const QImage& image)
+{
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG") || !file.commit()) {
+        LOGW() << "failed to write palette icon cache:" << path;
+    }
+}
+
+//---------------------------------------------------------
+//   PaletteIconCache
+//---------------------------------------------------------
+
+PaletteIconCache::PaletteIconCache()
+{
+    _pixmaps.setMaxCost(MEMORY_CACHE_KB);
+    _diskPool.setMaxThreadCount(1);
+
+    if (configuration()) {
+        _dirPath = configuration()->iconCachePath().toQString();
+    }
+
+    if (!_dirPath.isEmpty() && QDir().mkpath(_dirPath)) {
+        QtConcurrent::run(&_diskPool, pruneDiskCache, _dirPath);
+    } else {
+        _dirPath.clear();
+    }
+}
+
+PaletteIconCache::~PaletteIconCache()
+{
+    _diskPool.waitForDone();
+}
+
+//---------------------------------------------------------
+//   instance
+//---------------------------------------------------------
+
+PaletteIconCache* PaletteIconCache::instance()
+{
+    static PaletteIconCache cache;
+    return &cache;
+}
+
+//---------------------------------------------------------
+//   filePath
+//---------------------------------------------------------
+
+QString PaletteIconCache::filePath(const QByteArray& key) const
+{
+    return _dirPath + "/" + QString::fromLatin1(key.toHex()) + ".png";
+}
+
+//---------------------------------------------------------
+//   pixmap
+///   Returns a null pixmap if the icon has to be rendered.
+//---------------------------------------------------------
+
+QPixmap PaletteIconCache::pixmap(const QByteArray& key)
+{
+    if (const QPixmap* pm = _pixmaps.object(key)) {
+        return *pm;
+    }
+
+    if (_dirPath.isEmpty()) {
+        return QPixmap();
+    }
+
+    QImage image;
+    if (!image.load(filePath(key), "PNG")) {
+        return QPixmap();
+    }
+
+    bool ok = false;
+    const qreal dpr = image.text(DPR_KEY).toDouble(&ok);
+    image.setDevicePixelRatio(ok && dpr > 0.0 ? dpr : 1.0);
+
+    QPixmap pm = QPixmap::fromImage(image);
+    _pixmaps.insert(key, new QPixmap(pm), qMax(1, image.sizeInBytes() / 1024));
+    return pm;
+}
+
+//---------------------------------------------------------
+//   insert
+//---------------------------------------------------------
+
+void PaletteIconCache::insert(const QByteArray& key, const QPixmap& pixmap)
+{
+    QImage image = pixmap.toImage();
+    image.setText(DPR_KEY, QString::number(pixmap.devicePixelRatio()));
+    _pixmaps.insert(key, new QPixmap(pixmap), qMax(1, image.sizeInBytes() / 1024));
+
+    if (!_dirPath.isEmpty()) {
+        // PNG encoding is done off the GUI thread
+        QtConcurrent::run(&_diskPool, writeDiskCache, filePath(key), image);
+    }
+}
+} // namespace Ms
@@ -0,0 +1,63 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef __PALETTEICONCACHE_H__
+#define __PALETTEICONCACHE_H__
+
+#include <QCache>
+#include <QPixmap>
+#include <QThreadPool>
+
+#include "modularity/ioc.h"
+#include "mu4/palette/ipaletteconfiguration.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   PaletteIconCache
+///   Rendered palette cell icons, shared by all palettes.
+///   Keys are built by PaletteCellIconEngine from the cell
+///   content and everything else that affects the result,
+///   so an entry never has to be invalidated explicitly.
+///   Entries are kept in memory and written to disk in the
+///   background, so the icons survive a restart.
+//---------------------------------------------------------
+
+class PaletteIconCache
+{
+    INJECT_STATIC(palette, mu::palette::IPaletteConfiguration, configuration)
+
+    QCache<QByteArray, QPixmap> _pixmaps;
+    QThreadPool _diskPool;
+    QString _dirPath;
+
+    PaletteIconCache();
+
+    QString filePath(const QByteArray& key) const;
+
+public:
+    ~PaletteIconCache();
+
+    static PaletteIconCache* instance();
+
+    QPixmap pixmap(const QByteArray& key);
+    void insert(const QByteArray& key, const QPixmap& pixmap);
+};
+} // namespace Ms
+
+#endif
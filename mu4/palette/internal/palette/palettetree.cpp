@@ -19,6 +19,9 @@
 
 #include "palette.h"
 #include "palettetree.h"
+#include "paletteiconcache.h"
+
+#include <QCryptographicHash>
 
 #include "libmscore/articulation.h"
 #include "libmscore/fret.h"
@@ -32,6 +35,7 @@
 #include "thirdparty/qzip/qzipreader_p.h"
 #include "thirdparty/qzip/qzipwriter_p.h"
 
+#include "config.h"
 #include "modularity/ioc.h"
 #include "ui/imainwindow.h"
 
@@ -1193,16 +1197,85 @@ void PaletteCellIconEngine::paintCell(QPainter& p, const QRect& r, bool selected
     paintScoreElement(p, el, spatium, drawStaff);
 }
 
+//---------------------------------------------------------
+//   PaletteCellIconEngine::contentKey
+///   Hash of everything in the cell that is drawn. Cells are
+///   edited in place, but every edit is followed by
+///   dataChanged() and so by a new icon engine, which lets
+///   the hash be computed only once per engine.
+//---------------------------------------------------------
+
+QByteArray PaletteCellIconEngine::contentKey() const
+{
+    if (!_contentKey.isEmpty() || !_cell) {
+        return _contentKey;
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(_cell->mimeData());
+    if (_cell->untranslatedElement && _cell->element && _cell->element->isTextBase()) {
+        hash.addData(toTextBase(_cell->element.get())->xmlText().toUtf8());
+    }
+    _contentKey = hash.result();
+    return _contentKey;
+}
+
+//---------------------------------------------------------
+//   PaletteCellIconEngine::iconKey
+//---------------------------------------------------------
+
+QByteArray PaletteCellIconEngine::iconKey(const QSize& size, qreal dpr, bool selected, bool current) const
+{
+    QByteArray data;
+    QDataStream s(&data, QIODevice::WriteOnly);
+    s << QString(VERSION) << QString(MSC_VERSION) << contentKey()
+      << size << dpr << _extraMag << selected << current;
+
+    // theme and voice colors
+    const QPalette& pal = QApplication::palette(qMainWindow());
+    s << pal.color(QPalette::Normal, QPalette::Text) << pal.color(QPalette::Normal, QPalette::HighlightedText);
+    for (int voice = 0; voice < VOICES; ++voice) {
+        s << MScore::selectColor[voice];
+    }
+    s << MScore::defaultColor;
+
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
 //---------------------------------------------------------
 //   PaletteCellIconEngine::paint
+///   Cell icons are rendered once per cell, size, device
+///   pixel ratio and theme and then taken from the
+///   PaletteIconCache.
 //---------------------------------------------------------
 
 void PaletteCellIconEngine::paint(QPainter* painter, const QRect& r, QIcon::Mode mode, QIcon::State state)
 {
-    QPainter& p = *painter;
-    p.save();   // so we can restore it later
-    p.setRenderHint(QPainter::Antialiasing, true);
-    paintCell(p, r, mode == QIcon::Selected, state == QIcon::On);
-    p.restore();   // return painter to saved initial state (undo any changes to pen, coordinates, font, etc.)
+    if (r.isEmpty()) {
+        return;
+    }
+
+    const bool selected = mode == QIcon::Selected;
+    const bool current = state == QIcon::On;
+    const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : qApp->devicePixelRatio();
+
+    PaletteIconCache* cache = PaletteIconCache::instance();
+    const QByteArray key = iconKey(r.size(), dpr, selected, current);
+
+    QPixmap pm = cache->pixmap(key);
+    if (pm.isNull()) {
+        pm = QPixmap(r.size() * dpr);
+        pm.setDevicePixelRatio(dpr);
+        pm.fill(Qt::transparent);
+
+        QPainter p(&pm);
+        p.setRenderHint(QPainter::Antialiasing, true);
+        paintCell(p, QRect(QPoint(0, 0), r.size()), selected, current);
+        p.end();
+
+        cache->insert(key, pm);
+    }
+
+    painter->drawPixmap(r.topLeft(), pm);
 }
 } // namespace Ms
@@ -81,11 +81,14 @@ class PaletteCellIconEngine : public QIconEngine
 {
     PaletteCellConstPtr _cell;
     qreal _extraMag = 1.0;
+    mutable QByteArray _contentKey;
 
     PaletteCellConstPtr cell() const { return _cell; }
 
 private:
     void paintCell(QPainter& p, const QRect& r, bool selected, bool current) const;
+    QByteArray contentKey() const;
+    QByteArray iconKey(const QSize& size, qreal dpr, bool selected, bool current) const;
 
 public:
     PaletteCellIconEngine(PaletteCellConstPtr cell, qreal extraMag = 1.0)
@@ -79,3 +79,8 @@ QColor PaletteConfiguration::foregroundColor() const
     }
     return notationConfiguration()->defaultForegroundColor();
 }
+
+mu::io::path PaletteConfiguration::iconCachePath() const
+{
+    return globalConfiguration()->dataPath().toQString() + "/palette_icons";
+}
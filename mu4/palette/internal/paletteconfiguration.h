@@ -22,6 +22,7 @@
 #include "../ipaletteconfiguration.h"
 
 #include "modularity/ioc.h"
+#include "iglobalconfiguration.h"
 #include "ui/iuiconfiguration.h"
 #include "notation/inotationconfiguration.h"
 
@@ -29,6 +30,7 @@ namespace mu {
 namespace palette {
 class PaletteConfiguration : public IPaletteConfiguration
 {
+    INJECT(palette, framework::IGlobalConfiguration, globalConfiguration)
     INJECT(palette, framework::IUiConfiguration, uiConfiguration)
     INJECT(palette, notation::INotationConfiguration, notationConfiguration)
 
@@ -41,6 +43,8 @@ public:
     bool isSinglePalette() const override;
 
     QColor foregroundColor() const override;
+
+    io::path iconCachePath() const override;
 };
 }
 }
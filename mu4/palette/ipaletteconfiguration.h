@@ -24,6 +24,7 @@
 #include "modularity/imoduleexport.h"
 
 #include "retval.h"
+#include "io/path.h"
 
 namespace mu {
 namespace palette {
@@ -37,6 +38,8 @@ public:
     virtual bool isSinglePalette() const = 0;
 
     virtual QColor foregroundColor() const = 0;
+
+    virtual io::path iconCachePath() const = 0;
 };
 }
 }
@@ -0,0 +1,47 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_USERSCORES_ISCOREMETAINDEX_H
+#define MU_USERSCORES_ISCOREMETAINDEX_H
+
+#include "modularity/imoduleexport.h"
+#include "notation/notationtypes.h"
+#include "io/path.h"
+#include "async/channel.h"
+#include "retval.h"
+
+namespace mu {
+namespace userscores {
+class IScoreMetaIndex : MODULE_EXPORT_INTERFACE
+{
+    INTERFACE_ID(IScoreMetaIndex)
+
+public:
+    virtual ~IScoreMetaIndex() = default;
+
+    //! Returns the indexed meta of the file. If the file is not indexed yet
+    //! or has changed since, it is queued for reading and the returned ret
+    //! is not valid; metaChanged() sends the path once the meta is ready.
+    virtual RetVal<notation::Meta> meta(const io::path& filePath) = 0;
+    virtual async::Channel<io::path> metaChanged() const = 0;
+};
+}
+}
+
+#endif // MU_USERSCORES_ISCOREMETAINDEX_H
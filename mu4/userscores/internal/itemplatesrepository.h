@@ -25,6 +25,7 @@
 #include "notation/notationtypes.h"
 
 #include "retval.h"
+#include "async/channel.h"
 
 namespace mu {
 namespace userscores {
@@ -37,6 +38,10 @@ public:
 
     virtual RetVal<TemplateCategoryList> categories() const = 0;
     virtual RetVal<notation::MetaList> templatesMeta(const QString& categoryCode) const = 0;
+
+    //! Templates which are not indexed yet are left out of templatesMeta(),
+    //! the code of their category is sent here once they have been read
+    virtual async::Channel<QString> templatesMetaChanged() const = 0;
 };
 }
 }
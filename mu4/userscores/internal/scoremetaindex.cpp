@@ -0,0 +1,246 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "scoremetaindex.h"
+
+#include <QtConcurrent>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "log.h"
+#include "notation/notationerrors.h"
+
+using namespace mu;
+using namespace mu::userscores;
+using namespace mu::notation;
+
+namespace {
+const QString CACHE_DIR("/scoremeta");
+const QString INDEX_FILE("/index.dat");
+
+constexpr quint32 INDEX_MAGIC = 0x4d534d49;     // "MSMI"
+constexpr quint32 INDEX_VERSION = 1;
+
+const QSize THUMBNAIL_SIZE(256, 256);
+constexpr int SAVE_DELAY_MS = 1000;
+}
+
+void ScoreMetaIndex::init()
+{
+    m_cacheDirPath = globalConfiguration()->dataPath().toQString() + CACHE_DIR;
+    QDir().mkpath(m_cacheDirPath);
+
+    // resolve on the main thread, the workers only use it
+    msczReader();
+
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+
+    m_saveTimer.setSingleShot(true);
+    m_saveTimer.setInterval(SAVE_DELAY_MS);
+    QObject::connect(&m_saveTimer, &QTimer::timeout, [this]() {
+        saveIndex();
+    });
+
+    m_readFinished.onReceive(this, [this](const ReadResult& result) {
+        onRead(result);
+    });
+
+    loadIndex();
+}
+
+void ScoreMetaIndex::deinit()
+{
+    m_threadPool.clear();
+    m_threadPool.waitForDone();
+
+    if (m_saveTimer.isActive()) {
+        m_saveTimer.stop();
+        saveIndex();
+    }
+}
+
+RetVal<Meta> ScoreMetaIndex::meta(const io::path& filePath)
+{
+    QString path = filePath.toQString();
+    QFileInfo fileInfo(path);
+    if (!fileInfo.exists()) {
+        return RetVal<Meta>(make_ret(Err::FileNotFound));
+    }
+
+    qint64 size = fileInfo.size();
+    qint64 lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+
+    auto it = m_entries.find(path);
+    if (it != m_entries.end() && it->size == size && it->lastModified == lastModified) {
+        if (it->hasThumbnail && it->meta.thumbnail.isNull()) {
+            // thumbnails are only loaded when asked for
+            it->hasThumbnail = it->meta.thumbnail.load(thumbnailPath(path), "PNG");
+        }
+
+        RetVal<Meta> result;
+        result.ret = it->ret;
+        result.val = it->meta;
+        return result;
+    }
+
+    if (!m_pending.contains(path)) {
+        m_pending.insert(path);
+        QtConcurrent::run(&m_threadPool, this, &ScoreMetaIndex::th_read, path, size, lastModified, m_readFinished);
+    }
+
+    return RetVal<Meta>();
+}
+
+async::Channel<io::path> ScoreMetaIndex::metaChanged() const
+{
+    return m_metaChanged;
+}
+
+void ScoreMetaIndex::th_read(const QString& filePath, qint64 size, qint64 lastModified,
+                             async::Channel<ReadResult> finishChannel) const
+{
+    ReadResult result;
+    result.filePath = filePath;
+    result.size = size;
+    result.lastModified = lastModified;
+    result.meta = msczReader()->readMeta(io::path(filePath));
+
+    if (result.meta.ret && !result.meta.val.thumbnail.isNull()) {
+        QImage thumbnail = result.meta.val.thumbnail;
+        if (thumbnail.width() > THUMBNAIL_SIZE.width() || thumbnail.height() > THUMBNAIL_SIZE.height()) {
+            thumbnail = thumbnail.scaled(THUMBNAIL_SIZE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+
+        QSaveFile file(thumbnailPath(filePath));
+        result.hasThumbnail = file.open(QIODevice::WriteOnly) && thumbnail.save(&file, "PNG") && file.commit();
+        if (!result.hasThumbnail) {
+            LOGW() << "Failed to cache thumbnail of" << filePath;
+        }
+    }
+
+    // the thumbnail is loaded again from the cache when asked for
+    result.meta.val.thumbnail = QImage();
+
+    finishChannel.send(result);
+}
+
+void ScoreMetaIndex::onRead(const ReadResult& result)
+{
+    m_pending.remove(result.filePath);
+
+    Entry entry;
+    entry.size = result.size;
+    entry.lastModified = result.lastModified;
+    entry.ret = result.meta.ret;
+    entry.meta = result.meta.val;
+    entry.hasThumbnail = result.hasThumbnail;
+
+    if (!entry.ret) {
+        LOGW() << "Score reader error" << result.filePath << entry.ret.toString();
+    }
+
+    m_entries.insert(result.filePath, entry);
+
+    if (entry.ret) {
+        m_saveTimer.start();
+    }
+
+    m_metaChanged.send(io::path(result.filePath));
+}
+
+QString ScoreMetaIndex::thumbnailPath(const QString& filePath) const
+{
+    QByteArray hash = QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_cacheDirPath + "/" + QString::fromLatin1(hash) + ".png";
+}
+
+QString ScoreMetaIndex::indexPath() const
+{
+    return m_cacheDirPath + INDEX_FILE;
+}
+
+void ScoreMetaIndex::loadIndex()
+{
+    QFile file(indexPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream stream(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != INDEX_MAGIC || version != INDEX_VERSION) {
+        LOGW() << "Ignoring score meta index of unknown version";
+        return;
+    }
+
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        quint64 partsCount = 0;
+        stream >> path >> entry.size >> entry.lastModified
+        >> entry.meta.fileName >> entry.meta.title >> entry.meta.subtitle
+        >> entry.meta.composer >> entry.meta.lyricist >> entry.meta.copyright
+        >> entry.meta.translator >> entry.meta.arranger >> partsCount
+        >> entry.meta.creationDate >> entry.hasThumbnail;
+        entry.meta.partsCount = partsCount;
+        entry.ret = make_ret(Ret::Code::Ok);
+
+        if (stream.status() == QDataStream::Ok) {
+            m_entries.insert(path, entry);
+        }
+    }
+}
+
+void ScoreMetaIndex::saveIndex() const
+{
+    QSaveFile file(indexPath());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "Failed to save score meta index:" << file.errorString();
+        return;
+    }
+
+    QList<QString> paths;
+    for (auto it = m_entries.cbegin(); it != m_entries.cend(); ++it) {
+        if (it->ret) {
+            paths << it.key();
+        }
+    }
+
+    QDataStream stream(&file);
+    stream << INDEX_MAGIC << INDEX_VERSION << qint32(paths.size());
+    for (const QString& path : paths) {
+        const Entry& entry = m_entries[path];
+        stream << path << entry.size << entry.lastModified
+               << entry.meta.fileName << entry.meta.title << entry.meta.subtitle
+               << entry.meta.composer << entry.meta.lyricist << entry.meta.copyright
+               << entry.meta.translator << entry.meta.arranger << quint64(entry.meta.partsCount)
+               << entry.meta.creationDate << entry.hasThumbnail;
+    }
+
+    if (!file.commit()) {
+        LOGE() << "Failed to save score meta index:" << file.errorString();
+    }
+}
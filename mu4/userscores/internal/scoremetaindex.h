@@ -0,0 +1,87 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#ifndef MU_USERSCORES_SCOREMETAINDEX_H
+#define MU_USERSCORES_SCOREMETAINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QImage>
+#include <QThreadPool>
+#include <QTimer>
+
+#include "modularity/ioc.h"
+#include "async/asyncable.h"
+#include "iscoremetaindex.h"
+#include "iglobalconfiguration.h"
+#include "notation/imsczmetareader.h"
+
+namespace mu {
+namespace userscores {
+class ScoreMetaIndex : public IScoreMetaIndex, public async::Asyncable
+{
+    INJECT(userscores, notation::IMsczMetaReader, msczReader)
+    INJECT(userscores, framework::IGlobalConfiguration, globalConfiguration)
+
+public:
+    void init();
+    void deinit();
+
+    RetVal<notation::Meta> meta(const io::path& filePath) override;
+    async::Channel<io::path> metaChanged() const override;
+
+private:
+    struct Entry {
+        qint64 size = -1;
+        qint64 lastModified = 0;
+        Ret ret;
+        notation::Meta meta;
+        bool hasThumbnail = false;
+    };
+
+    struct ReadResult {
+        QString filePath;
+        qint64 size = -1;
+        qint64 lastModified = 0;
+        RetVal<notation::Meta> meta;
+        bool hasThumbnail = false;
+    };
+
+    void th_read(const QString& filePath, qint64 size, qint64 lastModified, async::Channel<ReadResult> finishChannel) const;
+    void onRead(const ReadResult& result);
+
+    QString thumbnailPath(const QString& filePath) const;
+    QString indexPath() const;
+    void loadIndex();
+    void saveIndex() const;
+
+    QString m_cacheDirPath;
+    QHash<QString, Entry> m_entries;
+    QSet<QString> m_pending;
+
+    QThreadPool m_threadPool;
+    QTimer m_saveTimer;
+
+    async::Channel<ReadResult> m_readFinished;
+    async::Channel<io::path> m_metaChanged;
+};
+}
+}
+
+#endif // MU_USERSCORES_SCOREMETAINDEX_H
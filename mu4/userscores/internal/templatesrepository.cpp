@@ -26,6 +26,21 @@ using namespace mu::notation;
 using namespace mu::userscores;
 using namespace mu::framework;
 
+void TemplatesRepository::init()
+{
+    metaIndex()->metaChanged().onReceive(this, [this](const io::path& path) {
+        QString filePath = path.toQString();
+
+        for (const io::path& dirPath : configuration()->templatesDirPaths()) {
+            QString categoryCode = dirPath.toQString();
+            if (filePath.startsWith(categoryCode + "/")) {
+                m_templatesMetaChanged.send(categoryCode);
+                break;
+            }
+        }
+    });
+}
+
 RetVal<TemplateCategoryList> TemplatesRepository::categories() const
 {
     TemplateCategoryList result;
@@ -52,7 +67,11 @@ RetVal<MetaList> TemplatesRepository::templatesMeta(const QString& categoryCode)
     io::paths templates = templatesPaths(categoryCode);
 
     for (const io::path& path : templates) {
-        RetVal<Meta> meta = msczReader()->readMeta(path);
+        RetVal<Meta> meta = metaIndex()->meta(path);
+
+        if (!meta.ret.valid()) {
+            continue;
+        }
 
         if (!meta.ret) {
             LOGE() << meta.ret.toString();
@@ -65,6 +84,11 @@ RetVal<MetaList> TemplatesRepository::templatesMeta(const QString& categoryCode)
     return RetVal<MetaList>::make_ok(result);
 }
 
+async::Channel<QString> TemplatesRepository::templatesMetaChanged() const
+{
+    return m_templatesMetaChanged;
+}
+
 bool TemplatesRepository::isEmpty(const io::path& dirPath) const
 {
     return templatesPaths(dirPath).empty();
@@ -21,28 +21,34 @@
 #define MU_USERSCORES_TEMPLATESREPOSITORY_H
 
 #include "modularity/ioc.h"
+#include "async/asyncable.h"
 
 #include "itemplatesrepository.h"
 #include "userscores/iuserscoresconfiguration.h"
-#include "notation/imsczmetareader.h"
+#include "iscoremetaindex.h"
 #include "system/ifilesystem.h"
 
 namespace mu {
 namespace userscores {
-class TemplatesRepository : public ITemplatesRepository
+class TemplatesRepository : public ITemplatesRepository, public async::Asyncable
 {
     INJECT(userscores, IUserScoresConfiguration, configuration)
-    INJECT(userscores, notation::IMsczMetaReader, msczReader)
+    INJECT(userscores, IScoreMetaIndex, metaIndex)
     INJECT(userscores, framework::IFileSystem, fileSystem)
 
 public:
+    void init();
+
     RetVal<TemplateCategoryList> categories() const override;
     RetVal<notation::MetaList> templatesMeta(const QString& categoryCode) const override;
+    async::Channel<QString> templatesMetaChanged() const override;
 
 private:
     bool isEmpty(const io::path& dirPath) const;
     QString correctedTitle(const QString& title) const;
     io::paths templatesPaths(const io::path& dirPath) const;
+
+    async::Channel<QString> m_templatesMetaChanged;
 };
 }
 }
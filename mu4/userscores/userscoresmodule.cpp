@@ -27,6 +27,7 @@
 #include "internal/openscorecontroller.h"
 #include "internal/userscoresconfiguration.h"
 #include "internal/templatesrepository.h"
+#include "internal/scoremetaindex.h"
 #include "ui/iinteractiveuriregister.h"
 
 using namespace mu::userscores;
@@ -34,6 +35,8 @@ using namespace mu::framework;
 
 static OpenScoreController* m_openController = new OpenScoreController();
 static UserScoresConfiguration* m_userScoresConfiguration = new UserScoresConfiguration();
+static ScoreMetaIndex* m_scoreMetaIndex = new ScoreMetaIndex();
+static TemplatesRepository* m_templatesRepository = new TemplatesRepository();
 
 static void userscores_init_qrc()
 {
@@ -49,7 +52,8 @@ void UserScoresModule::registerExports()
 {
     ioc()->registerExport<IOpenScoreController>(moduleName(), m_openController);
     ioc()->registerExport<IUserScoresConfiguration>(moduleName(), m_userScoresConfiguration);
-    ioc()->registerExport<ITemplatesRepository>(moduleName(), new TemplatesRepository());
+    ioc()->registerExport<IScoreMetaIndex>(moduleName(), m_scoreMetaIndex);
+    ioc()->registerExport<ITemplatesRepository>(moduleName(), m_templatesRepository);
 }
 
 void UserScoresModule::resolveImports()
@@ -77,4 +81,11 @@ void UserScoresModule::onInit()
 {
     m_userScoresConfiguration->init();
     m_openController->init();
+    m_scoreMetaIndex->init();
+    m_templatesRepository->init();
+}
+
+void UserScoresModule::onDeinit()
+{
+    m_scoreMetaIndex->deinit();
 }
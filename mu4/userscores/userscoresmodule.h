@@ -32,6 +32,7 @@ public:
     void registerResources() override;
     void registerUiTypes() override;
     void onInit() override;
+    void onDeinit() override;
 };
 }
 }
@@ -18,6 +18,8 @@
 //=============================================================================
 #include "recentscoresmodel.h"
 
+#include <QFileInfo>
+
 #include "log.h"
 #include "translation.h"
 #include "actions/actiontypes.h"
@@ -47,6 +49,10 @@ RecentScoresModel::RecentScoresModel(QObject* parent)
     recentScoresCh.ch.onReceive(this, [this](const QStringList& list) {
         updateRecentScores(list);
     });
+
+    metaIndex()->metaChanged().onReceive(this, [this](const io::path& path) {
+        updateRecentScore(path.toQString());
+    });
 }
 
 QVariant RecentScoresModel::data(const QModelIndex& index, int role) const
@@ -106,22 +112,22 @@ void RecentScoresModel::updateRecentScores(const QStringList& recentScoresPathLi
     QVariantList recentScores;
 
     for (const QString& path : recentScoresPathList) {
-        RetVal<Meta> meta = msczMetaReader()->readMeta(path);
+        RetVal<Meta> meta = metaIndex()->meta(path);
+
+        if (!meta.ret.valid()) {
+            // still being read, updated in updateRecentScore()
+            Meta placeholder;
+            placeholder.title = QFileInfo(path).completeBaseName();
+            recentScores << makeScoreItem(path, placeholder);
+            continue;
+        }
 
         if (!meta.ret) {
             LOGW() << "Score reader error" << path;
             continue;
         }
 
-        QVariantMap obj;
-
-        obj[SCORE_TITLE_KEY] = meta.val.title;
-        obj[SCORE_PATH_KEY] = path;
-        obj[SCORE_THUMBNAIL_KEY] = meta.val.thumbnail;
-        obj[SCORE_TIME_SINCE_CREATION_KEY] = DataFormatter::formatTimeSinceCreation(meta.val.creationDate);
-        obj[SCORE_ADD_NEW_KEY] = false;
-
-        recentScores << obj;
+        recentScores << makeScoreItem(path, meta.val);
     }
 
     QVariantMap obj;
@@ -132,3 +138,56 @@ void RecentScoresModel::updateRecentScores(const QStringList& recentScoresPathLi
 
     setRecentScores(recentScores);
 }
+
+void RecentScoresModel::updateRecentScore(const QString& path)
+{
+    int row = scoreIndex(path);
+    if (row < 0) {
+        return;
+    }
+
+    RetVal<Meta> meta = metaIndex()->meta(path);
+    if (!meta.ret.valid()) {
+        return;
+    }
+
+    if (!meta.ret) {
+        LOGW() << "Score reader error" << path;
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_recentScores.removeAt(row);
+        endRemoveRows();
+        return;
+    }
+
+    m_recentScores[row] = makeScoreItem(path, meta.val);
+
+    QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex);
+}
+
+QVariantMap RecentScoresModel::makeScoreItem(const QString& path, const Meta& meta) const
+{
+    QVariantMap obj;
+
+    obj[SCORE_TITLE_KEY] = meta.title;
+    obj[SCORE_PATH_KEY] = path;
+    obj[SCORE_THUMBNAIL_KEY] = meta.thumbnail;
+    obj[SCORE_TIME_SINCE_CREATION_KEY] = meta.creationDate.isValid()
+                                         ? DataFormatter::formatTimeSinceCreation(meta.creationDate) : QString();
+    obj[SCORE_ADD_NEW_KEY] = false;
+
+    return obj;
+}
+
+int RecentScoresModel::scoreIndex(const QString& path) const
+{
+    for (int i = 0; i < m_recentScores.size(); ++i) {
+        QVariantMap score = m_recentScores[i].toMap();
+        if (!score[SCORE_ADD_NEW_KEY].toBool() && score[SCORE_PATH_KEY].toString() == path) {
+            return i;
+        }
+    }
+
+    return -1;
+}
@@ -25,7 +25,7 @@
 #include "async/asyncable.h"
 #include "actions/iactionsdispatcher.h"
 #include "iuserscoresconfiguration.h"
-#include "notation/imsczmetareader.h"
+#include "internal/iscoremetaindex.h"
 
 namespace mu {
 namespace userscores {
@@ -35,7 +35,7 @@ class RecentScoresModel : public QAbstractListModel, public async::Asyncable
 
     INJECT(scores, actions::IActionsDispatcher, dispatcher)
     INJECT(scores, IUserScoresConfiguration, configuration)
-    INJECT(scores, notation::IMsczMetaReader, msczMetaReader)
+    INJECT(scores, IScoreMetaIndex, metaIndex)
 
 public:
     RecentScoresModel(QObject* parent = nullptr);
@@ -56,6 +56,10 @@ private:
 
     void updateRecentScores(const QStringList& recentScoresPathList);
     void setRecentScores(const QVariantList& recentScores);
+    void updateRecentScore(const QString& path);
+
+    QVariantMap makeScoreItem(const QString& path, const notation::Meta& meta) const;
+    int scoreIndex(const QString& path) const;
 
     QVariantList m_recentScores;
     QHash<int, QByteArray> m_roles;
@@ -1,5 +1,6 @@
 #include "scorethumbnail.h"
 
+#include <QImage>
 #include <QVariant>
 
 using namespace mu::userscores;
@@ -9,13 +10,14 @@ ScoreThumbnail::ScoreThumbnail(QQuickItem* parent)
 {
 }
 
-void ScoreThumbnail::setThumbnail(QVariant pixmap)
+void ScoreThumbnail::setThumbnail(QVariant thumbnail)
 {
-    if (pixmap.isNull()) {
+    if (thumbnail.isNull()) {
         return;
     }
 
-    m_thumbnail = pixmap.value<QPixmap>();
+    //! NOTE Meta holds a QImage, it is converted here on the main thread
+    m_thumbnail = QPixmap::fromImage(thumbnail.value<QImage>());
     update();
 }
 
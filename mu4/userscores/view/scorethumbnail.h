@@ -31,7 +31,7 @@ class ScoreThumbnail : public QQuickPaintedItem
 public:
     ScoreThumbnail(QQuickItem* parent = nullptr);
 
-    Q_INVOKABLE void setThumbnail(QVariant pixmap);
+    Q_INVOKABLE void setThumbnail(QVariant thumbnail);
 
 protected:
     virtual void paint(QPainter* painter) override;
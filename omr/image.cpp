@@ -0,0 +1,67 @@
+//=============================================================================
+//  MusE Reader
+//  Music Score Reader
+//
+//  Copyright (C) 2010 Werner Schweer
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "image.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   BitImage
+//    a pixel is black if qGray() of its color is below
+//    threshold
+//---------------------------------------------------------
+
+BitImage::BitImage(const QImage& image, int threshold)
+{
+    _width  = image.width();
+    _height = image.height();
+    _wpl    = (_width + 63) / 64;
+    _bits.assign(size_t(_wpl) * _height, 0);
+
+    if (image.format() == QImage::Format_MonoLSB || image.format() == QImage::Format_Mono) {
+        // classify the two palette entries once, then copy bits
+        bool black[2];
+        for (int i = 0; i < 2; ++i) {
+            QRgb c = i < image.colorCount() ? image.color(i) : (i ? qRgb(255, 255, 255) : qRgb(0, 0, 0));
+            black[i] = qGray(c) < threshold;
+        }
+        const bool lsb = image.format() == QImage::Format_MonoLSB;
+        for (int y = 0; y < _height; ++y) {
+            const uchar* src = image.constScanLine(y);
+            quint64* dst     = _bits.data() + y * _wpl;
+            for (int x = 0; x < _width; ++x) {
+                int idx = lsb ? (src[x >> 3] >> (x & 7)) & 1 : (src[x >> 3] >> (7 - (x & 7))) & 1;
+                if (black[idx]) {
+                    dst[x >> 6] |= quint64(1) << (x & 63);
+                }
+            }
+        }
+        return;
+    }
+    QImage img = image.convertToFormat(QImage::Format_RGB32);
+    for (int y = 0; y < _height; ++y) {
+        const QRgb* src = reinterpret_cast<const QRgb*>(img.constScanLine(y));
+        quint64* dst    = _bits.data() + y * _wpl;
+        for (int x = 0; x < _width; ++x) {
+            if (qGray(src[x]) < threshold) {
+                dst[x >> 6] |= quint64(1) << (x & 63);
+            }
+        }
+    }
+}
+}
@@ -30,6 +30,47 @@ class Image : public QImage
 public:
 };
 
+//---------------------------------------------------------
+//   BitImage
+//    image packed to one bit per pixel, bit set for black
+//    pixels; lines are padded with white to 64 bit words
+//---------------------------------------------------------
+
+class BitImage
+{
+    int _width  { 0 };
+    int _height { 0 };
+    int _wpl    { 0 };                // 64 bit words per line
+    std::vector<quint64> _bits;
+
+public:
+    BitImage() {}
+    BitImage(const QImage&, int threshold);
+
+    bool isNull() const { return _bits.empty(); }
+    int width() const { return _width; }
+    int height() const { return _height; }
+    const quint64* scanLine(int y) const { return _bits.data() + y * _wpl; }
+    bool black(int x, int y) const { return (scanLine(y)[x >> 6] >> (x & 63)) & 1; }
+
+    //---------------------------------------------------
+    //   bits
+    //    return n (<= 64) pixels of line y starting at x,
+    //    pixel x in bit 0
+    //---------------------------------------------------
+
+    quint64 bits(int x, int y, int n) const
+    {
+        const quint64* p = scanLine(y) + (x >> 6);
+        int shift = x & 63;
+        quint64 v = p[0] >> shift;
+        if (shift && ((x >> 6) + 1) < _wpl) {
+            v |= p[1] << (64 - shift);
+        }
+        return n < 64 ? v & ((quint64(1) << n) - 1) : v;
+    }
+};
+
 extern double imageSkew(const QImage& image);
 }
 
@@ -139,6 +139,12 @@ int Omr::pagesInDocument() const
 //---------------------------------------------------------
 //   readPdf
 //    return true on success
+//
+//    Pages are independent until the score is assembled,
+//    so they are processed in parallel on the global thread
+//    pool. Page images are decoded by the worker processing
+//    the page, which keeps at most one full resolution page
+//    image per worker thread in memory.
 //---------------------------------------------------------
 
 bool Omr::readPdf()
@@ -147,7 +153,8 @@ bool Omr::readPdf()
                                                         "Cancel"), 0, 100, 0, Qt::FramelessWindowHint);
     progress->setWindowModality(Qt::ApplicationModal);
     progress->show();
-    progress->setRange(0, ACTION_NUM);
+    progress->setLabelText(ActionNames.at(READ_PDF));
+    qApp->processEvents();
 
 #ifdef OCR
     if (_ocr == 0) {
@@ -155,117 +162,117 @@ bool Omr::readPdf()
     }
     _ocr->init();
 #endif
-    int ID = READ_PDF;
-    int page = 0;
-    bool val;
-    while (ID < ACTION_NUM) {
-        if (ID != INIT_PAGE && ID != SYSTEM_IDENTIFICATION) {
-            page = 0;
-            progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID + 1)).arg(1));
-            val = omrActions(ID, page);
-        } else {
-            progress->setLabelText(QWidget::tr("%1 at Page %2").arg(ActionNames.at(ID)).arg(page + 1));
-            val = omrActions(ID, page);
-            page++;
-        }
-
-        if (!val || progress->wasCanceled()) {
-            progress->close();
-            return false;
-        } else {
-            if (ID < ACTION_NUM) {
-                progress->setValue(ID);
-            } else {
-                progress->setValue(ACTION_NUM - 1);
-            }
-            qApp->processEvents();
+    _doc = new Pdf();
+    if (!_doc->open(_path)) {
+        delete _doc;
+        _doc = 0;
+        progress->close();
+        delete progress;
+        return false;
+    }
+    int n = _doc->numPages();
+    QVector<int> pageIdx;
+    for (int i = 0; i < n; ++i) {
+        _pages.append(new OmrPage(this));
+        pageIdx.append(i);
+    }
+    _spatium = 15.0;     //constant spatium, image will be rescaled according to this parameter
+    initPatterns();
+
+    //
+    // per page stages, in parallel
+    //
+    _failedPages = 0;
+    progress->setLabelText(ActionNames.at(SYSTEM_IDENTIFICATION));
+    progress->setRange(0, n);
+    QFuture<void> future = QtConcurrent::map(pageIdx, [this](int page) {
+        if (!process1(page)) {
+            _failedPages.ref();
         }
+    });
+    QFutureWatcher<void> watcher;
+    QEventLoop loop;
+    QObject::connect(&watcher, &QFutureWatcher<void>::progressValueChanged, progress, &QProgressDialog::setValue);
+    QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop, &QEventLoop::quit);
+    QObject::connect(progress, &QProgressDialog::canceled, &watcher, &QFutureWatcher<void>::cancel);
+    watcher.setFuture(future);
+    if (!future.isFinished()) {
+        loop.exec();
     }
+    future.waitForFinished();
+
+    bool ok = !future.isCanceled() && !progress->wasCanceled() && _failedPages.load() == 0;
     progress->close();
     delete progress;
+    if (!ok || n == 0) {
+        return false;
+    }
+
+    //
+    // merge, in page order
+    //
+    double w = 0;
+    for (int i = 0; i < n; ++i) {
+        w  += _pages[i]->width();
+    }
+    w       /= n;
+    _dpmm    = w / 210.0;                // PaperSize A4
     return true;
 }
 
 //---------------------------------------------------------
-//   actions
+//   process1
+//    run all per page stages: decode and load the page,
+//    rescale it to the common spatium and identify systems
+//    return false if the page could not be decoded
 //---------------------------------------------------------
 
-bool Omr::omrActions(int& ID, int page)
+bool Omr::process1(int page)
 {
-    if (ID == READ_PDF) {
-        _doc = new Pdf();
-        if (!_doc->open(_path)) {
-            delete _doc;
-            _doc = 0;
-            return false;
-        }
-        int n = _doc->numPages();
-//printf("readPdf: %d pages\n", n);
-        for (int i = 0; i < n; ++i) {
-            OmrPage* page1 = new OmrPage(this);
-            QImage image = _doc->page(i);
-            if (image.isNull()) {
-                return false;
-            }
-            page1->setImage(image);
-            _pages.append(page1);
-        }
-
-        _spatium = 15.0;     //constant spatium, image will be rescaled according to this parameter
-        ID++;
-        return true;
-    } else if (ID == INIT_PAGE) {
-        //load one page and rescale
-        _pages[page]->read();
-
-        //do the rescaling here
-        int new_w = _pages[page]->image().width() * _spatium / _pages[page]->spatium();
-        int new_h = _pages[page]->image().height() * _spatium / _pages[page]->spatium();
-        QImage image = _pages[page]->image().scaled(new_w,new_h, Qt::KeepAspectRatio);
-        _pages[page]->setImage(image);
-        _pages[page]->read();
-
-        if (page == _pages.size() - 1) {
-            ID++;
-        }
-        return true;
-    } else if (ID == FINALIZE_PARMS) {
-        int n = _pages.size();
-        double w = 0;
-        for (int i = 0; i < n; ++i) {
-            w  += _pages[i]->width();
-        }
-        w       /= n;
-        _dpmm    = w / 210.0;                // PaperSize A4
-
-        quartheadPattern  = new Pattern(_score, "solid_note_head");
-        halfheadPattern   = new Pattern(_score, SymId::noteheadHalf,  _spatium);
-        sharpPattern      = new Pattern(_score, SymId::accidentalSharp, _spatium);
-        flatPattern       = new Pattern(_score, SymId::accidentalFlat, _spatium);
-        naturalPattern    = new Pattern(_score, SymId::accidentalNatural,_spatium);
-        trebleclefPattern = new Pattern(_score, SymId::gClef,_spatium);
-        bassclefPattern   = new Pattern(_score, SymId::fClef,_spatium);
-        timesigPattern[0] = new Pattern(_score, SymId::timeSig0, _spatium);
-        timesigPattern[1] = new Pattern(_score, SymId::timeSig1, _spatium);
-        timesigPattern[2] = new Pattern(_score, SymId::timeSig2, _spatium);
-        timesigPattern[3] = new Pattern(_score, SymId::timeSig3, _spatium);
-        timesigPattern[4] = new Pattern(_score, SymId::timeSig4, _spatium);
-        timesigPattern[5] = new Pattern(_score, SymId::timeSig5, _spatium);
-        timesigPattern[6] = new Pattern(_score, SymId::timeSig6, _spatium);
-        timesigPattern[7] = new Pattern(_score, SymId::timeSig7, _spatium);
-        timesigPattern[8] = new Pattern(_score, SymId::timeSig8, _spatium);
-        timesigPattern[9] = new Pattern(_score, SymId::timeSig9, _spatium);
-
-        ID++;
-        return true;
-    } else if (ID == SYSTEM_IDENTIFICATION) {
-        _pages[page]->identifySystems();
-        if (page == _pages.size() - 1) {
-            ID++;
-        }
-        return true;
+    OmrPage* omrPage = _pages[page];
+    QImage image = _doc->page(page);
+    if (image.isNull()) {
+        return false;
     }
-    return false;
+    omrPage->setImage(image);
+    image = QImage();
+
+    //load one page and rescale
+    omrPage->read();
+    int new_w = omrPage->image().width() * _spatium / omrPage->spatium();
+    int new_h = omrPage->image().height() * _spatium / omrPage->spatium();
+    omrPage->setImage(omrPage->image().scaled(new_w, new_h, Qt::KeepAspectRatio));
+    omrPage->read();
+
+    omrPage->identifySystems();
+    return true;
+}
+
+//---------------------------------------------------------
+//   initPatterns
+//    the patterns only depend on _spatium; they are shared
+//    read only by all pages
+//---------------------------------------------------------
+
+void Omr::initPatterns()
+{
+    quartheadPattern  = new Pattern(_score, "solid_note_head");
+    halfheadPattern   = new Pattern(_score, SymId::noteheadHalf,  _spatium);
+    sharpPattern      = new Pattern(_score, SymId::accidentalSharp, _spatium);
+    flatPattern       = new Pattern(_score, SymId::accidentalFlat, _spatium);
+    naturalPattern    = new Pattern(_score, SymId::accidentalNatural,_spatium);
+    trebleclefPattern = new Pattern(_score, SymId::gClef,_spatium);
+    bassclefPattern   = new Pattern(_score, SymId::fClef,_spatium);
+    timesigPattern[0] = new Pattern(_score, SymId::timeSig0, _spatium);
+    timesigPattern[1] = new Pattern(_score, SymId::timeSig1, _spatium);
+    timesigPattern[2] = new Pattern(_score, SymId::timeSig2, _spatium);
+    timesigPattern[3] = new Pattern(_score, SymId::timeSig3, _spatium);
+    timesigPattern[4] = new Pattern(_score, SymId::timeSig4, _spatium);
+    timesigPattern[5] = new Pattern(_score, SymId::timeSig5, _spatium);
+    timesigPattern[6] = new Pattern(_score, SymId::timeSig6, _spatium);
+    timesigPattern[7] = new Pattern(_score, SymId::timeSig7, _spatium);
+    timesigPattern[8] = new Pattern(_score, SymId::timeSig8, _spatium);
+    timesigPattern[9] = new Pattern(_score, SymId::timeSig9, _spatium);
 }
 
 //---------------------------------------------------------
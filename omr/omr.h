@@ -49,9 +49,12 @@ class Omr
     Ocr* _ocr;
     Score* _score;
 
+    QAtomicInt _failedPages;
+
     static void initUtils();
 
-    void process1(int page);
+    bool process1(int page);
+    void initPatterns();
 
     enum ActionID {
         READ_PDF, INIT_PAGE, FINALIZE_PARMS, SYSTEM_IDENTIFICATION, ACTION_NUM
@@ -125,8 +128,6 @@ public:
         return _path;
     }
 
-    bool omrActions(int& ID, int page = 0);
-
     static Pattern* quartheadPattern;
     static Pattern* halfheadPattern;
     static Pattern* sharpPattern;
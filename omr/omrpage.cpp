@@ -115,6 +115,37 @@ void OmrPage::read()
     slice();
     getStaffLines();
     getRatio();
+    _bitImage = BitImage();
+    _patternWeights.clear();
+}
+
+//---------------------------------------------------------
+//   bitImage
+//    page image packed for pattern matching, pixels with
+//    gray value below 125 are black
+//---------------------------------------------------------
+
+const BitImage& OmrPage::bitImage()
+{
+    if (_bitImage.isNull() && !_image.isNull()) {
+        _bitImage = BitImage(_image, 125);
+    }
+    return _bitImage;
+}
+
+//---------------------------------------------------------
+//   patternWeights
+//    match weights of pattern for the background ratio
+//    of this page, computed on first use
+//---------------------------------------------------------
+
+const PatternWeights& OmrPage::patternWeights(const Pattern* pattern)
+{
+    auto i = _patternWeights.find(pattern);
+    if (i == _patternWeights.end()) {
+        i = _patternWeights.emplace(pattern, pattern->weights(_ratio)).first;
+    }
+    return i->second;
 }
 
 struct SysState {
@@ -523,14 +554,13 @@ OmrPattern OmrPage::searchPattern(const std::vector<Pattern*>& pl, int y, int x1
         double val = 0.0;
         int xx = 0;
         int hw = pattern->w();
+        int bx = pattern->base().x();
+        int by = pattern->base().y();
 
-        for (int x = x1; x < (x2 - hw); ++x) {
-            double val1 = pattern->match(&image(), x - pattern->base().x(), y - pattern->base().y());
-            if (val1 > val) {
-                val = val1;
-                xx = x;
-            }
+        if (!pattern->bestMatch(bitImage(), x1 - bx, x2 - hw - bx, y - by, patternWeights(pattern), 0.0, &xx, &val)) {
+            continue;
         }
+        xx += bx;
 
         if (val > p.prob) {
             p.setRect(xx, y, pattern->w(), pattern->h());
@@ -1717,8 +1747,11 @@ void OmrSystem::searchNotes(QList<OmrNote*>* noteList, int x1, int x2, int y, in
     int step_size = 2;
     int note_thresh = 50;
 
+    const BitImage& image     = _page->bitImage();
+    const PatternWeights& pw  = _page->patternWeights(pattern);
+
     for (int x = x1; x < (x2 - hw); x += step_size) {
-        val = pattern->match(&_page->image(), x, y - hh / 2, _page->ratio());
+        val = pattern->match(image, x, y - hh / 2, pw);
         if (val > note_thresh) {
             notePeaks.append(Peak(x, val, 0));
         }
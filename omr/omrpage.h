@@ -26,6 +26,8 @@
 #include "libmscore/clef.h"
 #include "libmscore/xml.h"
 #include "libmscore/sym.h"
+#include "image.h"
+#include "pattern.h"
 
 namespace Ms {
 class Omr;
@@ -205,6 +207,8 @@ class OmrPage
 {
     Omr* _omr;
     QImage _image;
+    BitImage _bitImage;             // _image packed for pattern matching, built on demand
+    std::map<const Pattern*, PatternWeights> _patternWeights;
     double _spatium;
     double _ratio;
 
@@ -235,7 +239,7 @@ class OmrPage
 
 public:
     OmrPage(Omr* _parent);
-    void setImage(const QImage& i) { _image = i; }
+    void setImage(const QImage& i) { _image = i; _bitImage = BitImage(); }
     const QImage& image() const { return _image; }
     QImage& image() { return _image; }
     void read();
@@ -251,6 +255,8 @@ public:
     const QList<QRect>& slices() const { return _slices; }
     double spatium() const { return _spatium; }
     double ratio() const { return _ratio; }
+    const BitImage& bitImage();
+    const PatternWeights& patternWeights(const Pattern*);
     double staffDistance() const;
     double systemDistance() const;
     void readHeader(Score* score);
@@ -18,10 +18,13 @@
 //=============================================================================
 
 #include "pattern.h"
+#include "image.h"
 #include "utils.h"
 #include "libmscore/sym.h"
 #include "omr.h"
 #include <math.h>
+#include <algorithm>
+#include <limits>
 
 namespace Ms {
 //---------------------------------------------------------
@@ -144,6 +147,170 @@ double Pattern::match(const QImage* img, int col, int row, double bg_parm) const
 #endif
 }
 
+//---------------------------------------------------------
+//   weights
+//    precompute the per pixel log-likelihood scores used
+//    by match() for background ratio bg_parm
+//---------------------------------------------------------
+
+PatternWeights Pattern::weights(double bg_parm) const
+{
+    PatternWeights w;
+    w.bgParm = bg_parm;
+    if (bg_parm < 0.00001) {
+        bg_parm = 0.00001;
+    }
+    if (bg_parm > 0.99999) {
+        bg_parm = 0.99999;
+    }
+    double log_bg_black = log(bg_parm);
+    double log_bg_white = log(1.0 - bg_parm);
+
+    w.white.resize(rows * cols);
+    w.delta.resize(rows * cols);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < cols; x++) {
+            double bs_scr = model[y][x];
+            if (bs_scr < 0.00001) {
+                bs_scr = 0.00001;
+            }
+            if (bs_scr > 0.99999) {
+                bs_scr = 0.99999;
+            }
+            double log_black = log(bs_scr) - log_bg_black;
+            double log_white = log(1.0 - bs_scr) - log_bg_white;
+            w.white[y * cols + x] = log_white;
+            w.delta[y * cols + x] = log_black - log_white;
+            w.whiteSum += log_white;
+        }
+    }
+
+    // moving the window one column right changes the weight of
+    // every pixel from delta[x + 1] to delta[x], with delta zero
+    // outside the pattern; only black pixels count
+    for (int y = 0; y < rows; ++y) {
+        const double* d = w.delta.data() + y * cols;
+        for (int x = -1; x < cols; ++x) {
+            double diff = (x >= 0 ? d[x] : 0.0) - (x + 1 < cols ? d[x + 1] : 0.0);
+            if (diff > 0.0) {
+                w.stepRight += diff;
+            } else {
+                w.stepLeft -= diff;
+            }
+        }
+    }
+    return w;
+}
+
+//---------------------------------------------------------
+//   match
+//    same score as match(const QImage*, int, int, double),
+//    computed on a packed image: start with the score of an
+//    all white window and add the black-white difference for
+//    the black pixels only, 64 pixels at a time.
+//    Pixels outside of the image do not contribute.
+//---------------------------------------------------------
+
+double Pattern::match(const BitImage& img, int col, int row, const PatternWeights& w) const
+{
+    if (col >= 0 && row >= 0 && col + cols <= img.width() && row + rows <= img.height()) {
+        double k = w.whiteSum;
+        for (int y = 0; y < rows; ++y) {
+            const double* d = w.delta.data() + y * cols;
+            for (int x = 0; x < cols; x += 64) {
+                quint64 v = img.bits(col + x, row + y, qMin(64, cols - x));
+                while (v) {
+                    k += d[x + qCountTrailingZeroBits(v)];
+                    v &= v - 1;
+                }
+            }
+        }
+        return k;
+    }
+
+    // window clipped at the image border
+    double k = 0.0;
+    for (int y = 0; y < rows; ++y) {
+        if (row + y < 0 || row + y >= img.height()) {
+            continue;
+        }
+        for (int x = 0; x < cols; x++) {
+            if (col + x < 0 || col + x >= img.width()) {
+                continue;
+            }
+            int i = y * cols + x;
+            k += img.black(col + x, row + y) ? w.white[i] + w.delta[i] : w.white[i];
+        }
+    }
+    return k;
+}
+
+//---------------------------------------------------------
+//   bestMatch
+//    search the columns x1 <= col < x2 of row for the best
+//    match scoring above minVal, the leftmost one of equal
+//    scores, with the result of matching every column.
+//    Every other column is matched first. A column in between
+//    is matched only if the scores of its neighbours and the
+//    step bounds of the weights allow it to reach the best
+//    score found so far.
+//    Returns false if no match scored above minVal.
+//---------------------------------------------------------
+
+bool Pattern::bestMatch(const BitImage& img, int x1, int x2, int row, const PatternWeights& w, double minVal, int* col,
+                        double* val) const
+{
+    double best = minVal;
+    int bestX   = x2;
+    auto consider = [&](int x, double v) {
+                        if (v > best || (v == best && bestX != x2 && x < bestX)) {
+                            best  = v;
+                            bestX = x;
+                        }
+                    };
+
+    std::vector<double> coarse;
+    for (int x = x1; x < x2; x += 2) {
+        double v = match(img, x, row, w);
+        coarse.push_back(v);
+        consider(x, v);
+    }
+
+    // the bounds hold if the column and both neighbours are
+    // not clipped at the image border, other columns are
+    // always matched
+    const bool rowInside = row >= 0 && row + rows <= img.height();
+    std::vector<std::pair<double, int> > fine;          // <bound, column>
+    for (int i = 0; x1 + 2 * i + 1 < x2; ++i) {
+        const int x = x1 + 2 * i + 1;
+        double bound = std::numeric_limits<double>::infinity();
+        if (rowInside && x - 1 >= 0 && x + 1 + cols <= img.width()) {
+            bound = coarse[i] + w.stepRight;
+            if (i + 1 < int(coarse.size())) {
+                bound = qMin(bound, coarse[i + 1] + w.stepLeft);
+            }
+            bound += 1e-9 * (1.0 + qAbs(bound));        // rounding of the summed scores
+        }
+        fine.push_back({ bound, x });
+    }
+    std::sort(fine.begin(), fine.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+        return a.first > b.first || (a.first == b.first && a.second < b.second);
+    });
+    for (const auto& f : fine) {
+        if (f.first < best) {
+            break;
+        }
+        consider(f.second, match(img, f.second, row, w));
+    }
+
+    if (bestX == x2) {
+        return false;
+    }
+    *col = bestX;
+    *val = best;
+    return true;
+}
+
 //---------------------------------------------------------
 //   Pattern
 //    create a Pattern from symbol
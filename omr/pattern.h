@@ -25,6 +25,22 @@
 namespace Ms {
 enum class SymId;
 class Sym;
+class BitImage;
+
+//---------------------------------------------------------
+//   PatternWeights
+//    log-likelihood weights of a model pattern for one
+//    background ratio, see Pattern::weights()
+//---------------------------------------------------------
+
+struct PatternWeights {
+    double bgParm   { -1.0 };
+    double whiteSum { 0.0 };          // score of an all white window
+    std::vector<double> white;        // rows * cols, score of a white pixel
+    std::vector<double> delta;        // rows * cols, black minus white score
+    double stepRight { 0.0 };         // bound of the score gain when an unclipped window moves one column right
+    double stepLeft  { 0.0 };         // the same for one column left
+};
 
 //---------------------------------------------------------
 //   Pattern
@@ -52,6 +68,9 @@ public:
     double match(const Pattern*) const;
     double match(const QImage*, int, int) const;
     double match(const QImage* img, int col, int row, double bg_parm) const;
+    double match(const BitImage& img, int col, int row, const PatternWeights& w) const;
+    bool bestMatch(const BitImage& img, int x1, int x2, int row, const PatternWeights& w, double minVal, int* col, double* val) const;
+    PatternWeights weights(double bg_parm) const;
 
     void dump() const;
     const QImage* image() const { return &_image; }
@@ -136,16 +136,19 @@ QImage Pdf::page(int i)
         return image;
     }
 
-    Poppler::Page* pdfPage = _document->page(i);    // Document starts at page 0
-    if (pdfPage == 0) {
-        return image;
-    }
+    {
+        QMutexLocker locker(&_mutex);
+        Poppler::Page* pdfPage = _document->page(i);    // Document starts at page 0
+        if (pdfPage == 0) {
+            return image;
+        }
 
-    QSize size = pdfPage->pageSize();
-    float scale = 2.0;
-    // the size can be decided more intelligently
-    image = pdfPage->renderToImage(scale * 72.0, scale * 72.0, 0, 0, scale * size.width(), scale * size.height());
-    delete pdfPage;
+        QSize size = pdfPage->pageSize();
+        float scale = 2.0;
+        // the size can be decided more intelligently
+        image = pdfPage->renderToImage(scale * 72.0, scale * 72.0, 0, 0, scale * size.width(), scale * size.height());
+        delete pdfPage;
+    }
     return binarization(image);
 }
 }
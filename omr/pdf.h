@@ -36,13 +36,14 @@ class Pdf
     PDFDoc* _doc;
     QImageOutputDev* imgOut;
     Poppler::Document* _document;
+    QMutex _mutex;                    // poppler documents must not render concurrently
 public:
     Pdf();
     bool open(const QString& path);
     ~Pdf();
 
     int numPages() const;
-    QImage page(int);
+    QImage page(int);                 // thread safe
     QImage binarization(QImage image);
 };
 }
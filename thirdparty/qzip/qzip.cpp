@@ -156,7 +156,7 @@ static int inflate(Bytef *dest, ulong *destLen, const Bytef *source, ulong sourc
     return err;
 }
 
-static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen)
+static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sourceLen, int level)
 {
     z_stream stream;
     int err;
@@ -171,7 +171,7 @@ static int deflate (Bytef *dest, ulong *destLen, const Bytef *source, ulong sour
     stream.zfree = (free_func)0;
     stream.opaque = (voidpf)0;
 
-    err = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+    err = deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
     if (err != Z_OK) return err;
 
     err = deflate(&stream, Z_FINISH);
@@ -520,17 +520,20 @@ public:
         : MQZipPrivate(device, ownDev),
         status(MQZipWriter::NoError),
         permissions(QFile::ReadOwner | QFile::WriteOwner),
-        compressionPolicy(MQZipWriter::AlwaysCompress)
+        compressionPolicy(MQZipWriter::AlwaysCompress),
+        compressionLevel(Z_DEFAULT_COMPRESSION)
     {
     }
 
     MQZipWriter::Status status;
     QFile::Permissions permissions;
     MQZipWriter::CompressionPolicy compressionPolicy;
+    int compressionLevel;
 
     enum EntryType { Directory, File, Symlink };
 
     void addEntry(EntryType type, const QString &fileName, const QByteArray &contents);
+    void addEntry(EntryType type, const QString &fileName, const MQZipWriter::CompressedData &contents);
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -639,13 +642,18 @@ void MQZipReaderPrivate::scanFiles()
 }
 
 void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const QByteArray &contents/*, QFile::Permissions permissions, QZip::Method m*/)
+{
+    addEntry(type, fileName, MQZipWriter::compress(contents, compressionPolicy, compressionLevel));
+}
+
+void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const MQZipWriter::CompressedData &contents)
 {
 #ifndef NDEBUG
     static const char *const entryTypes[] = {
         "directory",
         "file     ",
         "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+    ZDEBUG() << "adding" << entryTypes[type] <<":" << fileName.toUtf8().data() << (type == 2 ? QByteArray(" -> " + contents.data).constData() : "");
 #endif
 
     if (! (device->isOpen() || device->open(QIODevice::WriteOnly))) {
@@ -654,53 +662,18 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString &fileName, const
     }
     device->seek(start_of_directory);
 
-    // don't compress small files
-    MQZipWriter::CompressionPolicy compression = compressionPolicy;
-    if (compressionPolicy == MQZipWriter::AutoCompress) {
-        if (contents.length() < 64)
-            compression = MQZipWriter::NeverCompress;
-        else
-            compression = MQZipWriter::AlwaysCompress;
-    }
-
     FileHeader header;
     memset(&header.h, 0, sizeof(CentralFileHeader));
     writeUInt(header.h.signature, 0x02014b50);
 
     writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.length());
+    writeUInt(header.h.uncompressed_size, contents.uncompressedSize);
     writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
-    if (compression == MQZipWriter::AlwaysCompress) {
+    const QByteArray &data = contents.data;
+    if (contents.deflated)
         writeUShort(header.h.compression_method, CompressionMethodDeflated);
-
-       ulong len = contents.length();
-        // shamelessly copied form zlib
-        len += (len >> 12) + (len >> 14) + 11;
-        int res;
-        do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
-
-            switch (res) {
-            case Z_OK:
-                data.resize(len);
-                break;
-            case Z_MEM_ERROR:
-                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
-                break;
-            case Z_BUF_ERROR:
-                len *= 2;
-                break;
-            }
-        } while (res == Z_BUF_ERROR);
-    }
-// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
     writeUInt(header.h.compressed_size, data.length());
-    uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
+    writeUInt(header.h.crc_32, contents.crc);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -1205,6 +1178,73 @@ MQZipWriter::Status MQZipWriter::status() const
     \value AutoCompress     A file that is added will be compressed only if that will give a smaller file.
 */
 
+/*!
+    Compresses \a contents the way addFile() would with the given
+    \a policy and zlib compression \a level.
+
+    This does not touch any writer, so it can be used to compress
+    several files in parallel before adding them in order with
+    addCompressedFile().
+*/
+MQZipWriter::CompressedData MQZipWriter::compress(const QByteArray &contents, CompressionPolicy policy, int level)
+{
+    // don't compress small files
+    CompressionPolicy compression = policy;
+    if (policy == AutoCompress) {
+        if (contents.length() < 64)
+            compression = NeverCompress;
+        else
+            compression = AlwaysCompress;
+    }
+
+    CompressedData result;
+    result.uncompressedSize = contents.length();
+    result.data = contents;
+    if (compression == AlwaysCompress) {
+        result.deflated = true;
+
+       ulong len = contents.length();
+        // shamelessly copied form zlib
+        len += (len >> 12) + (len >> 14) + 11;
+        int res;
+        do {
+            result.data.resize(len);
+            res = deflate((uchar*)result.data.data(), &len, (const uchar*)contents.constData(), contents.length(), level);
+
+            switch (res) {
+            case Z_OK:
+                result.data.resize(len);
+                break;
+            case Z_MEM_ERROR:
+                qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
+                result.data.resize(0);
+                break;
+            case Z_BUF_ERROR:
+                len *= 2;
+                break;
+            }
+        } while (res == Z_BUF_ERROR);
+    }
+// TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
+    uint crc_32 = ::crc32(0, 0, 0);
+    result.crc = ::crc32(crc_32, (const uchar *)contents.constData(), contents.length());
+    return result;
+}
+
+/*!
+    Sets the zlib compression \a level (0-9, or -1 for the zlib
+    default) used for newly added files.
+*/
+void MQZipWriter::setCompressionLevel(int level)
+{
+    d->compressionLevel = level;
+}
+
+int MQZipWriter::compressionLevel() const
+{
+    return d->compressionLevel;
+}
+
 /*!
      Sets the policy for compressing newly added files to the new \a policy.
 
@@ -1269,6 +1309,15 @@ void MQZipWriter::addFile(const QString &fileName, const QByteArray &data)
     d->addEntry(MQZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), data);
 }
 
+/*!
+    Add a file which has been compressed already by compress()
+    to the archive.
+*/
+void MQZipWriter::addCompressedFile(const QString &fileName, const CompressedData &data)
+{
+    d->addEntry(MQZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), data);
+}
+
 /*!
     Add a file to the archive with \a device as the source of the contents.
     The contents returned from QIODevice::readAll() will be used as the
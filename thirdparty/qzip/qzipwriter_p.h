@@ -94,6 +94,19 @@ public:
     void setCompressionPolicy(CompressionPolicy policy);
     CompressionPolicy compressionPolicy() const;
 
+    void setCompressionLevel(int level);
+    int compressionLevel() const;
+
+    struct CompressedData
+    {
+        QByteArray data;
+        uint crc = 0;
+        int uncompressedSize = 0;
+        bool deflated = false;
+    };
+
+    static CompressedData compress(const QByteArray &contents, CompressionPolicy policy = AlwaysCompress, int level = -1);
+
     void setCreationPermissions(QFile::Permissions permissions);
     QFile::Permissions creationPermissions() const;
 
@@ -101,6 +114,8 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    void addCompressedFile(const QString &fileName, const CompressedData &data);
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);